@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = algorithmselection-benchmark
+
+SOURCES += \
+        main.cpp
@@ -0,0 +1,141 @@
+/**
+ * Replays a corpus of recorded plans against the auto algorithm selection.
+ *
+ * Every plan in the corpus is scheduled with legacy-fast and legacy-good. The
+ * benchmark reports, which algorithm auto would have selected before the plan
+ * was run, its predicted and the measured runtime, and if the selection was
+ * the best algorithm within the latency target. The measured jobs are added to
+ * the history afterwards, so later plans profit from earlier ones.
+ *
+ * The plans of a job journal (<storagePath>/plans) are a good corpus.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+
+#include "algorithmselector.h"
+#include "legacyscheduler.h"
+#include "planfeatures.h"
+#include "scheduleevaluator.h"
+
+struct Run {
+  bool success = false;
+  double runtime = 0.0;
+  ScheduleScore score;
+};
+
+Run schedule(const QJsonObject& jsonPlan, const QString& binary, LegacyScheduler::SchedulingMode mode, int timeout) {
+  Run run;
+  QSharedPointer<Plan> plan(new Plan());
+  plan->fromJsonObject(jsonPlan);
+  LegacyScheduler scheduler(plan, binary, false, mode);
+
+  QEventLoop loop;
+  QObject::connect(&scheduler, &Scheduler::finishedScheduling, &loop, [&run, &loop](QSharedPointer<Plan> scheduledPlan) {
+    run.success = true;
+    run.score = ScheduleEvaluator::evaluate(scheduledPlan.get());
+    loop.quit();
+  });
+  QObject::connect(&scheduler, &Scheduler::failedScheduling, &loop, &QEventLoop::quit);
+  QTimer::singleShot(timeout * 1000, &loop, &QEventLoop::quit);
+
+  QElapsedTimer timer;
+  timer.start();
+  if(scheduler.startScheduling()) {
+    loop.exec();
+  }
+  run.runtime = timer.elapsed() / 1000.0;
+  return run;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Replay benchmark for the auto scheduling algorithm");
+  parser.addHelpOption();
+  parser.addPositionalArgument("corpus", "Directory with plans as .json files");
+  QCommandLineOption binaryOption("binary", "The SPA-algorithmus binary", "binary", "./SPA-algorithmus");
+  parser.addOption(binaryOption);
+  QCommandLineOption historyOption("history", "Start with this history file. It is not modified.", "history");
+  parser.addOption(historyOption);
+  QCommandLineOption latencyTargetOption("latency-target", "The latency target in seconds", "latency-target", "60");
+  parser.addOption(latencyTargetOption);
+  QCommandLineOption timeoutOption("timeout", "Abort a single run after this many seconds", "timeout", "600");
+  parser.addOption(timeoutOption);
+  parser.process(application);
+
+  if(parser.positionalArguments().size() != 1) {
+    parser.showHelp(1);
+  }
+
+  QString binary = parser.value(binaryOption);
+  double latencyTarget = parser.value(latencyTargetOption).toDouble();
+  int timeout = parser.value(timeoutOption).toInt();
+
+  // Work on a copy of the history, so the benchmark does not change it
+  AlgorithmSelector selector;
+  if(parser.isSet(historyOption)) {
+    selector.importHistory(parser.value(historyOption));
+  }
+
+  QDir corpus(parser.positionalArguments().first());
+  QStringList planFiles = corpus.entryList(QStringList() << "*.json", QDir::Files, QDir::Name);
+
+  QTextStream out(stdout);
+  out << "plan;modules;groups;density;selected;predicted;fastRuntime;fastPenalty;goodRuntime;goodPenalty;best;hit\n";
+  int hits = 0;
+  int evaluated = 0;
+  for(const QString& planFile : planFiles) {
+    QFile file(corpus.filePath(planFile));
+    if(!file.open(QFile::ReadOnly)) {
+      continue;
+    }
+    QJsonObject jsonPlan = QJsonDocument::fromJson(file.readAll()).object();
+    Plan plan;
+    plan.fromJsonObject(jsonPlan);
+    PlanFeatures features = PlanFeatures::extract(&plan);
+
+    QString selected = selector.select(features, latencyTarget);
+    double predicted = selector.predict(features, selected).runtime;
+
+    Run fast = schedule(jsonPlan, binary, LegacyScheduler::Fast, timeout);
+    Run good = schedule(jsonPlan, binary, LegacyScheduler::Good, timeout);
+
+    // The best algorithm is the better result, that finished within the latency target
+    QString best = "none";
+    bool goodInTarget = good.success && good.runtime <= latencyTarget;
+    bool fastInTarget = fast.success && fast.runtime <= latencyTarget;
+    if(goodInTarget && (!fastInTarget || !(fast.score < good.score))) {
+      best = "legacy-good";
+    } else if(fastInTarget) {
+      best = "legacy-fast";
+    }
+    bool hit = best == "none" || best == selected;
+    if(best != "none") {
+      evaluated++;
+      hits += hit ? 1 : 0;
+    }
+
+    out << planFile << ";" << features.moduleCount << ";" << features.groupCount << ";" << features.conflictDensity << ";"
+        << selected << ";" << predicted << ";" << fast.runtime << ";" << fast.score.softPenalty << ";" << good.runtime << ";"
+        << good.score.softPenalty << ";" << best << ";" << (hit ? "yes" : "no") << "\n";
+    out.flush();
+
+    if(fast.success) {
+      selector.record(features, "legacy-fast", fast.runtime, fast.score);
+    }
+    if(good.success) {
+      selector.record(features, "legacy-good", good.runtime, good.score);
+    }
+  }
+
+  out << "Selected the best algorithm for " << hits << " of " << evaluated << " plans\n";
+  return 0;
+}
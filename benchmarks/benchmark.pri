@@ -0,0 +1,13 @@
+# Common settings for the benchmarks. Every benchmark is a separate application in its own directory.
+QT -= gui
+QT += websockets
+
+CONFIG += c++2a console
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+include($$PWD/../src/src.pri)
+
+# The benchmarks can use the SPA-algorithmus stub as ./SPA-algorithmus-stub
+include($$PWD/../tools/SPA-algorithmus-stub/stub.pri)
@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = loadgenerator-benchmark
+
+SOURCES += \
+        main.cpp
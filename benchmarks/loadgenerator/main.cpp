@@ -0,0 +1,478 @@
+/**
+ * Load generator for the JSON-RPC interface of the server.
+ *
+ * Starts the server binary with the SPA-algorithmus stub, or uses a running
+ * server with --url, and opens --sessions websocket sessions at once. Every
+ * session replays the calls of a planner: it connects, calls
+ * startScheduling, polls getProgress every --poll-interval milliseconds until
+ * the job is finished and fetches it with getResult. Then it closes the
+ * connection and starts the next job on a new connection, until --duration
+ * seconds passed.
+ *
+ * Before the sessions start, one connection checks, that the server answers
+ * setSchedulingAlgorithm and getProgress without an error, so a broken setup
+ * fails at once instead of producing thousands of failed calls.
+ *
+ * Every connection has to be opened and every call has to be answered within
+ * --request-timeout milliseconds, or it fails and its session starts over. Connections closed by the server are
+ * counted, but are no failure.
+ *
+ * The valid plan of the test data is scheduled by default. Every job gets the
+ * plan with another name, so the jobs are not shared by the JobCoalescer,
+ * unless --shared-plan is set. The stub writes a schedule with a row for every
+ * active module of the plan, because an empty schedule is rejected for a plan
+ * with active modules. Set SPA_STUB_SCRIPT to change the timing of the stub, by
+ * default every job takes about 200 ms.
+ *
+ * The benchmark reports the finished jobs per second and the number of calls,
+ * calls per second, the p50, p99, p99.9 and maximum latency, the error replies
+ * and the timed out calls of every method. The latency of getProgress shows,
+ * how long the event loop of the server is blocked.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QTcpServer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <QWebSocket>
+#include <algorithm>
+#include <functional>
+#include <testdatahelper.h>
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <string>
+
+#include "plan.h"
+
+struct MethodStatistics {
+  QVector<qint64> latencies;
+  int errors = 0;
+  int timeouts = 0;
+};
+
+struct Session {
+  QWebSocket* socket = nullptr;
+  // Fails the current call, if it is not answered in time. Owned by the socket.
+  QTimer* requestTimer = nullptr;
+  int callId = 0;
+  QString method;
+  QElapsedTimer callTimer;
+  QElapsedTimer connectTimer;
+  // Counts the connections of the session, so timers of an earlier connection are ignored
+  int generation = 0;
+  std::function<void(const QJsonObject&)> onResponse;
+};
+
+// Generates the public key of a RSA key pair in .pem format, like the one of the auth server
+std::string generatePublicKey() {
+  EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+  EVP_PKEY* key = nullptr;
+  bool generated = context != nullptr && EVP_PKEY_keygen_init(context) > 0 && EVP_PKEY_CTX_set_rsa_keygen_bits(context, 2048) > 0 &&
+                   EVP_PKEY_keygen(context, &key) > 0;
+  EVP_PKEY_CTX_free(context);
+  if(!generated) {
+    EVP_PKEY_free(key);
+    return std::string();
+  }
+  BIO* bio = BIO_new(BIO_s_mem());
+  int written = PEM_write_bio_PUBKEY(bio, key);
+  char* data = nullptr;
+  long length = BIO_get_mem_data(bio, &data);
+  std::string publicKey = written > 0 && length > 0 ? std::string(data, length) : std::string();
+  BIO_free(bio);
+  EVP_PKEY_free(key);
+  return publicKey;
+}
+
+quint16 findFreePort() {
+  QTcpServer server;
+  server.listen(QHostAddress::LocalHost);
+  return server.serverPort();
+}
+
+double percentile(const QVector<qint64>& sortedLatencies, double rank) {
+  if(sortedLatencies.isEmpty()) {
+    return 0.0;
+  }
+  int index = std::min<int>(sortedLatencies.size() - 1, rank * sortedLatencies.size());
+  return sortedLatencies[index] / 1000000.0;
+}
+
+// Waits until the server accepts connections. Returns false, if it did not within timeout milliseconds.
+bool waitForServer(const QUrl& url, int timeout) {
+  QWebSocket socket;
+  QEventLoop loop;
+  bool connected = false;
+  QTimer retryTimer;
+  retryTimer.setSingleShot(true);
+  QObject::connect(&socket, &QWebSocket::connected, &loop, [&connected, &loop]() {
+    connected = true;
+    loop.quit();
+  });
+  QObject::connect(&socket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error), &retryTimer, [&retryTimer]() {
+    retryTimer.start(10);
+  });
+  QObject::connect(&retryTimer, &QTimer::timeout, &socket, [&socket, &url]() {
+    socket.open(url);
+  });
+  QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+  socket.open(url);
+  loop.exec();
+  socket.close();
+  return connected;
+}
+
+// Sets the algorithm and polls the progress once on one connection. Returns an empty string or the first failure.
+QString checkServer(const QUrl& url, const QString& algorithm, int timeout) {
+  QWebSocket socket;
+  QEventLoop loop;
+  QString failure = "The server did not answer within " + QString::number(timeout) + " ms";
+  QList<QJsonObject> requests{QJsonObject{{"jsonrpc", "2.0"}, {"method", "setSchedulingAlgorithm"}, {"params", QJsonArray{algorithm}}, {"id", 1}},
+                              QJsonObject{{"jsonrpc", "2.0"}, {"method", "getProgress"}, {"params", QJsonArray()}, {"id", 2}}};
+  int answered = 0;
+  QObject::connect(&socket, &QWebSocket::connected, &loop, [&socket, &requests]() {
+    socket.sendTextMessage(QJsonDocument(requests.first()).toJson(QJsonDocument::Compact));
+  });
+  QObject::connect(&socket, &QWebSocket::textMessageReceived, &loop, [&](const QString& message) {
+    QJsonObject response = QJsonDocument::fromJson(message.toUtf8()).object();
+    QString method = requests[answered]["method"].toString();
+    if(response.contains("error")) {
+      failure = method + " returned an error: " + QJsonDocument(response["error"].toObject()).toJson(QJsonDocument::Compact);
+      loop.quit();
+      return;
+    }
+    if(response["id"].toInt() != requests[answered]["id"].toInt() || !response.contains("result")) {
+      failure = method + " returned an invalid response: " + message;
+      loop.quit();
+      return;
+    }
+    if(method == "setSchedulingAlgorithm" && !response["result"].toBool()) {
+      failure = "The algorithm " + algorithm + " was rejected";
+      loop.quit();
+      return;
+    }
+    answered++;
+    if(answered == requests.size()) {
+      failure = "";
+      loop.quit();
+      return;
+    }
+    socket.sendTextMessage(QJsonDocument(requests[answered]).toJson(QJsonDocument::Compact));
+  });
+  QObject::connect(&socket, &QWebSocket::disconnected, &loop, [&failure, &loop]() {
+    failure = "The server closed the connection";
+    loop.quit();
+  });
+  QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+  socket.open(url);
+  loop.exec();
+  socket.disconnect();
+  socket.close();
+  return failure;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Load generator for concurrent JSON-RPC sessions against the server");
+  parser.addHelpOption();
+  QCommandLineOption serverOption("server", "The server binary", "server", "./pruefungsplaner-scheduler");
+  parser.addOption(serverOption);
+  QCommandLineOption binaryOption("binary", "The algorithm binary of the started server", "binary", "./SPA-algorithmus-stub");
+  parser.addOption(binaryOption);
+  QCommandLineOption urlOption("url", "Use the running server at this url instead of starting one", "url");
+  parser.addOption(urlOption);
+  QCommandLineOption planOption("plan", "Schedule this plan as .json file. Defaults to the valid plan of the test data.", "plan");
+  parser.addOption(planOption);
+  QCommandLineOption sessionsOption("sessions", "The number of sessions at once", "sessions", "100");
+  parser.addOption(sessionsOption);
+  QCommandLineOption durationOption("duration", "Start new jobs for this many seconds", "duration", "30");
+  parser.addOption(durationOption);
+  QCommandLineOption pollIntervalOption("poll-interval", "The milliseconds between two getProgress calls", "poll-interval", "100");
+  parser.addOption(pollIntervalOption);
+  QCommandLineOption algorithmOption("algorithm", "The scheduling algorithm", "algorithm", "legacy-fast");
+  parser.addOption(algorithmOption);
+  QCommandLineOption sharedPlanOption("shared-plan", "Submit the same plan in every job, so the jobs are shared");
+  parser.addOption(sharedPlanOption);
+  QCommandLineOption requestTimeoutOption(
+      "request-timeout", "A call fails, if it is not answered within this many milliseconds", "request-timeout", "10000");
+  parser.addOption(requestTimeoutOption);
+  parser.process(application);
+
+  int sessions = std::max(parser.value(sessionsOption).toInt(), 1);
+  qint64 duration = std::max(parser.value(durationOption).toInt(), 1) * qint64(1000);
+  int pollInterval = std::max(parser.value(pollIntervalOption).toInt(), 0);
+  QString algorithm = parser.value(algorithmOption);
+  bool sharedPlan = parser.isSet(sharedPlanOption);
+  int requestTimeout = std::max(parser.value(requestTimeoutOption).toInt(), 1);
+
+  QJsonObject jsonPlan = getValidJsonPlan();
+  if(parser.isSet(planOption)) {
+    QFile planFile(parser.value(planOption));
+    if(!planFile.open(QFile::ReadOnly)) {
+      qDebug() << "Failed to open" << planFile.fileName();
+      return 1;
+    }
+    jsonPlan = QJsonDocument::fromJson(planFile.readAll()).object();
+  }
+
+  // The stub takes about 200 ms per job and puts every active module in the first timeslot
+  QTemporaryDir directory;
+  QFile scheduleFile(directory.filePath("schedule.csv"));
+  if(!scheduleFile.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  Plan parsedPlan;
+  parsedPlan.fromJsonObject(jsonPlan);
+  for(Module* module : parsedPlan.getModules()) {
+    if(module->getActive()) {
+      scheduleFile.write("1;1;" + module->getNumber().toUtf8() + "\n");
+    }
+  }
+  scheduleFile.close();
+  QFile script(directory.filePath("script"));
+  if(!script.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  script.write("softbest 100\nsleep 100\nsoftbest 50\nsleep 100\nschedule " + scheduleFile.fileName().toUtf8() + "\nexit 0\n");
+  script.close();
+
+  QProcess server;
+  QUrl url(parser.value(urlOption));
+  if(!parser.isSet(urlOption)) {
+    // The server does not start without the public key of an auth server
+    std::string publicKey = generatePublicKey();
+    QFile publicKeyFile(directory.filePath("public_key.pem"));
+    if(publicKey.empty() || !publicKeyFile.open(QFile::WriteOnly)) {
+      qDebug() << "Failed to generate a key pair";
+      return 1;
+    }
+    publicKeyFile.write(QByteArray::fromStdString(publicKey));
+    publicKeyFile.close();
+
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    if(!environment.contains("SPA_STUB_SCRIPT")) {
+      environment.insert("SPA_STUB_SCRIPT", script.fileName());
+    }
+    quint16 port = findFreePort();
+    // Admission control would reject most of the sessions
+    QList<QString> arguments{"--address",
+                             "127.0.0.1",
+                             "--port",
+                             QString::number(port),
+                             "--storage",
+                             directory.path(),
+                             "--public-key",
+                             publicKeyFile.fileName(),
+                             "--no-retrieve",
+                             "--legacy-scheduler-binary",
+                             parser.value(binaryOption),
+                             "--max-running-jobs",
+                             "0",
+                             "--max-queued-jobs",
+                             "0"};
+    server.setProcessEnvironment(environment);
+    server.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    server.setStandardOutputFile(QProcess::nullDevice());
+    server.start(parser.value(serverOption), arguments);
+    url = QUrl("ws://127.0.0.1:" + QString::number(port));
+  }
+  if(!waitForServer(url, 30000)) {
+    qDebug() << "The server at" << url.toString() << "did not accept connections";
+    return 1;
+  }
+  QString failure = checkServer(url, algorithm, requestTimeout);
+  if(!failure.isEmpty()) {
+    qDebug() << "The smoke check of the server at" << url.toString() << "failed:" << failure;
+    if(server.state() != QProcess::NotRunning) {
+      server.kill();
+      server.waitForFinished();
+    }
+    return 1;
+  }
+
+  QMap<QString, MethodStatistics> statistics;
+  int startedJobs = 0;
+  int finishedJobs = 0;
+  int failedJobs = 0;
+  int rejectedJobs = 0;
+  int failedSessions = 0;
+  int closedSessions = 0;
+  int timedOutCalls = 0;
+  int activeSessions = 0;
+  QElapsedTimer timer;
+  QVector<Session> sessionStates(sessions);
+
+  std::function<void(int)> startSession;
+  auto call = [](Session& session, const QString& method, const QJsonArray& params, std::function<void(const QJsonObject&)> onResponse) {
+    session.callId++;
+    session.method = method;
+    session.onResponse = onResponse;
+    QJsonObject request{{"jsonrpc", "2.0"}, {"method", method}, {"params", params}, {"id", session.callId}};
+    session.callTimer.start();
+    session.requestTimer->start();
+    session.socket->sendTextMessage(QJsonDocument(request).toJson(QJsonDocument::Compact));
+  };
+  // Closes the connection and starts the next job after delay milliseconds, until the duration is over
+  auto endSession = [&](int index, int delay) {
+    Session& session = sessionStates[index];
+    if(session.socket == nullptr) {
+      return;
+    }
+    session.onResponse = nullptr;
+    session.requestTimer->stop();
+    session.socket->disconnect();
+    session.socket->close();
+    session.socket->deleteLater();
+    session.socket = nullptr;
+    if(timer.elapsed() < duration) {
+      QTimer::singleShot(delay, [&startSession, index]() {
+        startSession(index);
+      });
+    } else if(--activeSessions == 0) {
+      application.quit();
+    }
+  };
+
+  std::function<void(int)> pollProgress = [&](int index) {
+    call(sessionStates[index], "getProgress", QJsonArray(), [&, index](const QJsonObject& response) {
+      if(response["result"].toDouble() < 1.0) {
+        int generation = sessionStates[index].generation;
+        QTimer::singleShot(pollInterval, [&pollProgress, &sessionStates, index, generation]() {
+          if(sessionStates[index].socket != nullptr && sessionStates[index].generation == generation) {
+            pollProgress(index);
+          }
+        });
+        return;
+      }
+      call(sessionStates[index], "getResult", QJsonArray(), [&, index](const QJsonObject& response) {
+        // A failed job returns its error message
+        if(response["result"].isObject()) {
+          finishedJobs++;
+        } else {
+          failedJobs++;
+        }
+        endSession(index, 0);
+      });
+    });
+  };
+
+  startSession = [&](int index) {
+    Session& session = sessionStates[index];
+    session.socket = new QWebSocket();
+    session.requestTimer = new QTimer(session.socket);
+    session.requestTimer->setSingleShot(true);
+    session.requestTimer->setInterval(requestTimeout);
+    session.generation++;
+    session.connectTimer.start();
+    QObject::connect(session.requestTimer, &QTimer::timeout, [&, index]() {
+      statistics[sessionStates[index].method].timeouts++;
+      timedOutCalls++;
+      endSession(index, 100);
+    });
+    QObject::connect(session.socket, &QWebSocket::connected, [&, index]() {
+      statistics["connect"].latencies.append(sessionStates[index].connectTimer.nsecsElapsed());
+      QJsonObject plan = jsonPlan;
+      if(!sharedPlan) {
+        plan["name"] = "loadgenerator-" + QString::number(startedJobs);
+      }
+      startedJobs++;
+      call(sessionStates[index], "setSchedulingAlgorithm", QJsonArray{algorithm}, [&, index, plan](const QJsonObject&) {
+        call(sessionStates[index], "startScheduling", QJsonArray{plan}, [&, index](const QJsonObject& response) {
+          if(!response["result"].toBool()) {
+            // Rejected by admission control or the plan is invalid, try again later
+            rejectedJobs++;
+            endSession(index, 100);
+            return;
+          }
+          pollProgress(index);
+        });
+      });
+    });
+    QObject::connect(session.socket, &QWebSocket::textMessageReceived, [&, index](const QString& message) {
+      Session& session = sessionStates[index];
+      QJsonObject response = QJsonDocument::fromJson(message.toUtf8()).object();
+      if(response["id"].toInt() != session.callId || !session.onResponse) {
+        return;
+      }
+      session.requestTimer->stop();
+      MethodStatistics& methodStatistics = statistics[session.method];
+      methodStatistics.latencies.append(session.callTimer.nsecsElapsed());
+      if(response.contains("error")) {
+        methodStatistics.errors++;
+      }
+      std::function<void(const QJsonObject&)> onResponse = session.onResponse;
+      onResponse(response);
+    });
+    // A session fails, if the connection is refused or breaks. endSession disconnects the socket, so a failure is
+    // only counted once, even if the socket reports both an error and the disconnect.
+    auto socketError = QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error);
+    QObject::connect(session.socket, socketError, [&, index](QAbstractSocket::SocketError error) {
+      if(error == QAbstractSocket::RemoteHostClosedError) {
+        closedSessions++;
+      } else {
+        failedSessions++;
+      }
+      endSession(index, 100);
+    });
+    // The server closed the connection, this is no failure of the session
+    QObject::connect(session.socket, &QWebSocket::disconnected, [&, index]() {
+      closedSessions++;
+      endSession(index, 100);
+    });
+    session.method = "connect";
+    session.requestTimer->start();
+    session.socket->open(url);
+  };
+
+  QTimer::singleShot(0, [&]() {
+    timer.start();
+    for(int index = 0; index < sessions; index++) {
+      activeSessions++;
+      startSession(index);
+    }
+  });
+  // Sessions, that hang, do not keep the benchmark running
+  QTimer::singleShot(duration + 60000, &application, &QCoreApplication::quit);
+  application.exec();
+  double seconds = timer.elapsed() / 1000.0;
+
+  if(server.state() != QProcess::NotRunning) {
+    server.terminate();
+    if(!server.waitForFinished(5000)) {
+      server.kill();
+      server.waitForFinished();
+    }
+  }
+
+  QTextStream out(stdout);
+  out << "sessions: " << sessions << ", duration: " << seconds << " s, poll interval: " << pollInterval << " ms\n";
+  out << "jobs: started " << startedJobs << ", finished " << finishedJobs << " (" << finishedJobs / seconds << " jobs/s), failed "
+      << failedJobs << ", rejected " << rejectedJobs << ", failed sessions " << failedSessions << ", closed by the server "
+      << closedSessions << ", timed out calls " << timedOutCalls << "\n";
+  int errors = 0;
+  out << "method,calls,calls/s,p50 ms,p99 ms,p99.9 ms,max ms,errors,timeouts\n";
+  for(auto methodStatistics = statistics.begin(); methodStatistics != statistics.end(); methodStatistics++) {
+    QVector<qint64>& latencies = methodStatistics.value().latencies;
+    errors += methodStatistics.value().errors;
+    std::sort(latencies.begin(), latencies.end());
+    out << methodStatistics.key() << "," << latencies.size() << "," << latencies.size() / seconds << "," << percentile(latencies, 0.5)
+        << "," << percentile(latencies, 0.99) << "," << percentile(latencies, 0.999) << ","
+        << (latencies.isEmpty() ? 0.0 : latencies.last() / 1000000.0) << "," << methodStatistics.value().errors << ","
+        << methodStatistics.value().timeouts << "\n";
+  }
+  return failedJobs > 0 || failedSessions > 0 || timedOutCalls > 0 || errors > 0 || finishedJobs == 0 ? 1 : 0;
+}
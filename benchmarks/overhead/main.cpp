@@ -0,0 +1,148 @@
+/**
+ * Measures the overhead of the LegacyScheduler and the SchedulerService.
+ *
+ * The jobs run against the SPA-algorithmus stub from tools/SPA-algorithmus-stub
+ * with a script, that writes the schedule and exits immediately. So the
+ * measured latency is the time spent in our own code and in starting the
+ * process, not in the algorithm.
+ *
+ * Every layer runs the same number of sequential jobs. The difference between
+ * the layers is the overhead the layer adds to a job.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+#include "configuration.h"
+#include "legacyscheduler.h"
+#include "schedulerservice.h"
+
+void printLatencies(QTextStream& out, const QString& layer, QVector<qint64> latencies) {
+  if(latencies.isEmpty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  double sum = 0;
+  for(qint64 latency : latencies) {
+    sum += latency;
+  }
+  auto milliseconds = [](qint64 nanoseconds) {
+    return nanoseconds / 1000000.0;
+  };
+  out << layer << ": mean " << milliseconds(sum / latencies.size()) << " ms, p50 " << milliseconds(latencies[latencies.size() / 2])
+      << " ms, p99 " << milliseconds(latencies[std::min<int>(latencies.size() - 1, latencies.size() * 0.99)]) << " ms, max "
+      << milliseconds(latencies.last()) << " ms\n";
+}
+
+QVector<qint64> runLegacyScheduler(const QJsonObject& jsonPlan, const QString& binary, LegacyScheduler::SchedulingMode mode, int jobs) {
+  QVector<qint64> latencies;
+  for(int i = 0; i < jobs; i++) {
+    QElapsedTimer timer;
+    timer.start();
+    QSharedPointer<Plan> plan(new Plan());
+    if(!jsonPlan.isEmpty()) {
+      plan->fromJsonObject(jsonPlan);
+    }
+    LegacyScheduler scheduler(plan, binary, false, mode);
+    QEventLoop loop;
+    bool finished = false;
+    QObject::connect(&scheduler, &Scheduler::finishedScheduling, &loop, [&finished, &loop]() {
+      finished = true;
+      loop.quit();
+    });
+    QObject::connect(&scheduler, &Scheduler::failedScheduling, &loop, &QEventLoop::quit);
+    if(scheduler.startScheduling()) {
+      loop.exec();
+    }
+    if(!finished) {
+      qDebug() << "A LegacyScheduler job failed";
+      return QVector<qint64>();
+    }
+    latencies.append(timer.nsecsElapsed());
+  }
+  return latencies;
+}
+
+QVector<qint64> runSchedulerService(const QJsonObject& jsonPlan, const QString& binary, bool good, int jobs) {
+  QTemporaryDir storage;
+  QList<QString> arguments{"overhead-benchmark", "--storage", storage.path(), "--legacy-scheduler-binary", binary};
+  QSharedPointer<Configuration> configuration(new Configuration(arguments));
+
+  QVector<qint64> latencies;
+  for(int i = 0; i < jobs; i++) {
+    QElapsedTimer timer;
+    timer.start();
+    SchedulerService service(configuration);
+    service.setSchedulingAlgorithm(good ? "legacy-good" : "legacy-fast");
+    QEventLoop loop;
+    bool finished = false;
+    QObject::connect(&service, &SchedulerService::finishedScheduling, &loop, [&finished, &loop]() {
+      finished = true;
+      loop.quit();
+    });
+    QObject::connect(&service, &SchedulerService::failedScheduling, &loop, &QEventLoop::quit);
+    if(service.startScheduling(jsonPlan)) {
+      loop.exec();
+    }
+    if(!finished) {
+      qDebug() << "A SchedulerService job failed";
+      return QVector<qint64>();
+    }
+    latencies.append(timer.nsecsElapsed());
+  }
+  return latencies;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Overhead benchmark for the LegacyScheduler and the SchedulerService");
+  parser.addHelpOption();
+  QCommandLineOption binaryOption("binary", "The SPA-algorithmus stub", "binary", "./SPA-algorithmus-stub");
+  parser.addOption(binaryOption);
+  QCommandLineOption planOption("plan", "Schedule this plan as .json file. Defaults to an empty plan.", "plan");
+  parser.addOption(planOption);
+  QCommandLineOption jobsOption("jobs", "The number of jobs per layer", "jobs", "200");
+  parser.addOption(jobsOption);
+  QCommandLineOption goodOption("good", "Use the Good mode instead of the Fast mode");
+  parser.addOption(goodOption);
+  parser.process(application);
+
+  QString binary = parser.value(binaryOption);
+  int jobs = parser.value(jobsOption).toInt();
+  bool good = parser.isSet(goodOption);
+
+  QJsonObject jsonPlan;
+  if(parser.isSet(planOption)) {
+    QFile planFile(parser.value(planOption));
+    if(!planFile.open(QFile::ReadOnly)) {
+      qDebug() << "Failed to open" << planFile.fileName();
+      return 1;
+    }
+    jsonPlan = QJsonDocument::fromJson(planFile.readAll()).object();
+  }
+
+  // The stub finishes immediately
+  QTemporaryDir scriptDirectory;
+  QFile script(scriptDirectory.filePath("script"));
+  if(!script.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  script.write("schedule\nexit 0\n");
+  script.close();
+  qputenv("SPA_STUB_SCRIPT", script.fileName().toUtf8());
+
+  QTextStream out(stdout);
+  out << "jobs per layer: " << jobs << ", mode: " << (good ? "good" : "fast") << "\n";
+  printLatencies(out, "LegacyScheduler", runLegacyScheduler(jsonPlan, binary, good ? LegacyScheduler::Good : LegacyScheduler::Fast, jobs));
+  printLatencies(out, "SchedulerService", runSchedulerService(jsonPlan, binary, good, jobs));
+  return 0;
+}
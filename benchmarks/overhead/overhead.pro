@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = overhead-benchmark
+
+SOURCES += \
+        main.cpp
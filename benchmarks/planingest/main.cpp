@@ -0,0 +1,155 @@
+/**
+ * Measures the peak memory of reading a large plan.
+ *
+ * A plan with many modules is generated by copying the modules of a seed
+ * plan. Every ingest path then reads the generated file in its own process,
+ * so the peak resident set sizes do not influence each other:
+ *
+ * - dom reads the file, parses it into a QJsonDocument and builds the plan,
+ *   while the document is still alive. This is what happens to a plan, that
+ *   arrives over RPC.
+ * - reader uses the PlanReader, which maps the file and drops the document
+ *   as soon as the plan is built.
+ * - estimate measures PlanReader::estimateSize on the parsed document, which
+ *   is the size check of the SchedulerService.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "planreader.h"
+
+qint64 readStatus(const QByteArray& field) {
+  QFile status("/proc/self/status");
+  if(status.open(QFile::ReadOnly)) {
+    for(const QByteArray& line : status.readAll().split('\n')) {
+      if(line.startsWith(field + ":")) {
+        return line.mid(field.size() + 1).trimmed().split(' ').first().toLongLong();
+      }
+    }
+  }
+  return 0;
+}
+
+// Copy the modules of the seed plan, until the plan has moduleCount modules
+QJsonObject generatePlan(const QJsonObject& seedPlan, int moduleCount) {
+  QJsonArray seedModules = seedPlan["modules"].toArray();
+  if(seedModules.isEmpty()) {
+    return seedPlan;
+  }
+  QJsonArray modules;
+  for(int i = 0; i < moduleCount; i++) {
+    QJsonObject module = seedModules[i % seedModules.size()].toObject();
+    if(i >= seedModules.size()) {
+      QString suffix = "-" + QString::number(i / seedModules.size());
+      for(const QString& key : {"number", "name"}) {
+        if(module[key].isString()) {
+          module[key] = module[key].toString() + suffix;
+        }
+      }
+    }
+    modules.append(module);
+  }
+  QJsonObject plan = seedPlan;
+  plan["modules"] = modules;
+  return plan;
+}
+
+int runStage(const QString& stage, const QString& input) {
+  qint64 baseline = readStatus("VmRSS");
+  QElapsedTimer timer;
+  timer.start();
+  int modules = 0;
+
+  if(stage == "dom") {
+    QFile file(input);
+    if(!file.open(QFile::ReadOnly)) {
+      return 1;
+    }
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    Plan plan;
+    plan.fromJsonObject(document.object());
+    modules = plan.getModules().size();
+  } else if(stage == "reader") {
+    PlanReader reader;
+    QSharedPointer<Plan> plan = reader.readFile(input);
+    if(plan.isNull()) {
+      return 1;
+    }
+    modules = plan->getModules().size();
+  } else if(stage == "estimate") {
+    QFile file(input);
+    if(!file.open(QFile::ReadOnly)) {
+      return 1;
+    }
+    QJsonObject plan = QJsonDocument::fromJson(file.readAll()).object();
+    baseline = readStatus("VmRSS");
+    timer.restart();
+    PlanReader::estimateSize(plan);
+    modules = plan["modules"].toArray().size();
+  } else {
+    return 1;
+  }
+
+  QTextStream(stdout) << modules << " " << timer.nsecsElapsed() / 1000000.0 << " " << readStatus("VmHWM") - baseline << "\n";
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Peak memory benchmark for reading large plans");
+  parser.addHelpOption();
+  parser.addPositionalArgument("plan", "A seed plan as .json file");
+  QCommandLineOption modulesOption("modules", "The number of modules of the generated plan", "modules", "10000");
+  parser.addOption(modulesOption);
+  QCommandLineOption stageOption("stage", "Internal: run a single ingest path", "stage");
+  parser.addOption(stageOption);
+  parser.process(application);
+
+  if(parser.positionalArguments().size() != 1) {
+    parser.showHelp(1);
+  }
+  if(parser.isSet(stageOption)) {
+    return runStage(parser.value(stageOption), parser.positionalArguments().first());
+  }
+
+  QFile seedFile(parser.positionalArguments().first());
+  if(!seedFile.open(QFile::ReadOnly)) {
+    qDebug() << "Failed to open" << seedFile.fileName();
+    return 1;
+  }
+  QJsonObject plan = generatePlan(QJsonDocument::fromJson(seedFile.readAll()).object(), parser.value(modulesOption).toInt());
+
+  QTemporaryDir directory;
+  QFile planFile(directory.filePath("plan.json"));
+  if(!planFile.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  qint64 planSize = planFile.write(QJsonDocument(plan).toJson(QJsonDocument::Compact));
+  planFile.close();
+  plan = QJsonObject();
+
+  QTextStream out(stdout);
+  out << "plan size: " << planSize / 1024 << " kB\n";
+  out << "path,modules,milliseconds,peak kB\n";
+  for(const QString& stage : {"dom", "reader", "estimate"}) {
+    QProcess process;
+    process.start(QCoreApplication::applicationFilePath(), {"--stage", stage, planFile.fileName()});
+    process.waitForFinished(-1);
+    QList<QByteArray> result = process.readAllStandardOutput().trimmed().split(' ');
+    if(process.exitCode() != 0 || result.size() != 3) {
+      out << stage << ",failed\n";
+      continue;
+    }
+    out << stage << "," << result[0] << "," << result[1] << "," << result[2] << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = planingest-benchmark
+
+SOURCES += \
+        main.cpp
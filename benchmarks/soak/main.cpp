@@ -0,0 +1,145 @@
+/**
+ * Soak benchmark for the memory of the SchedulerService.
+ *
+ * Runs thousands of jobs one after another through a SchedulerService, like a
+ * server over an exam season. The plan is parsed, scheduled by the
+ * SPA-algorithmus stub or the exact scheduler and serialized in every job.
+ * The valid plan of the test data is used by default. The stub writes a
+ * schedule with a row for every active module, because an empty schedule is
+ * rejected for a plan with active modules.
+ * The resident memory is measured after every round of jobs.
+ *
+ * The first round is the warm up, it fills the caches and the heaps. After
+ * it, the resident memory should stay flat. The benchmark fails, if it grew
+ * by more than --max-growth over the remaining rounds.
+ */
+
+#include <testdatahelper.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QTimer>
+#include <algorithm>
+
+#include "jobmemory.h"
+#include "plan.h"
+#include "schedulerservice.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Soak benchmark for the memory of many consecutive jobs");
+  parser.addHelpOption();
+  QCommandLineOption binaryOption("binary", "The SPA-algorithmus stub", "binary", "./SPA-algorithmus-stub");
+  parser.addOption(binaryOption);
+  QCommandLineOption planOption("plan", "Schedule this plan as .json file. Defaults to the valid plan of the test data.", "plan");
+  parser.addOption(planOption);
+  QCommandLineOption jobsOption("jobs", "The number of jobs", "jobs", "5000");
+  parser.addOption(jobsOption);
+  QCommandLineOption roundsOption("rounds", "The number of rounds, after which the memory is measured", "rounds", "10");
+  parser.addOption(roundsOption);
+  QCommandLineOption algorithmOption("algorithm", "The scheduling algorithm", "algorithm", "legacy-fast");
+  parser.addOption(algorithmOption);
+  QCommandLineOption arenasOption("malloc-arenas", "The maximum number of heaps. 0 keeps the default of glibc.", "malloc-arenas", "0");
+  parser.addOption(arenasOption);
+  QCommandLineOption maxGrowthOption(
+      "max-growth", "The allowed growth of the resident memory after the warm up in kB", "max-growth", "2048");
+  parser.addOption(maxGrowthOption);
+  parser.process(application);
+
+  JobMemory::limitArenas(parser.value(arenasOption).toInt());
+  int jobs = parser.value(jobsOption).toInt();
+  int rounds = std::max(parser.value(roundsOption).toInt(), 2);
+  qint64 maxGrowth = parser.value(maxGrowthOption).toLongLong();
+
+  QJsonObject jsonPlan = getValidJsonPlan();
+  if(parser.isSet(planOption)) {
+    QFile planFile(parser.value(planOption));
+    if(!planFile.open(QFile::ReadOnly)) {
+      qDebug() << "Failed to open" << planFile.fileName();
+      return 1;
+    }
+    jsonPlan = QJsonDocument::fromJson(planFile.readAll()).object();
+  }
+
+  // The stub finishes immediately with every active module in the first timeslot
+  QTemporaryDir scriptDirectory;
+  QFile scheduleFile(scriptDirectory.filePath("schedule.csv"));
+  if(!scheduleFile.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  Plan plan;
+  plan.fromJsonObject(jsonPlan);
+  for(Module* module : plan.getModules()) {
+    if(module->getActive()) {
+      scheduleFile.write("1;1;" + module->getNumber().toUtf8() + "\n");
+    }
+  }
+  scheduleFile.close();
+  QFile script(scriptDirectory.filePath("script"));
+  if(!script.open(QFile::WriteOnly)) {
+    return 1;
+  }
+  script.write("schedule " + scheduleFile.fileName().toUtf8() + "\nexit 0\n");
+  script.close();
+  qputenv("SPA_STUB_SCRIPT", script.fileName().toUtf8());
+
+  QTemporaryDir storage;
+  QList<QString> arguments{"soak-benchmark", "--storage", storage.path(), "--legacy-scheduler-binary", parser.value(binaryOption)};
+  QSharedPointer<Configuration> configuration(new Configuration(arguments));
+
+  QTextStream out(stdout);
+  out << "jobs: " << jobs << ", rounds: " << rounds << ", algorithm: " << parser.value(algorithmOption) << "\n";
+
+  int failed = 0;
+  QVector<qint64> residentKilobytes;
+  for(int round = 0; round < rounds; round++) {
+    int jobsOfRound = jobs / rounds + (round < jobs % rounds ? 1 : 0);
+    qint64 maxHeapGrowth = 0;
+    qint64 sumHeapGrowth = 0;
+    for(int job = 0; job < jobsOfRound; job++) {
+      SchedulerService service(configuration);
+      service.setSchedulingAlgorithm(parser.value(algorithmOption));
+      QEventLoop loop;
+      bool finished = false;
+      QObject::connect(&service, &SchedulerService::finishedScheduling, &loop, [&finished, &loop]() {
+        finished = true;
+        loop.quit();
+      });
+      QObject::connect(&service, &SchedulerService::failedScheduling, &loop, &QEventLoop::quit);
+      if(service.startScheduling(jsonPlan)) {
+        loop.exec();
+      }
+      if(!finished) {
+        failed++;
+      }
+      // The jobs run one after another, so the growth of the process heap is the growth of the job
+      qint64 heapGrowth = service.getJobMetrics()["peakProcessHeapGrowth"].toVariant().toLongLong();
+      maxHeapGrowth = std::max(maxHeapGrowth, heapGrowth);
+      sumHeapGrowth += heapGrowth;
+    }
+    // Process the remaining deleteLater calls
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    // The heaps are trimmed in the pool, at most once per minTrimInterval
+    QEventLoop trimLoop;
+    QTimer::singleShot(JobMemory::minTrimInterval, &trimLoop, &QEventLoop::quit);
+    trimLoop.exec();
+    QThreadPool::globalInstance()->waitForDone();
+    residentKilobytes.append(JobMemory::getResidentBytes() / 1024);
+    out << "round " << round << ": resident memory " << residentKilobytes.last() << " kB, heap growth per job: mean "
+        << (jobsOfRound > 0 ? sumHeapGrowth / jobsOfRound : 0) << " B, max " << maxHeapGrowth << " B\n";
+    out.flush();
+  }
+
+  // The first round is the warm up
+  qint64 growth = residentKilobytes.last() - residentKilobytes.first();
+  out << "failed jobs: " << failed << "\n";
+  out << "growth after the warm up: " << growth << " kB (allowed " << maxGrowth << " kB)\n";
+  return failed > 0 || growth > maxGrowth ? 1 : 0;
+}
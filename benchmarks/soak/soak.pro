@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = soak-benchmark
+
+SOURCES += \
+        main.cpp
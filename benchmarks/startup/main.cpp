@@ -0,0 +1,161 @@
+/**
+ * Measures the time from starting the server to its first accepted connection.
+ *
+ * The server binary is started repeatedly with a fresh storage directory. The
+ * benchmark connects with a websocket every few milliseconds, until the
+ * connection is accepted. Every scenario runs with retrieveSettings:
+ *
+ * - static does not retrieve the settings, the public key is read from a file.
+ * - cached retrieves the settings from an auth server, that accepts
+ *   connections, but never answers. The settings of an earlier run are in the
+ *   cache of the storage directory.
+ * - uncached is the same without the cache. The server starts without a key
+ *   and rejects tokens, until the auth server answers.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QProcess>
+#include <QTcpServer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <QWebSocket>
+#include <algorithm>
+
+#include "authsettings.h"
+
+quint16 findFreePort() {
+  QTcpServer server;
+  server.listen(QHostAddress::LocalHost);
+  return server.serverPort();
+}
+
+// Returns the milliseconds until the first connection was accepted or -1, if the server did not start
+double measureStartup(const QString& server, const QList<QString>& arguments, quint16 port, int timeout) {
+  QProcess process;
+  process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  QElapsedTimer timer;
+  timer.start();
+  process.start(server, arguments);
+
+  QWebSocket socket;
+  QEventLoop loop;
+  bool connected = false;
+  QTimer retryTimer;
+  retryTimer.setSingleShot(true);
+  QObject::connect(&socket, &QWebSocket::connected, &loop, [&connected, &loop]() {
+    connected = true;
+    loop.quit();
+  });
+  // The connection is refused, until the server listens
+  QObject::connect(&socket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error), &retryTimer, [&retryTimer]() {
+    retryTimer.start(2);
+  });
+  QObject::connect(&retryTimer, &QTimer::timeout, &socket, [&socket, port]() {
+    socket.open(QUrl("ws://127.0.0.1:" + QString::number(port)));
+  });
+  QObject::connect(&process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), &loop, &QEventLoop::quit);
+  QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+  socket.open(QUrl("ws://127.0.0.1:" + QString::number(port)));
+  loop.exec();
+  double milliseconds = timer.nsecsElapsed() / 1000000.0;
+
+  socket.abort();
+  process.terminate();
+  if(!process.waitForFinished(5000)) {
+    process.kill();
+    process.waitForFinished();
+  }
+  return connected ? milliseconds : -1;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmark for the time until the server accepts its first connection");
+  parser.addHelpOption();
+  QCommandLineOption serverOption("server", "The server binary", "server", "./pruefungsplaner-scheduler");
+  parser.addOption(serverOption);
+  QCommandLineOption binaryOption("binary", "The algorithm binary", "binary", "./SPA-algorithmus-stub");
+  parser.addOption(binaryOption);
+  QCommandLineOption runsOption("runs", "The number of starts per scenario", "runs", "20");
+  parser.addOption(runsOption);
+  QCommandLineOption timeoutOption("timeout", "Give up on a start after this many milliseconds", "timeout", "30000");
+  parser.addOption(timeoutOption);
+  parser.process(application);
+
+  int runs = std::max(parser.value(runsOption).toInt(), 1);
+  int timeout = parser.value(timeoutOption).toInt();
+
+  QTemporaryDir keyDirectory;
+  QString privateKeyFile = keyDirectory.filePath("private_key.pem");
+  QString publicKeyFile = keyDirectory.filePath("public_key.pem");
+  if(QProcess::execute("openssl", {"genpkey", "-algorithm", "RSA", "-pkeyopt", "rsa_keygen_bits:2048", "-out", privateKeyFile}) != 0 ||
+     QProcess::execute("openssl", {"pkey", "-in", privateKeyFile, "-pubout", "-out", publicKeyFile}) != 0) {
+    qDebug() << "Failed to generate a key pair with openssl";
+    return 1;
+  }
+  QFile publicKey(publicKeyFile);
+  if(!publicKey.open(QFile::ReadOnly)) {
+    return 1;
+  }
+
+  // An auth server, that hangs
+  QTcpServer authServer;
+  authServer.listen(QHostAddress::LocalHost);
+  QString authUrl = "ws://127.0.0.1:" + QString::number(authServer.serverPort());
+  AuthSettings cachedSettings;
+  cachedSettings.authUrl = authUrl;
+  cachedSettings.publicKey = publicKey.readAll();
+  cachedSettings.issuer = "pruefungsplaner-auth";
+
+  QTextStream out(stdout);
+  out << "runs: " << runs << "\n";
+  out << "scenario,mean ms,p50 ms,max ms,failed\n";
+  for(const QString& scenario : {"static", "cached", "uncached"}) {
+    QVector<double> startups;
+    int failed = 0;
+    for(int run = 0; run < runs; run++) {
+      QTemporaryDir storage;
+      quint16 port = findFreePort();
+      QList<QString> arguments{"--address",
+                               "127.0.0.1",
+                               "--port",
+                               QString::number(port),
+                               "--storage",
+                               storage.path(),
+                               "--legacy-scheduler-binary",
+                               parser.value(binaryOption)};
+      if(scenario == "static") {
+        arguments << "--public-key" << publicKeyFile << "--no-retrieve";
+      } else {
+        arguments << "--retrieve"
+                  << "--auth-server" << authUrl;
+      }
+      if(scenario == "cached") {
+        cachedSettings.writeCache(storage.path());
+      }
+      double startup = measureStartup(parser.value(serverOption), arguments, port, timeout);
+      if(startup < 0) {
+        failed++;
+      } else {
+        startups.append(startup);
+      }
+    }
+    std::sort(startups.begin(), startups.end());
+    double sum = 0;
+    for(double startup : startups) {
+      sum += startup;
+    }
+    if(startups.isEmpty()) {
+      out << scenario << ",,,," << failed << "\n";
+    } else {
+      out << scenario << "," << sum / startups.size() << "," << startups[startups.size() / 2] << "," << startups.last() << "," << failed << "\n";
+    }
+  }
+  return 0;
+}
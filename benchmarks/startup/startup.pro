@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = startup-benchmark
+
+SOURCES += \
+        main.cpp
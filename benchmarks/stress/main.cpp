@@ -0,0 +1,181 @@
+/**
+ * Stress benchmark for the LegacyScheduler.
+ *
+ * Runs many scheduler jobs at once against the SPA-algorithmus stub, that only
+ * prints a few lines and writes an empty schedule. The runtime is spent in our
+ * own code: spawning processes, reading their output and reading the results.
+ * Set SPA_STUB_SCRIPT to change the timing of the stub.
+ *
+ * The benchmark reports the throughput, the latency of the event loop while
+ * the jobs are running and resources, that were not released after every job
+ * finished.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+#include "legacyscheduler.h"
+
+struct Resources {
+  qint64 residentKilobytes = 0;
+  int openFiles = 0;
+};
+
+Resources measureResources() {
+  Resources resources;
+  QFile status("/proc/self/status");
+  if(status.open(QFile::ReadOnly)) {
+    for(const QByteArray& line : status.readAll().split('\n')) {
+      if(line.startsWith("VmRSS:")) {
+        resources.residentKilobytes = line.mid(6).trimmed().split(' ').first().toLongLong();
+      }
+    }
+  }
+  resources.openFiles = QDir("/proc/self/fd").entryList(QDir::Files | QDir::System).size();
+  return resources;
+}
+
+double percentile(const QVector<qint64>& sortedSamples, double rank) {
+  if(sortedSamples.isEmpty()) {
+    return 0.0;
+  }
+  int index = std::min<int>(sortedSamples.size() - 1, rank * sortedSamples.size());
+  return sortedSamples[index] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Stress benchmark for concurrent scheduler jobs");
+  parser.addHelpOption();
+  QCommandLineOption binaryOption("binary", "The algorithm binary", "binary", "./SPA-algorithmus-stub");
+  parser.addOption(binaryOption);
+  QCommandLineOption planOption("plan", "Schedule this plan as .json file. Defaults to an empty plan.", "plan");
+  parser.addOption(planOption);
+  QCommandLineOption jobsOption("jobs", "The number of jobs", "jobs", "1000");
+  parser.addOption(jobsOption);
+  QCommandLineOption concurrencyOption("concurrency", "The number of jobs running at once", "concurrency", "200");
+  parser.addOption(concurrencyOption);
+  QCommandLineOption goodOption("good", "Use the Good mode instead of the Fast mode");
+  parser.addOption(goodOption);
+  parser.process(application);
+
+  QString binary = parser.value(binaryOption);
+  int jobs = parser.value(jobsOption).toInt();
+  int concurrency = std::max(parser.value(concurrencyOption).toInt(), 1);
+  LegacyScheduler::SchedulingMode mode = parser.isSet(goodOption) ? LegacyScheduler::Good : LegacyScheduler::Fast;
+
+  QJsonObject jsonPlan;
+  if(parser.isSet(planOption)) {
+    QFile planFile(parser.value(planOption));
+    if(!planFile.open(QFile::ReadOnly)) {
+      qDebug() << "Failed to open" << planFile.fileName();
+      return 1;
+    }
+    jsonPlan = QJsonDocument::fromJson(planFile.readAll()).object();
+  }
+
+  // Warm up, so lazily initialized state is not counted as a leak
+  {
+    QSharedPointer<Plan> plan(new Plan());
+    LegacyScheduler scheduler(plan, binary, false, mode);
+  }
+  Resources before = measureResources();
+
+  int started = 0;
+  int finished = 0;
+  int failed = 0;
+  int alive = 0;
+
+  // The timer should fire every millisecond, every additional delay is latency of the event loop
+  QVector<qint64> latencies;
+  QElapsedTimer tickTimer;
+  QTimer latencyTimer;
+  latencyTimer.setTimerType(Qt::PreciseTimer);
+  latencyTimer.setInterval(1);
+  QObject::connect(&latencyTimer, &QTimer::timeout, [&latencies, &tickTimer]() {
+    latencies.append(std::max<qint64>(tickTimer.nsecsElapsed() / 1000 - 1000, 0));
+    tickTimer.restart();
+  });
+
+  QElapsedTimer timer;
+  std::function<void()> startJob;
+  std::function<void()> jobDone = [&]() {
+    if(finished + failed == jobs) {
+      latencyTimer.stop();
+      // Let the schedulers get deleted
+      QTimer::singleShot(100, &application, &QCoreApplication::quit);
+    } else if(started < jobs) {
+      startJob();
+    }
+  };
+  startJob = [&]() {
+    started++;
+    QSharedPointer<Plan> plan(new Plan());
+    if(!jsonPlan.isEmpty()) {
+      plan->fromJsonObject(jsonPlan);
+    }
+    LegacyScheduler* scheduler = new LegacyScheduler(plan, binary, false, mode);
+    alive++;
+    QObject::connect(scheduler, &QObject::destroyed, [&alive]() {
+      alive--;
+    });
+    QObject::connect(scheduler, &Scheduler::finishedScheduling, [&, scheduler]() {
+      finished++;
+      scheduler->deleteLater();
+      jobDone();
+    });
+    QObject::connect(scheduler, &Scheduler::failedScheduling, [&, scheduler](QString message) {
+      if(failed == 0) {
+        qDebug() << "First failure:" << message;
+      }
+      failed++;
+      scheduler->deleteLater();
+      jobDone();
+    });
+    if(!scheduler->startScheduling()) {
+      failed++;
+      scheduler->deleteLater();
+      // Do not recurse, the next job is started from the event loop
+      QTimer::singleShot(0, jobDone);
+    }
+  };
+
+  QTimer::singleShot(0, [&]() {
+    timer.start();
+    tickTimer.start();
+    latencyTimer.start();
+    for(int i = 0; i < std::min(concurrency, jobs); i++) {
+      startJob();
+    }
+  });
+  if(jobs > 0) {
+    application.exec();
+  }
+  double seconds = timer.elapsed() / 1000.0;
+  // Process the remaining deleteLater calls
+  QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+  Resources after = measureResources();
+
+  std::sort(latencies.begin(), latencies.end());
+  QTextStream out(stdout);
+  out << "jobs: " << jobs << ", concurrency: " << concurrency << "\n";
+  out << "finished: " << finished << ", failed: " << failed << "\n";
+  out << "throughput: " << (seconds > 0 ? finished / seconds : 0.0) << " jobs/s (" << seconds << " s)\n";
+  out << "event loop latency (ms): p50 " << percentile(latencies, 0.5) << ", p90 " << percentile(latencies, 0.9) << ", p99 "
+      << percentile(latencies, 0.99) << ", max " << (latencies.isEmpty() ? 0.0 : latencies.last() / 1000.0) << "\n";
+  out << "schedulers alive: " << alive << "\n";
+  out << "open files: " << before.openFiles << " -> " << after.openFiles << "\n";
+  out << "resident memory (kB): " << before.residentKilobytes << " -> " << after.residentKilobytes << "\n";
+
+  bool leaked = alive != 0 || after.openFiles > before.openFiles;
+  return leaked || failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = stress-benchmark
+
+SOURCES += \
+        main.cpp
@@ -0,0 +1,91 @@
+/**
+ * Measures the overhead of verifying the token of every RPC call.
+ *
+ * A key pair is generated with openssl and a few clients get a token each.
+ * The clients then make their calls in turns, like clients polling the
+ * progress of their jobs. Every call verifies the token of its client once
+ * with a TokenVerifier without cache and once with the default cache.
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "tokenverifier.h"
+
+QString readFile(const QString& fileName) {
+  QFile file(fileName);
+  if(!file.open(QFile::ReadOnly)) {
+    return "";
+  }
+  return file.readAll();
+}
+
+// Returns the mean time per call in microseconds or -1, if a call was rejected
+double measureCalls(TokenVerifier& verifier, const QList<QString>& tokens, int calls) {
+  QElapsedTimer timer;
+  timer.start();
+  for(int i = 0; i < calls; i++) {
+    if(!verifier.verify(tokens[i % tokens.size()])) {
+      return -1;
+    }
+  }
+  return timer.nsecsElapsed() / 1000.0 / calls;
+}
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmark for the verification of the tokens of RPC calls");
+  parser.addHelpOption();
+  QCommandLineOption callsOption("calls", "The number of calls", "calls", "10000");
+  parser.addOption(callsOption);
+  QCommandLineOption clientsOption("clients", "The number of clients with their own token", "clients", "16");
+  parser.addOption(clientsOption);
+  parser.process(application);
+
+  int calls = std::max(parser.value(callsOption).toInt(), 1);
+  int clients = std::max(parser.value(clientsOption).toInt(), 1);
+
+  QTemporaryDir directory;
+  QString privateKeyFile = directory.filePath("private_key.pem");
+  QString publicKeyFile = directory.filePath("public_key.pem");
+  if(QProcess::execute("openssl", {"genpkey", "-algorithm", "RSA", "-pkeyopt", "rsa_keygen_bits:2048", "-out", privateKeyFile}) != 0 ||
+     QProcess::execute("openssl", {"pkey", "-in", privateKeyFile, "-pubout", "-out", publicKeyFile}) != 0) {
+    qDebug() << "Failed to generate a key pair with openssl";
+    return 1;
+  }
+  std::string privateKey = readFile(privateKeyFile).toStdString();
+  std::string publicKey = readFile(publicKeyFile).toStdString();
+
+  QList<QString> claims{"pruefungsplanerStartSchedule", "pruefungsplanerRetrieveSchedule"};
+  QList<QString> tokens;
+  for(int i = 0; i < clients; i++) {
+    auto token = jwt::create()
+                     .set_issuer("pruefungsplaner-auth")
+                     .set_subject("client-" + std::to_string(i))
+                     .set_expires_at(std::chrono::system_clock::now() + std::chrono::hours(1));
+    for(const QString& claim : claims) {
+      token.set_payload_claim(claim.toStdString(), jwt::claim(picojson::value(true)));
+    }
+    tokens.append(QString::fromStdString(token.sign(jwt::algorithm::rs256(publicKey, privateKey, "", ""))));
+  }
+
+  TokenVerifier uncachedVerifier;
+  uncachedVerifier.configure(QString::fromStdString(publicKey), "pruefungsplaner-auth", claims, 0);
+  TokenVerifier cachedVerifier;
+  cachedVerifier.configure(QString::fromStdString(publicKey), "pruefungsplaner-auth", claims);
+
+  QTextStream out(stdout);
+  out << "calls: " << calls << ", clients: " << clients << "\n";
+  out << "verifier,microseconds per call,signature checks\n";
+  double uncached = measureCalls(uncachedVerifier, tokens, calls);
+  out << "uncached," << uncached << "," << uncachedVerifier.getCacheMisses() << "\n";
+  double cached = measureCalls(cachedVerifier, tokens, calls);
+  out << "cached," << cached << "," << cachedVerifier.getCacheMisses() << "\n";
+  return uncached < 0 || cached < 0 ? 1 : 0;
+}
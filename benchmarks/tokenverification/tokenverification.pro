@@ -0,0 +1,6 @@
+include($$PWD/../benchmark.pri)
+
+TARGET = tokenverification-benchmark
+
+SOURCES += \
+        main.cpp
@@ -0,0 +1,17 @@
+# Common settings for the libFuzzer targets. Every target is a separate application in its own directory.
+# The targets need clang. Run them with a corpus directory, for example ./schedulecsvreader-fuzzer corpus/
+QT -= gui
+QT += websockets
+
+CONFIG += c++2a console
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+QMAKE_CC = clang
+QMAKE_CXX = clang++
+QMAKE_LINK = clang++
+QMAKE_CXXFLAGS += -g -fsanitize=fuzzer,address,undefined
+QMAKE_LFLAGS += -fsanitize=fuzzer,address,undefined
+
+include($$PWD/../src/src.pri)
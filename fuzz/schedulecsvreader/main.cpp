@@ -0,0 +1,51 @@
+/**
+ * libFuzzer target for the SPA-planung-pruef.csv reader.
+ *
+ * Every input is written as the schedule file of a result directory and read
+ * into a plan. Without a plan only the field parsing is reached, so set
+ * FUZZ_PLAN to a plan as .json file, to also fuzz the module lookup and the
+ * timeslot assignment.
+ */
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include <cstdint>
+#include <cstdlib>
+
+#include "plan.h"
+#include "schedulecsvreader.h"
+
+static QTemporaryDir* resultDirectory;
+static QJsonObject jsonPlan;
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+  resultDirectory = new QTemporaryDir();
+  const char* planPath = std::getenv("FUZZ_PLAN");
+  if(planPath != nullptr) {
+    QFile planFile(planPath);
+    if(planFile.open(QFile::ReadOnly)) {
+      jsonPlan = QJsonDocument::fromJson(planFile.readAll()).object();
+    }
+  }
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  QFile scheduleFile(resultDirectory->path() + "/" + ScheduleCsvReader::scheduleFileName);
+  if(!scheduleFile.open(QFile::WriteOnly | QFile::Truncate)) {
+    std::abort();
+  }
+  scheduleFile.write(reinterpret_cast<const char*>(data), size);
+  scheduleFile.close();
+
+  QSharedPointer<Plan> plan(new Plan());
+  if(!jsonPlan.isEmpty()) {
+    plan->fromJsonObject(jsonPlan);
+  }
+  ScheduleCsvReader reader(resultDirectory->path());
+  reader.readSchedule(plan.get());
+  return 0;
+}
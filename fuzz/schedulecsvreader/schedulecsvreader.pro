@@ -0,0 +1,6 @@
+include($$PWD/../fuzz.pri)
+
+TARGET = schedulecsvreader-fuzzer
+
+SOURCES += \
+        main.cpp
@@ -0,0 +1,27 @@
+/**
+ * libFuzzer target for the scanner of the SPA-algorithmus output.
+ *
+ * LegacyScheduler reads the output line by line and decodes it as UTF-8, so
+ * every input is split at line breaks and every line is parsed.
+ */
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <cstdlib>
+
+#include "spalogparser.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  QByteArray input(reinterpret_cast<const char*>(data), size);
+  for(const QByteArray& line : input.split('\n')) {
+    SpaLogParser::Line parsedLine = SpaLogParser::parse(QString::fromUtf8(line));
+    if(parsedLine.type == SpaLogParser::SoftBest && parsedLine.softBest < 0) {
+      std::abort();
+    }
+    if(parsedLine.type == SpaLogParser::ResultDirectory && !line.contains("Details in: ")) {
+      std::abort();
+    }
+  }
+  return 0;
+}
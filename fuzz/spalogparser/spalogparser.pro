@@ -0,0 +1,6 @@
+include($$PWD/../fuzz.pri)
+
+TARGET = spalogparser-fuzzer
+
+SOURCES += \
+        main.cpp
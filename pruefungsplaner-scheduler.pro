@@ -4,25 +4,10 @@ QT += websockets
 CONFIG += c++2a console
 CONFIG -= app_bundle
 
-include($$PWD/libs/pruefungsplaner-datamodel/pruefungsplaner-datamodel.pri)
-include($$PWD/libs/pruefungsplaner-auth/client/client.pri)
-include($$PWD/libs/qt-jsonrpc-server/qt-jsonrpc-server.pri)
-INCLUDEPATH += $$PWD/libs/jwt-cpp/include
-INCLUDEPATH += $$PWD/libs/cpptoml/include
-
-LIBS += -lcrypto
+include($$PWD/src/src.pri)
 
 SOURCES += \
-        src/configuration.cpp \
-        src/main.cpp \
-        src/legacyscheduler.cpp \
-        src/schedulerservice.cpp
-
-HEADERS += \
-    src/configuration.h \
-    src/legacyscheduler.h \
-    src/scheduler.h \
-    src/schedulerservice.h
+        src/main.cpp
 
 test{
     message(Building tests)
@@ -36,10 +21,38 @@ test{
     LIBS += -lgtest
     INCLUDEPATH += src
 
+    # Some tests replace SPA-algorithmus with the stub
+    include($$PWD/tools/SPA-algorithmus-stub/stub.pri)
+
+    HEADERS += tests/planhelper.h
+
     SOURCES -= src/main.cpp
     SOURCES += tests/qthelper.cpp \
+            tests/admissioncontroltest.cpp \
+            tests/algorithmselectortest.cpp \
+            tests/authsettingstest.cpp \
+            tests/batchjobtest.cpp \
+            tests/branchandboundtest.cpp \
+            tests/configurationprovidertest.cpp \
+            tests/cpuplacementtest.cpp \
+            tests/exactschedulertest.cpp \
+            tests/feasibilitychecktest.cpp \
+            tests/jobcoalescertest.cpp \
+            tests/jobjournaltest.cpp \
+            tests/jobmemorytest.cpp \
+            tests/jobpipelinetest.cpp \
             tests/legacyschedulertest.cpp \
+            tests/localsearchtest.cpp \
+            tests/planpresolvertest.cpp \
+            tests/planreadertest.cpp \
+            tests/schedulecsvreadertest.cpp \
+            tests/scheduledeltatest.cpp \
             tests/schedulerservicetest.cpp \
+            tests/semesterjobtest.cpp \
+            tests/softpenaltyboundtest.cpp \
+            tests/spalogparsertest.cpp \
+            tests/tokenverifiertest.cpp \
+            tests/tracertest.cpp \
             libs/gtest/main.cpp
 }
 else{
@@ -0,0 +1,151 @@
+#include "admissioncontrol.h"
+
+QJsonObject AdmissionControl::Decision::toJsonObject() const {
+  QJsonObject decision;
+  decision["admitted"] = admitted;
+  if(!admitted) {
+    decision["reason"] = reason;
+    decision["retryAfter"] = retryAfter;
+  }
+  return decision;
+}
+
+AdmissionControl::AdmissionControl(QObject* parent): AdmissionControl(&AdmissionControl::readSystemResources, parent) {}
+
+AdmissionControl::AdmissionControl(const std::function<Resources()>& readResources, QObject* parent)
+    : QObject(parent),
+      maxRunningJobs(0),
+      maxQueuedJobs(0),
+      maxLoad(0.0),
+      minAvailableMemory(0),
+      runningJobs(0),
+      queuedJobs(0),
+      meanRuntime(0.0),
+      readResources(readResources) {}
+
+AdmissionControl& AdmissionControl::global() {
+  static AdmissionControl admissionControl;
+  return admissionControl;
+}
+
+void AdmissionControl::configure(int maxRunningJobs, int maxQueuedJobs, double maxLoad, qint64 minAvailableMemory) {
+  {
+    QMutexLocker locker(&mutex);
+    this->maxRunningJobs = std::max(maxRunningJobs, 0);
+    this->maxQueuedJobs = std::max(maxQueuedJobs, 0);
+    this->maxLoad = std::max(maxLoad, 0.0);
+    this->minAvailableMemory = std::max<qint64>(minAvailableMemory, 0);
+  }
+  emit slotFreed();
+}
+
+AdmissionControl::Decision AdmissionControl::tryStart() {
+  QMutexLocker locker(&mutex);
+  Decision decision;
+  if(maxRunningJobs > 0 && runningJobs >= maxRunningJobs) {
+    decision.admitted = false;
+    decision.reason = "The server is running " + QString::number(runningJobs) + " jobs, which is the maximum.";
+    decision.retryAfter = estimateRetryAfter();
+    return decision;
+  }
+  decision = checkResources();
+  if(decision.admitted) {
+    runningJobs++;
+  }
+  return decision;
+}
+
+AdmissionControl::Decision AdmissionControl::tryQueue(int jobs) {
+  QMutexLocker locker(&mutex);
+  Decision decision;
+  if(maxQueuedJobs > 0 && queuedJobs + jobs > maxQueuedJobs) {
+    decision.admitted = false;
+    decision.reason = "The server has " + QString::number(queuedJobs) + " queued jobs and can not queue " + QString::number(jobs) +
+                      " more.";
+    decision.retryAfter = estimateRetryAfter();
+    return decision;
+  }
+  decision = checkResources();
+  if(decision.admitted) {
+    queuedJobs += jobs;
+  }
+  return decision;
+}
+
+bool AdmissionControl::startQueued() {
+  QMutexLocker locker(&mutex);
+  if(maxRunningJobs > 0 && runningJobs >= maxRunningJobs) {
+    return false;
+  }
+  queuedJobs = std::max(queuedJobs - 1, 0);
+  runningJobs++;
+  return true;
+}
+
+void AdmissionControl::dequeue() {
+  QMutexLocker locker(&mutex);
+  queuedJobs = std::max(queuedJobs - 1, 0);
+}
+
+void AdmissionControl::finish(double runtime) {
+  {
+    QMutexLocker locker(&mutex);
+    runningJobs = std::max(runningJobs - 1, 0);
+    if(runtime >= 0) {
+      meanRuntime = meanRuntime == 0.0 ? runtime : 0.8 * meanRuntime + 0.2 * runtime;
+    }
+  }
+  emit slotFreed();
+}
+
+int AdmissionControl::getRunningJobs() const {
+  QMutexLocker locker(&mutex);
+  return runningJobs;
+}
+
+int AdmissionControl::getQueuedJobs() const {
+  QMutexLocker locker(&mutex);
+  return queuedJobs;
+}
+
+AdmissionControl::Resources AdmissionControl::readSystemResources() {
+  Resources resources;
+  QFile loadFile("/proc/loadavg");
+  if(loadFile.open(QFile::ReadOnly)) {
+    resources.load = loadFile.readAll().split(' ').first().toDouble() / std::max(QThread::idealThreadCount(), 1);
+  }
+  QFile memoryFile("/proc/meminfo");
+  if(memoryFile.open(QFile::ReadOnly)) {
+    for(const QByteArray& line : memoryFile.readAll().split('\n')) {
+      if(line.startsWith("MemAvailable:")) {
+        resources.availableMemory = line.mid(13).trimmed().split(' ').first().toLongLong() / 1024;
+      }
+    }
+  }
+  return resources;
+}
+
+AdmissionControl::Decision AdmissionControl::checkResources() const {
+  Decision decision;
+  if(maxLoad == 0.0 && minAvailableMemory == 0) {
+    return decision;
+  }
+  Resources resources = readResources();
+  if(maxLoad > 0.0 && resources.load > maxLoad) {
+    decision.admitted = false;
+    decision.reason = "The load of the server is too high (" + QString::number(resources.load, 'f', 2) + " per core).";
+    decision.retryAfter = resourceRetryAfter;
+  } else if(minAvailableMemory > 0 && resources.availableMemory < minAvailableMemory) {
+    decision.admitted = false;
+    decision.reason = "The server has not enough memory available (" + QString::number(resources.availableMemory) + " MiB).";
+    decision.retryAfter = resourceRetryAfter;
+  }
+  return decision;
+}
+
+int AdmissionControl::estimateRetryAfter() const {
+  if(meanRuntime == 0.0) {
+    return defaultRetryAfter;
+  }
+  return std::max(1, static_cast<int>(std::ceil(meanRuntime / std::max(runningJobs, 1))));
+}
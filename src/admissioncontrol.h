@@ -0,0 +1,153 @@
+#ifndef ADMISSIONCONTROL_H
+#define ADMISSIONCONTROL_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/**
+ *  @class AdmissionControl
+ *  @brief Decides, if the server accepts another job
+ *
+ *  Every job of every connection counts against the same limits, so a burst
+ *  of requests does not slow down the jobs, that were already accepted. A job
+ *  is rejected, if
+ *  - maxRunningJobs jobs are running,
+ *  - maxQueuedJobs batch variants wait for their start,
+ *  - the load average per core is above maxLoad or
+ *  - less than minAvailableMemory MiB of memory are available.
+ *
+ *  A limit of 0 disables the check. A rejected caller gets a hint, after how
+ *  many seconds it should try again. For the job limits, the hint is the mean
+ *  runtime of the recent jobs divided by the number of running jobs, which is
+ *  about the time until the next job finishes.
+ *
+ *  Queued jobs also wait for a free slot, before they start. They are started
+ *  again, when slotFreed is emitted.
+ */
+class AdmissionControl: public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   *  @brief The load and the available memory of the machine
+   */
+  struct Resources {
+    // The load average of the last minute per core
+    double load = 0.0;
+    // The available memory in MiB
+    qint64 availableMemory = 0;
+  };
+
+  /**
+   *  @brief The answer to a request for a job
+   */
+  struct Decision {
+    bool admitted = true;
+    QString reason;
+    // Seconds, after which a rejected request should be retried
+    int retryAfter = 0;
+
+    QJsonObject toJsonObject() const;
+  };
+
+  static constexpr int defaultRetryAfter = 5;
+  static constexpr int resourceRetryAfter = 10;
+
+ private:
+  mutable QMutex mutex;
+  int maxRunningJobs;
+  int maxQueuedJobs;
+  double maxLoad;
+  qint64 minAvailableMemory;
+  int runningJobs;
+  int queuedJobs;
+  // Exponential moving average of the runtime of finished jobs in seconds, 0 if no job finished yet
+  double meanRuntime;
+  std::function<Resources()> readResources;
+
+ public:
+  /**
+   *  @brief Creates a new AdmissionControl without limits, that reads the resources from /proc
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit AdmissionControl(QObject* parent = nullptr);
+
+  /**
+   *  @brief Creates a new AdmissionControl without limits
+   *  @param [in] readResources returns the current resources. It is only called, if a resource limit is set.
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit AdmissionControl(const std::function<Resources()>& readResources, QObject* parent = nullptr);
+
+  /**
+   *  @brief The admission control of the server
+   */
+  static AdmissionControl& global();
+
+  /**
+   *  @brief Set the limits. Accepted jobs keep running.
+   *  @param [in] maxRunningJobs is the maximum number of running jobs
+   *  @param [in] maxQueuedJobs is the maximum number of waiting batch variants
+   *  @param [in] maxLoad is the maximum load average per core
+   *  @param [in] minAvailableMemory is the minimum available memory in MiB
+   */
+  void configure(int maxRunningJobs, int maxQueuedJobs, double maxLoad, qint64 minAvailableMemory);
+
+  /**
+   *  @brief Request to start a job now
+   *  @return The decision. If the job is admitted, it counts as running until finish is called.
+   */
+  Decision tryStart();
+
+  /**
+   *  @brief Request to queue jobs, that are started later with startQueued
+   *  @param [in] jobs is the number of jobs
+   *  @return The decision. If the jobs are admitted, they count as queued until startQueued or dequeue is called.
+   */
+  Decision tryQueue(int jobs);
+
+  /**
+   *  @brief Move a queued job to the running jobs, if less than maxRunningJobs jobs are running
+   *  @return A boolean indicating if the job may start. Otherwise it stays queued until slotFreed is emitted.
+   */
+  bool startQueued();
+
+  /**
+   *  @brief Remove a queued job, that will not be started
+   */
+  void dequeue();
+
+  /**
+   *  @brief Remove a running job
+   *  @param [in] runtime is the runtime of the job in seconds. It is not used for the estimate, if it is negative.
+   */
+  void finish(double runtime = -1.0);
+
+  int getRunningJobs() const;
+  int getQueuedJobs() const;
+
+  /**
+   *  @brief Read the load average and the available memory from /proc
+   */
+  static Resources readSystemResources();
+
+ private:
+  Decision checkResources() const;
+  int estimateRetryAfter() const;
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, when a running job finished or the limits changed
+   */
+  void slotFreed();
+};
+
+#endif  // ADMISSIONCONTROL_H
@@ -0,0 +1,116 @@
+#include "algorithmselector.h"
+
+AlgorithmSelector::AlgorithmSelector(const QString& historyPath): historyPath(historyPath) {
+  if(!historyPath.isEmpty()) {
+    importHistory(historyPath);
+  }
+}
+
+void AlgorithmSelector::record(const PlanFeatures& features, const QString& algorithm, double runtime, const ScheduleScore& score) {
+  HistoryRecord historyRecord{features, algorithm, runtime, score};
+
+  QMutexLocker locker(&mutex);
+  history.append(historyRecord);
+  if(historyPath.isEmpty()) {
+    return;
+  }
+  QFile historyFile(historyPath);
+  if(historyFile.open(QFile::WriteOnly | QFile::Append)) {
+    QJsonObject object;
+    object["features"] = features.toJsonObject();
+    object["algorithm"] = algorithm;
+    object["runtime"] = runtime;
+    object["score"] = score.toJsonObject();
+    historyFile.write(QJsonDocument(object).toJson(QJsonDocument::Compact) + "\n");
+  }
+}
+
+AlgorithmSelector::Prediction AlgorithmSelector::predict(const PlanFeatures& features, const QString& algorithm) const {
+  QList<QPair<double, const HistoryRecord*>> candidates;
+  QMutexLocker locker(&mutex);
+  for(const HistoryRecord& historyRecord : history) {
+    if(historyRecord.algorithm == algorithm) {
+      candidates.append({features.distance(historyRecord.features), &historyRecord});
+    }
+  }
+
+  Prediction prediction;
+  if(candidates.isEmpty()) {
+    return prediction;
+  }
+  int samples = std::min(static_cast<int>(candidates.size()), neighbours);
+  std::partial_sort(candidates.begin(), candidates.begin() + samples, candidates.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  // Closer plans get a higher weight. The runtime of a neighbour is scaled with the module count, because the runtime
+  // grows at least linearly with it.
+  double weightSum = 0.0;
+  double runtime = 0.0;
+  double softPenalty = 0.0;
+  double feasible = 0.0;
+  for(int index = 0; index < samples; index++) {
+    const HistoryRecord* neighbour = candidates[index].second;
+    double weight = 1.0 / (1.0 + candidates[index].first);
+    double moduleRatio = (features.moduleCount + 1.0) / (neighbour->features.moduleCount + 1.0);
+    runtime += weight * neighbour->runtime * moduleRatio;
+    softPenalty += weight * neighbour->score.softPenalty;
+    feasible += weight * (neighbour->score.isFeasible() ? 1.0 : 0.0);
+    weightSum += weight;
+  }
+  prediction.samples = samples;
+  prediction.runtime = runtime / weightSum;
+  prediction.softPenalty = softPenalty / weightSum;
+  prediction.feasibleRate = feasible / weightSum;
+  return prediction;
+}
+
+QString AlgorithmSelector::select(const PlanFeatures& features, double latencyTarget, int exactMaxModules) const {
+  if(exactMaxModules > 0 && features.moduleCount <= exactMaxModules) {
+    return "exact";
+  }
+
+  Prediction good = predict(features, "legacy-good");
+  double goodRuntime = good.samples > 0 ? good.runtime : features.moduleCount * priorGoodSecondsPerModule;
+  if(goodRuntime > latencyTarget) {
+    return "legacy-fast";
+  }
+
+  // Only prefer good mode, if it is not known to be worse
+  Prediction fast = predict(features, "legacy-fast");
+  if(good.samples > 0 && fast.samples > 0 &&
+     (good.feasibleRate < fast.feasibleRate || (good.feasibleRate == fast.feasibleRate && good.softPenalty > fast.softPenalty))) {
+    return "legacy-fast";
+  }
+  return "legacy-good";
+}
+
+QString AlgorithmSelector::resolve(const QString& algorithm, Plan* plan, double latencyTarget, int exactMaxModules) const {
+  if(algorithm != autoAlgorithm) {
+    return algorithm;
+  }
+  return select(PlanFeatures::extract(plan), latencyTarget, exactMaxModules);
+}
+
+void AlgorithmSelector::importHistory(const QString& path) {
+  QFile historyFile(path);
+  if(!historyFile.open(QFile::ReadOnly)) {
+    return;
+  }
+  QMutexLocker locker(&mutex);
+  while(!historyFile.atEnd()) {
+    QJsonObject object = QJsonDocument::fromJson(historyFile.readLine()).object();
+    if(object.isEmpty()) {
+      continue;
+    }
+    HistoryRecord historyRecord;
+    historyRecord.features = PlanFeatures::fromJsonObject(object["features"].toObject());
+    historyRecord.algorithm = object["algorithm"].toString();
+    historyRecord.runtime = object["runtime"].toDouble();
+    QJsonObject score = object["score"].toObject();
+    historyRecord.score.groupConflicts = score["groupConflicts"].toInt();
+    historyRecord.score.unscheduledModules = score["unscheduledModules"].toInt();
+    historyRecord.score.softPenalty = score["softPenalty"].toInt();
+    history.append(historyRecord);
+  }
+}
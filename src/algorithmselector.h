@@ -0,0 +1,111 @@
+#ifndef ALGORITHMSELECTOR_H
+#define ALGORITHMSELECTOR_H
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QString>
+#include <algorithm>
+
+#include "plan.h"
+#include "planfeatures.h"
+#include "scheduleevaluator.h"
+
+/**
+ *  @class AlgorithmSelector
+ *  @brief Selects a scheduling algorithm for the "auto" algorithm
+ *
+ *  The selector keeps a history of finished jobs with the features of their
+ *  plan, their runtime and their score. The runtime and the quality of an
+ *  algorithm for a new plan are predicted from the nearest recorded plans.
+ *  "auto" selects legacy-good, if its predicted runtime fits into the latency
+ *  target, and legacy-fast otherwise. Plans with up to exactMaxModules modules
+ *  are small enough for the exact scheduler, which is always selected for them.
+ *
+ *  Without history for legacy-good, its runtime is estimated with
+ *  priorGoodSecondsPerModule.
+ */
+class AlgorithmSelector {
+ public:
+  static constexpr auto autoAlgorithm = "auto";
+  static constexpr auto historyFileName = "history.jsonl";
+  static constexpr int neighbours = 5;
+  static constexpr double priorGoodSecondsPerModule = 1.0;
+
+  /**
+   * @brief The Prediction struct contains the predicted runtime and quality of an algorithm
+   */
+  struct Prediction {
+    // The number of recorded jobs the prediction is based on. 0 if there is no history.
+    int samples = 0;
+    double runtime = 0.0;
+    double softPenalty = 0.0;
+    // Share of the recorded jobs, that produced a feasible schedule
+    double feasibleRate = 1.0;
+  };
+
+  /**
+   * @brief The HistoryRecord struct describes one finished job
+   */
+  struct HistoryRecord {
+    PlanFeatures features;
+    QString algorithm;
+    double runtime = 0.0;
+    ScheduleScore score;
+  };
+
+ private:
+  QString historyPath;
+  mutable QMutex mutex;
+  QList<HistoryRecord> history;
+
+ public:
+  /**
+   *  @brief Creates a new AlgorithmSelector
+   *  @param [in] historyPath is the file the history is read from and appended to. If it is empty, the history is only
+   * kept in memory.
+   */
+  explicit AlgorithmSelector(const QString& historyPath = "");
+
+  /**
+   *  @brief Record a finished job
+   *  @param [in] features are the features of the scheduled plan
+   *  @param [in] algorithm is the algorithm, that scheduled the plan
+   *  @param [in] runtime is the time scheduling took in seconds
+   *  @param [in] score is the score of the result
+   */
+  void record(const PlanFeatures& features, const QString& algorithm, double runtime, const ScheduleScore& score);
+
+  /**
+   *  @brief Predict the runtime and the quality of an algorithm for a plan
+   */
+  Prediction predict(const PlanFeatures& features, const QString& algorithm) const;
+
+  /**
+   *  @brief Select the best algorithm, that is expected to finish within latencyTarget
+   *  @param [in] features are the features of the plan
+   *  @param [in] latencyTarget is the requested maximum runtime in seconds
+   *  @param [in] exactMaxModules is the maximum number of modules of a plan for the exact scheduler. 0 never selects it.
+   *  @return exact, legacy-good or legacy-fast
+   */
+  QString select(const PlanFeatures& features, double latencyTarget, int exactMaxModules = 0) const;
+
+  /**
+   *  @brief Replace "auto" with the selected algorithm for plan
+   *  @return algorithm, or the selected algorithm, if algorithm is "auto"
+   */
+  QString resolve(const QString& algorithm, Plan* plan, double latencyTarget, int exactMaxModules = 0) const;
+
+  /**
+   *  @brief Add the records of a history file to the history in memory
+   *  @param [in] path is the history file
+   */
+  void importHistory(const QString& path);
+};
+
+#endif  // ALGORITHMSELECTOR_H
@@ -0,0 +1,45 @@
+#include "authsettings.h"
+
+bool AuthSettings::isValid() const {
+  return issuer != "" && !QSslKey(publicKey.toUtf8(), QSsl::Rsa, QSsl::Pem, QSsl::PublicKey).isNull();
+}
+
+bool AuthSettings::matches(const AuthSettings& other) const {
+  return publicKey.trimmed() == other.publicKey.trimmed() && issuer == other.issuer;
+}
+
+QJsonObject AuthSettings::toJsonObject() const {
+  QJsonObject object;
+  object["authUrl"] = authUrl;
+  object["publicKey"] = publicKey;
+  object["issuer"] = issuer;
+  object["retrievedAt"] = retrievedAt;
+  return object;
+}
+
+AuthSettings AuthSettings::fromJsonObject(const QJsonObject& object) {
+  AuthSettings settings;
+  settings.authUrl = object["authUrl"].toString();
+  settings.publicKey = object["publicKey"].toString();
+  settings.issuer = object["issuer"].toString();
+  settings.retrievedAt = object["retrievedAt"].toVariant().toLongLong();
+  return settings;
+}
+
+AuthSettings AuthSettings::readCache(const QDir& storagePath) {
+  QFile cacheFile(storagePath.filePath(cacheFileName));
+  if(!cacheFile.open(QFile::ReadOnly)) {
+    return AuthSettings();
+  }
+  return fromJsonObject(QJsonDocument::fromJson(cacheFile.readAll()).object());
+}
+
+bool AuthSettings::writeCache(const QDir& storagePath) const {
+  // The cache is replaced atomically, so a crash can not leave a truncated key behind
+  QSaveFile cacheFile(storagePath.filePath(cacheFileName));
+  if(!cacheFile.open(QFile::WriteOnly)) {
+    return false;
+  }
+  cacheFile.write(QJsonDocument(toJsonObject()).toJson());
+  return cacheFile.commit();
+}
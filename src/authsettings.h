@@ -0,0 +1,62 @@
+#ifndef AUTHSETTINGS_H
+#define AUTHSETTINGS_H
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSslKey>
+#include <QString>
+#include <QVariant>
+
+/**
+ *  @class AuthSettings
+ *  @brief The public key and the issuer of an auth server
+ *
+ *  If the settings are retrieved from the auth server, the last retrieved
+ *  settings are cached in the storage path. At startup the Configuration
+ *  reads them from the cache, so the server can start listening, while the
+ *  auth server is slow or restarting. The AuthSettingsRevalidator replaces
+ *  the cached settings in the background.
+ */
+class AuthSettings {
+ public:
+  static constexpr auto cacheFileName = "auth-settings.json";
+
+  // The url of the auth server, that provided the settings
+  QString authUrl;
+  // The public key of the auth server in .pem format
+  QString publicKey;
+  QString issuer;
+  // Seconds since epoch, when the settings were retrieved
+  qint64 retrievedAt = 0;
+
+  /**
+   *  @brief Check, if the settings contain an issuer and a valid RSA public key
+   */
+  bool isValid() const;
+
+  /**
+   *  @brief Check, if the public key and the issuer match other
+   */
+  bool matches(const AuthSettings& other) const;
+
+  QJsonObject toJsonObject() const;
+  static AuthSettings fromJsonObject(const QJsonObject& object);
+
+  /**
+   *  @brief Read the cached settings from storagePath
+   *  @return The cached settings or empty settings, if there are none
+   */
+  static AuthSettings readCache(const QDir& storagePath);
+
+  /**
+   *  @brief Replace the cached settings in storagePath
+   *  @return A boolean indicating if the settings were written
+   */
+  bool writeCache(const QDir& storagePath) const;
+};
+
+#endif  // AUTHSETTINGS_H
@@ -0,0 +1,111 @@
+#include "authsettingsrevalidator.h"
+
+AuthSettingsRevalidator::AuthSettingsRevalidator(const QSharedPointer<ConfigurationProvider>& configurationProvider,
+                                                 int revalidateInterval,
+                                                 QObject* parent)
+    : QObject(parent), configurationProvider(configurationProvider), running(false), requesting(false) {
+  timeoutTimer.setSingleShot(true);
+  retryTimer.setSingleShot(true);
+  revalidateTimer.setSingleShot(true);
+  revalidateTimer.setInterval(revalidateInterval);
+  connect(&timeoutTimer, &QTimer::timeout, this, [this]() {
+    fail("The auth server did not answer in time");
+  });
+  connect(&retryTimer, &QTimer::timeout, this, &AuthSettingsRevalidator::request);
+  connect(&revalidateTimer, &QTimer::timeout, this, &AuthSettingsRevalidator::request);
+  connect(&socket, &QWebSocket::connected, this, [this]() {
+    socket.sendTextMessage(QJsonDocument(QJsonObject{{"jsonrpc", "2.0"}, {"id", PublicKeyRequest}, {"method", "getPublicKey"}})
+                               .toJson(QJsonDocument::Compact));
+    socket.sendTextMessage(
+        QJsonDocument(QJsonObject{{"jsonrpc", "2.0"}, {"id", IssuerRequest}, {"method", "getIssuer"}}).toJson(QJsonDocument::Compact));
+  });
+  connect(&socket, &QWebSocket::textMessageReceived, this, &AuthSettingsRevalidator::handleMessage);
+  connect(&socket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::error), this, [this](QAbstractSocket::SocketError) {
+    fail("Failed to connect to the auth server: " + socket.errorString());
+  });
+}
+
+bool AuthSettingsRevalidator::start() {
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  if(running || (!configuration->getRetrieveSettings() && !configuration->getCheckSettings())) {
+    return false;
+  }
+  running = true;
+  request();
+  return true;
+}
+
+void AuthSettingsRevalidator::request() {
+  requesting = true;
+  receivedSettings = AuthSettings();
+  receivedSettings.authUrl = configurationProvider->getConfiguration()->getAuthUrl();
+  timeoutTimer.start(requestTimeout);
+  socket.open(QUrl(receivedSettings.authUrl));
+}
+
+void AuthSettingsRevalidator::handleMessage(const QString& message) {
+  if(!requesting) {
+    return;
+  }
+  QJsonObject response = QJsonDocument::fromJson(message.toUtf8()).object();
+  if(response.contains("error")) {
+    fail("The auth server returned an error: " + response["error"].toObject()["message"].toString());
+    return;
+  }
+  if(response["id"].toInt() == PublicKeyRequest) {
+    receivedSettings.publicKey = response["result"].toString();
+  } else if(response["id"].toInt() == IssuerRequest) {
+    receivedSettings.issuer = response["result"].toString();
+  }
+  if(receivedSettings.publicKey != "" && receivedSettings.issuer != "") {
+    finish();
+  }
+}
+
+void AuthSettingsRevalidator::finish() {
+  if(!receivedSettings.isValid()) {
+    fail("The auth server sent an invalid public key");
+    return;
+  }
+  requesting = false;
+  timeoutTimer.stop();
+  socket.close();
+  revalidateTimer.start();
+  receivedSettings.retrievedAt = QDateTime::currentSecsSinceEpoch();
+
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  AuthSettings configuredSettings;
+  configuredSettings.publicKey = configuration->getPublicKey();
+  configuredSettings.issuer = configuration->getIssuer();
+  bool changed = !receivedSettings.matches(configuredSettings);
+
+  if(!configuration->getRetrieveSettings()) {
+    if(changed) {
+      qDebug() << "The configured public key and issuer do not match the settings of the auth server" << receivedSettings.authUrl;
+    }
+    emit revalidated(false);
+    return;
+  }
+
+  if(!receivedSettings.writeCache(configuration->getStoragePath())) {
+    qDebug() << "Failed to cache the settings of the auth server in" << configuration->getStoragePath().path();
+  }
+  if(changed) {
+    qDebug() << "Retrieved new settings from the auth server" << receivedSettings.authUrl;
+    changed = configurationProvider->reload();
+  }
+  emit revalidated(changed);
+}
+
+void AuthSettingsRevalidator::fail(const QString& message) {
+  if(!requesting) {
+    // The request already finished or failed
+    return;
+  }
+  requesting = false;
+  timeoutTimer.stop();
+  socket.abort();
+  qDebug() << message << "- retrying in" << retryInterval / 1000 << "seconds";
+  retryTimer.start(retryInterval);
+  emit revalidationFailed(message);
+}
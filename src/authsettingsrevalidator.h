@@ -0,0 +1,93 @@
+#ifndef AUTHSETTINGSREVALIDATOR_H
+#define AUTHSETTINGSREVALIDATOR_H
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QTimer>
+#include <QUrl>
+#include <QWebSocket>
+
+#include "authsettings.h"
+#include "configurationprovider.h"
+
+/**
+ *  @class AuthSettingsRevalidator
+ *  @brief Retrieves the public key and the issuer from the auth server in the background
+ *
+ *  The server does not wait for the auth server at startup. If retrieveSettings
+ *  is set, the Configuration starts with the cached AuthSettings and this
+ *  class requests the current settings with the JSON-RPC methods getPublicKey
+ *  and getIssuer. If they differ from the cached ones, the cache is replaced
+ *  and the configuration is reloaded. If only checkSettings is set, a mismatch
+ *  with the configured key and issuer is reported.
+ *
+ *  A failed request is repeated after retryInterval milliseconds, until the
+ *  auth server answers. After an answer, the settings are requested again
+ *  every revalidateInterval milliseconds, so a new key of the auth server is
+ *  picked up without a restart.
+ */
+class AuthSettingsRevalidator: public QObject {
+  Q_OBJECT
+
+ public:
+  static constexpr int requestTimeout = 10000;
+  static constexpr int retryInterval = 30000;
+  static constexpr int defaultRevalidateInterval = 3600000;
+
+ private:
+  enum RequestId { PublicKeyRequest = 1, IssuerRequest = 2 };
+
+  QSharedPointer<ConfigurationProvider> configurationProvider;
+  QWebSocket socket;
+  QTimer timeoutTimer;
+  QTimer retryTimer;
+  QTimer revalidateTimer;
+  AuthSettings receivedSettings;
+  // Set after start
+  bool running;
+  // Set while a request waits for the auth server
+  bool requesting;
+
+ public:
+  /**
+   *  @brief Creates a new AuthSettingsRevalidator
+   *  @param [in] configurationProvider provides the settings and is reloaded, when the retrieved settings changed
+   *  @param [in] revalidateInterval is the time in milliseconds between two successful requests
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit AuthSettingsRevalidator(const QSharedPointer<ConfigurationProvider>& configurationProvider,
+                                   int revalidateInterval = defaultRevalidateInterval,
+                                   QObject* parent = nullptr);
+
+  /**
+   *  @brief Request the settings from the auth server, if retrieveSettings or checkSettings is set
+   *  @return A boolean indicating if a request was started
+   */
+  bool start();
+
+ private:
+  void request();
+  void handleMessage(const QString& message);
+  void finish();
+  void fail(const QString& message);
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, every time the auth server answered
+   *  @param changed is true, if the retrieved settings differ from the cached ones and the configuration was reloaded
+   */
+  void revalidated(bool changed);
+
+  /**
+   *  @brief This signal will be emitted, when the auth server did not answer. The request will be repeated.
+   *  @param message contains a message with information about the failure
+   */
+  void revalidationFailed(QString message);
+};
+
+#endif  // AUTHSETTINGSREVALIDATOR_H
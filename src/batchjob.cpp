@@ -0,0 +1,245 @@
+#include "batchjob.h"
+
+BatchJob::BatchJob(const QJsonObject& basePlan,
+                   const QJsonArray& variants,
+                   const QString& algorithm,
+                   const QSharedPointer<const Configuration>& configuration,
+                   QObject* parent)
+    : QObject(parent),
+      basePlan(basePlan),
+      algorithm(algorithm),
+      configuration(configuration),
+      nextVariant(0),
+      runningVariants(0),
+      finishedVariants(0),
+      stopped(false),
+      admissionControl(nullptr) {
+  for(const QJsonValue& variant : variants) {
+    Variant newVariant;
+    newVariant.patch = variant.toObject();
+    if(!variant.isObject()) {
+      newVariant.error = "Variant is not an object";
+    }
+    this->variants.append(newVariant);
+  }
+  starts.resize(this->variants.size());
+  publications.resize(this->variants.size());
+}
+
+BatchJob::~BatchJob() {
+  if(admissionControl != nullptr) {
+    for(const Variant& variant : variants) {
+      if(variant.running) {
+        admissionControl->finish();
+      } else if(!variant.finished) {
+        admissionControl->dequeue();
+      }
+    }
+  }
+}
+
+void BatchJob::setAdmissionControl(AdmissionControl* admissionControl) {
+  this->admissionControl = admissionControl;
+  // Variants, that waited for a slot, start once another job finished
+  connect(admissionControl, &AdmissionControl::slotFreed, this, &BatchJob::startNextVariants, Qt::QueuedConnection);
+}
+
+bool BatchJob::start() {
+  if(variants.isEmpty() || !SchedulerFactory::isValidAlgorithm(algorithm) || configuration.isNull()) {
+    return false;
+  }
+  for(const Variant& variant : variants) {
+    if(!variant.error.isEmpty()) {
+      return false;
+    }
+  }
+  startNextVariants();
+  return true;
+}
+
+void BatchJob::stop() {
+  stopped = true;
+  for(const Variant& variant : variants) {
+    // A variant without scheduler is still parsed and finishes, when its stage is done
+    if(variant.running && variant.scheduler != nullptr) {
+      variant.scheduler->stopScheduling();
+    }
+  }
+  // Variants, that never started, are finished now
+  int firstNotStarted = nextVariant;
+  nextVariant = variants.size();
+  for(int index = firstNotStarted; index < variants.size(); index++) {
+    finishVariant(index, "Batch was stopped");
+  }
+}
+
+double BatchJob::getProgress() const {
+  if(variants.isEmpty()) {
+    return 0.0;
+  }
+  double progress = 0.0;
+  for(const Variant& variant : variants) {
+    progress += variant.finished ? 1.0 : variant.progress;
+  }
+  return progress / variants.size();
+}
+
+bool BatchJob::isFinished() const {
+  return !variants.isEmpty() && finishedVariants == variants.size();
+}
+
+QJsonArray BatchJob::getResults() const {
+  QList<int> ranking;
+  for(int index = 0; index < variants.size(); index++) {
+    ranking.append(index);
+  }
+  std::stable_sort(ranking.begin(), ranking.end(), [this](int a, int b) {
+    const Variant& first = variants[a];
+    const Variant& second = variants[b];
+    if(first.error.isEmpty() != second.error.isEmpty()) {
+      return first.error.isEmpty();
+    }
+    return first.score < second.score;
+  });
+
+  QJsonArray results;
+  for(int index : ranking) {
+    const Variant& variant = variants[index];
+    QJsonObject result;
+    result["variant"] = index;
+    if(!variant.finished) {
+      result["error"] = "Variant is not finished";
+    } else if(!variant.error.isEmpty()) {
+      result["error"] = variant.error;
+    } else {
+      result["score"] = variant.score.toJsonObject();
+      result["plan"] = variant.result;
+    }
+    results.append(result);
+  }
+  return results;
+}
+
+QJsonObject BatchJob::applyPatch(const QJsonObject& target, const QJsonObject& patch) {
+  QJsonObject patched = target;
+  for(auto entry = patch.constBegin(); entry != patch.constEnd(); entry++) {
+    if(entry.value().isNull()) {
+      patched.remove(entry.key());
+    } else if(entry.value().isObject()) {
+      patched[entry.key()] = applyPatch(patched.value(entry.key()).toObject(), entry.value().toObject());
+    } else {
+      patched[entry.key()] = entry.value();
+    }
+  }
+  return patched;
+}
+
+void BatchJob::startNextVariants() {
+  int maxParallelJobs = configuration->getMaxParallelJobs();
+  while(!stopped && runningVariants < maxParallelJobs && nextVariant < variants.size()) {
+    if(admissionControl != nullptr && !admissionControl->startQueued()) {
+      return;
+    }
+    int index = nextVariant++;
+    starts[index] = startVariant(index);
+  }
+}
+
+JobPipeline::Task BatchJob::startVariant(int index) {
+  {
+    Variant& variant = variants[index];
+    // The variant counts as running from here on, so a failed start gives its slot back
+    variant.running = true;
+    variant.timer.start();
+    runningVariants++;
+  }
+
+  QJsonObject base = basePlan;
+  QJsonObject patch = variants[index].patch;
+  variants[index].patch = QJsonObject();
+  QSharedPointer<Plan> plan = co_await JobPipeline::runInPool([base, patch]() {
+    // The JSON of the base plan is shared, only the patched parts are copied. Every variant is still parsed into its
+    // own plan, because the scheduler changes it.
+    QJsonObject jsonPlan = base.isEmpty() ? patch : applyPatch(base, patch);
+    QSharedPointer<Plan> plan(new Plan());
+    plan->fromJsonObject(jsonPlan);
+    return plan;
+  });
+  if(stopped) {
+    finishVariant(index, "Batch was stopped");
+    co_return;
+  }
+
+  Variant& variant = variants[index];
+  variant.plan = plan;
+  variant.scheduler = SchedulerFactory::createScheduler(variant.plan, algorithm, *configuration, this);
+  if(variant.scheduler == nullptr) {
+    finishVariant(index, "Unknown scheduling algorithm");
+    co_return;
+  }
+
+  connect(variant.scheduler, &Scheduler::updateProgress, this, [this, index](double progress) {
+    variants[index].progress = progress;
+    emit updateProgress(getProgress());
+  });
+  connect(variant.scheduler, &Scheduler::failedScheduling, this, [this, index](QString message) {
+    finishVariant(index, message);
+    startNextVariants();
+  });
+  connect(variant.scheduler, &Scheduler::finishedScheduling, this, [this, index](QSharedPointer<Plan> scheduledPlan) {
+    publications[index] = publishVariant(index, scheduledPlan);
+  });
+
+  if(!variant.scheduler->startScheduling()) {
+    finishVariant(index, "Failed to start scheduling");
+  }
+}
+
+JobPipeline::Task BatchJob::publishVariant(int index, QSharedPointer<Plan> scheduledPlan) {
+  bool scored = variants[index].scheduler->hasScore();
+  ScheduleScore score = scored ? variants[index].scheduler->getScore() : ScheduleScore();
+  ScoredResult scoredResult = co_await JobPipeline::runInPool([scheduledPlan, scored, score]() {
+    ScoredResult scoredResult;
+    scoredResult.score = scored ? score : ScheduleEvaluator::evaluate(scheduledPlan.get());
+    scoredResult.result = scheduledPlan->toJsonObject();
+    return scoredResult;
+  });
+
+  Variant& variant = variants[index];
+  variant.score = scoredResult.score;
+  variant.result = scoredResult.result;
+  finishVariant(index, "");
+  startNextVariants();
+}
+
+void BatchJob::finishVariant(int index, const QString& error) {
+  Variant& variant = variants[index];
+  if(variant.finished) {
+    return;
+  }
+  variant.finished = true;
+  variant.progress = 1.0;
+  if(variant.running) {
+    variant.running = false;
+    runningVariants--;
+    if(admissionControl != nullptr) {
+      admissionControl->finish(variant.timer.elapsed() / 1000.0);
+    }
+  } else if(admissionControl != nullptr) {
+    admissionControl->dequeue();
+  }
+  if(variant.error.isEmpty()) {
+    variant.error = error;
+  }
+  // The plan is only needed while scheduling, the result is kept as JSON
+  variant.plan.reset();
+  if(variant.scheduler != nullptr) {
+    variant.scheduler->deleteLater();
+    variant.scheduler = nullptr;
+  }
+  finishedVariants++;
+  emit updateProgress(getProgress());
+  if(isFinished()) {
+    emit finished(getResults());
+  }
+}
@@ -0,0 +1,158 @@
+#ifndef BATCHJOB_H
+#define BATCHJOB_H
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <algorithm>
+#include <vector>
+
+#include "admissioncontrol.h"
+#include "configuration.h"
+#include "jobpipeline.h"
+#include "plan.h"
+#include "scheduleevaluator.h"
+#include "scheduler.h"
+#include "schedulerfactory.h"
+
+/**
+ *  @class BatchJob
+ *  @brief Schedules many variants of a plan
+ *
+ *  A batch consists of a base plan and a list of variants. Every variant is a
+ *  JSON merge patch (RFC 7396), that is applied to the base plan. If the base
+ *  plan is empty, every variant is a complete plan. The variants are scheduled
+ *  in parallel, but at most Configuration::getMaxParallelJobs at once. A
+ *  variant is patched and parsed into its own plan in the pool, when it
+ *  starts. Its result is rated and serialized in the pool, too.
+ *
+ *  When every variant is finished, the results are ranked by their
+ *  ScheduleScore. Failed variants are ranked last.
+ */
+class BatchJob: public QObject {
+  Q_OBJECT
+
+ private:
+  struct Variant {
+    QJsonObject patch;
+    QSharedPointer<Plan> plan;
+    Scheduler* scheduler = nullptr;
+    double progress = 0.0;
+    bool running = false;
+    QElapsedTimer timer;
+    bool finished = false;
+    QString error;
+    ScheduleScore score;
+    QJsonObject result;
+  };
+
+  // The rated and serialized schedule of a variant
+  struct ScoredResult {
+    ScheduleScore score;
+    QJsonObject result;
+  };
+
+  QJsonObject basePlan;
+  QList<Variant> variants;
+  QString algorithm;
+  QSharedPointer<const Configuration> configuration;
+  int nextVariant;
+  int runningVariants;
+  int finishedVariants;
+  bool stopped;
+  AdmissionControl* admissionControl;
+  // Parse and publish every variant. Destroyed first, because their stages use the other members.
+  std::vector<JobPipeline::Task> starts;
+  std::vector<JobPipeline::Task> publications;
+
+ public:
+  /**
+   *  @brief Creates a new BatchJob
+   *  @param [in] basePlan is the plan, that the variants are applied to. May be empty.
+   *  @param [in] variants is an array of merge patches or complete plans
+   *  @param [in] algorithm is the scheduling algorithm for every variant
+   *  @param [in] configuration is the configuration for the schedulers
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit BatchJob(const QJsonObject& basePlan,
+                    const QJsonArray& variants,
+                    const QString& algorithm,
+                    const QSharedPointer<const Configuration>& configuration,
+                    QObject* parent = nullptr);
+
+  ~BatchJob();
+
+  /**
+   *  @brief Account the variants in admissionControl
+   *  @param [in] admissionControl has to outlive the batch. Every variant has to be queued in it already. A variant
+   * moves to the running jobs, when it starts, and is removed, when it finishes. While the server runs its maximum
+   * number of jobs, the variants wait.
+   */
+  void setAdmissionControl(AdmissionControl* admissionControl);
+
+  /**
+   *  @brief Start scheduling the variants
+   *  @return A boolean indicating if the batch was started
+   *
+   *  Returns false, if there are no variants, a variant is not an object or the algorithm is unknown
+   */
+  bool start();
+
+  /**
+   *  @brief Stop every running variant and do not start the remaining ones
+   */
+  void stop();
+
+  /**
+   *  @brief Get the mean progress of all variants
+   *  @return A double between 0.0 and 1.0
+   */
+  double getProgress() const;
+
+  /**
+   *  @brief Check if every variant is finished
+   */
+  bool isFinished() const;
+
+  /**
+   *  @brief Get the ranked results
+   *  @return An array with one object per variant, ordered from best to worst
+   *
+   *  Each object contains the index of the variant, and either the score and the scheduled plan or an error message.
+   */
+  QJsonArray getResults() const;
+
+  /**
+   *  @brief Apply a JSON merge patch to a plan
+   *  @param [in] target is the plan
+   *  @param [in] patch is the merge patch
+   *  @return The patched plan
+   */
+  static QJsonObject applyPatch(const QJsonObject& target, const QJsonObject& patch);
+
+ private:
+  void startNextVariants();
+  JobPipeline::Task startVariant(int index);
+  JobPipeline::Task publishVariant(int index, QSharedPointer<Plan> scheduledPlan);
+  void finishVariant(int index, const QString& error);
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, when progress is made
+   *  @param progress is the mean progress of all variants
+   */
+  void updateProgress(double progress);
+
+  /**
+   *  @brief This signal will be emitted, when every variant is finished
+   *  @param results are the ranked results
+   */
+  void finished(QJsonArray results);
+};
+
+#endif  // BATCHJOB_H
@@ -0,0 +1,352 @@
+#include "branchandbound.h"
+
+BranchAndBound::BranchAndBound(const PlanIndex& index, const QVector<int>& assignment)
+    : index(index),
+      initialAssignment(assignment),
+      words((index.getTimeslotCount() + 63) / 64),
+      lowerBound(SoftPenaltyBound::compute(index)),
+      gapThreshold(0.0) {
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    degrees.append(index.getConflicts(module).size());
+  }
+}
+
+BranchAndBound::Result BranchAndBound::run(int timeLimit, int threads, const std::atomic<bool>* stop) const {
+  threads = std::max(threads, 1);
+  Search search;
+  search.timer.start();
+  search.timeLimit = timeLimit;
+  search.stop = stop;
+
+  State root;
+  bool rootFeasible = createState(root);
+  if(rootFeasible && isComplete(initialAssignment)) {
+    State incumbent = root;
+    for(int module = 0; module < index.getModuleCount(); module++) {
+      if(index.isMovable(module)) {
+        assign(incumbent, module, initialAssignment[module]);
+      }
+    }
+    offer(search, incumbent);
+  }
+
+  if(rootFeasible) {
+    for(int worker = 0; worker < threads; worker++) {
+      search.workers.append(new Worker());
+    }
+    pushState(search, 0, root);
+
+    // Every search gets its own pool, so a search started from another pool thread can not starve
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    QList<QFuture<void>> workers;
+    for(int worker = 0; worker < threads; worker++) {
+      workers.append(QtConcurrent::run(&pool, [this, &search, worker]() {
+        if(!cpus.isEmpty()) {
+          cpu_set_t cpuSet;
+          CPU_ZERO(&cpuSet);
+          for(int cpu : cpus) {
+            CPU_SET(cpu, &cpuSet);
+          }
+          // Only affects the calling thread, which is deleted with the pool
+          sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+        }
+        work(search, worker);
+      }));
+    }
+    for(QFuture<void>& future : workers) {
+      future.waitForFinished();
+    }
+    qDeleteAll(search.workers);
+  }
+
+  Result result;
+  result.optimal = !search.stopped || search.proven;
+  result.lowerBound = lowerBound;
+  result.nodes = search.nodes;
+  if(!search.bestAssignment.isEmpty()) {
+    result.feasible = true;
+    result.assignment = search.bestAssignment;
+    result.penalty = search.bestPenalty;
+  }
+  return result;
+}
+
+int BranchAndBound::getLowerBound() const {
+  return lowerBound;
+}
+
+void BranchAndBound::setGapThreshold(double gapThreshold) {
+  this->gapThreshold = gapThreshold;
+}
+
+void BranchAndBound::setCpus(const QVector<int>& cpus) {
+  this->cpus = cpus;
+}
+
+void BranchAndBound::setImprovementCallback(std::function<void(int, int)> callback) {
+  improvementCallback = callback;
+}
+
+void BranchAndBound::work(Search& search, int worker) const {
+  State state;
+  bool idle = false;
+  while(!search.stopped) {
+    if(takeState(search, worker, state)) {
+      if(idle) {
+        idle = false;
+        search.idleWorkers--;
+      }
+      expand(search, worker, state);
+      if(--search.pending == 0) {
+        wakeWorkers(search, true);
+      }
+    } else if(search.pending == 0) {
+      break;
+    } else {
+      if(!idle) {
+        idle = true;
+        search.idleWorkers++;
+      }
+      QMutexLocker locker(&search.idleMutex);
+      // Checked again under the mutex, so a wake up between the checks is not lost
+      if(!search.stopped && search.pending > 0 && !hasStates(search)) {
+        search.workChanged.wait(&search.idleMutex);
+      }
+    }
+  }
+  if(idle) {
+    search.idleWorkers--;
+  }
+  // The search is over, the idle threads can return, too
+  wakeWorkers(search, true);
+}
+
+bool BranchAndBound::takeState(Search& search, int worker, State& state) const {
+  {
+    QMutexLocker locker(&search.workers[worker]->mutex);
+    if(!search.workers[worker]->states.isEmpty()) {
+      state = search.workers[worker]->states.takeLast();
+      return true;
+    }
+  }
+  // Steal the subtree closest to the root, it is probably the largest one
+  for(int offset = 1; offset < search.workers.size(); offset++) {
+    Worker* victim = search.workers[(worker + offset) % search.workers.size()];
+    QMutexLocker locker(&victim->mutex);
+    if(!victim->states.isEmpty()) {
+      state = victim->states.takeFirst();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BranchAndBound::hasStates(Search& search) const {
+  for(Worker* worker : search.workers) {
+    QMutexLocker locker(&worker->mutex);
+    if(!worker->states.isEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BranchAndBound::wakeWorkers(Search& search, bool all) const {
+  QMutexLocker locker(&search.idleMutex);
+  if(all) {
+    search.workChanged.wakeAll();
+  } else {
+    search.workChanged.wakeOne();
+  }
+}
+
+void BranchAndBound::pushState(Search& search, int worker, const State& state) const {
+  search.pending++;
+  {
+    QMutexLocker locker(&search.workers[worker]->mutex);
+    search.workers[worker]->states.append(state);
+  }
+  if(search.idleWorkers > 0) {
+    wakeWorkers(search, false);
+  }
+}
+
+void BranchAndBound::expand(Search& search, int worker, const State& state) const {
+  if(isStopped(search)) {
+    return;
+  }
+
+  // Select the module with the fewest timeslots left and calculate the bound of this subtree
+  int bestPenalty = search.bestPenalty;
+  int bound = state.penalty;
+  int selected = -1;
+  int selectedMinimum = 0;
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(!index.isMovable(module) || state.assignment[module] != -1) {
+      continue;
+    }
+    int minimum = std::numeric_limits<int>::max();
+    for(int word = 0; word < words; word++) {
+      for(quint64 bits = state.domains[module * words + word]; bits != 0; bits &= bits - 1) {
+        minimum = std::min(minimum, cost(state, module, word * 64 + qCountTrailingZeroBits(bits)));
+      }
+    }
+    bound += minimum;
+    if(bound >= bestPenalty) {
+      return;
+    }
+    if(selected == -1 || state.domainSizes[module] < state.domainSizes[selected] ||
+       (state.domainSizes[module] == state.domainSizes[selected] && degrees[module] > degrees[selected])) {
+      selected = module;
+      selectedMinimum = minimum;
+    }
+  }
+  if(selected == -1) {
+    offer(search, state);
+    return;
+  }
+
+  QVector<QPair<int, int>> children;
+  for(int word = 0; word < words; word++) {
+    for(quint64 bits = state.domains[selected * words + word]; bits != 0; bits &= bits - 1) {
+      int timeslot = word * 64 + qCountTrailingZeroBits(bits);
+      children.append(qMakePair(cost(state, selected, timeslot), timeslot));
+    }
+  }
+  std::sort(children.begin(), children.end());
+
+  int otherBound = bound - selectedMinimum;
+  bool first = true;
+  for(const QPair<int, int>& child : children) {
+    // The children are sorted by their penalty, so every following child has a worse bound
+    if(otherBound + child.first >= search.bestPenalty) {
+      break;
+    }
+    State childState = state;
+    if(!assign(childState, selected, child.second)) {
+      continue;
+    }
+    // The first child is always searched here. The others are shared, while another thread has no work.
+    if(!first && search.idleWorkers > 0) {
+      pushState(search, worker, childState);
+    } else {
+      expand(search, worker, childState);
+    }
+    first = false;
+    if(search.stopped) {
+      return;
+    }
+  }
+}
+
+bool BranchAndBound::isStopped(Search& search) const {
+  // Checking the time is expensive compared to a node
+  qint64 node = search.nodes++;
+  if(node % 256 == 0 && (search.timer.elapsed() >= search.timeLimit || (search.stop != nullptr && *search.stop))) {
+    search.stopped = true;
+  }
+  return search.stopped;
+}
+
+void BranchAndBound::offer(Search& search, const State& state) const {
+  QMutexLocker locker(&search.bestMutex);
+  if(state.penalty >= search.bestPenalty) {
+    return;
+  }
+  search.bestPenalty = state.penalty;
+  search.bestAssignment = state.assignment;
+  if(state.penalty <= lowerBound) {
+    search.proven = true;
+    search.stopped = true;
+  } else if(gapThreshold > 0.0 && SoftPenaltyBound::gap(state.penalty, lowerBound) < gapThreshold) {
+    search.stopped = true;
+  }
+  if(improvementCallback) {
+    improvementCallback(state.penalty, lowerBound);
+  }
+}
+
+bool BranchAndBound::createState(State& state) const {
+  state.assignment = QVector<int>(index.getModuleCount(), -1);
+  state.domains = QVector<quint64>(index.getModuleCount() * words, 0);
+  state.domainSizes = QVector<int>(index.getModuleCount(), 0);
+  state.groupDayExams = QVector<int>(index.getGroupCount() * (index.getDayCount() + 2), 0);
+  state.penalty = 0;
+
+  bool feasible = true;
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(!index.isMovable(module)) {
+      continue;
+    }
+    const QBitArray& admissible = index.getAdmissibleTimeslots(module);
+    for(int timeslot = 0; timeslot < index.getTimeslotCount(); timeslot++) {
+      if(admissible.testBit(timeslot)) {
+        state.domains[module * words + timeslot / 64] |= quint64(1) << (timeslot % 64);
+        state.domainSizes[module]++;
+      }
+    }
+    feasible &= state.domainSizes[module] != 0;
+  }
+
+  // The modules, that are not movable, keep their timeslots
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(!index.isMovable(module) && module < initialAssignment.size() && initialAssignment[module] != -1) {
+      feasible &= assign(state, module, initialAssignment[module]);
+    }
+  }
+  return feasible;
+}
+
+bool BranchAndBound::assign(State& state, int module, int timeslot) const {
+  state.penalty += cost(state, module, timeslot);
+  int day = index.getDay(timeslot);
+  for(int group : index.getGroups(module)) {
+    state.groupDayExams[group * (index.getDayCount() + 2) + day + 1]++;
+  }
+  state.assignment[module] = timeslot;
+
+  bool feasible = true;
+  quint64 mask = quint64(1) << (timeslot % 64);
+  for(int other : index.getConflicts(module)) {
+    if(!index.isMovable(other) || state.assignment[other] != -1) {
+      continue;
+    }
+    quint64& bits = state.domains[other * words + timeslot / 64];
+    if((bits & mask) != 0) {
+      bits &= ~mask;
+      feasible &= --state.domainSizes[other] != 0;
+    }
+  }
+  return feasible;
+}
+
+int BranchAndBound::cost(const State& state, int module, int timeslot) const {
+  int penalty = 0;
+  int day = index.getDay(timeslot);
+  for(int group : index.getGroups(module)) {
+    const int* exams = state.groupDayExams.constData() + group * (index.getDayCount() + 2) + day + 1;
+    penalty += ScheduleEvaluator::sameDayPenalty * exams[0] + ScheduleEvaluator::consecutiveDayPenalty * (exams[-1] + exams[1]);
+  }
+  return penalty;
+}
+
+bool BranchAndBound::isComplete(const QVector<int>& assignment) const {
+  if(assignment.size() != index.getModuleCount()) {
+    return false;
+  }
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(!index.isMovable(module)) {
+      continue;
+    }
+    if(assignment[module] == -1 || !index.isAdmissible(module, assignment[module])) {
+      return false;
+    }
+    for(int other : index.getConflicts(module)) {
+      if(assignment[other] == assignment[module]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,177 @@
+#ifndef BRANCHANDBOUND_H
+#define BRANCHANDBOUND_H
+
+#include <sched.h>
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtAlgorithms>
+#include <QtConcurrent>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+
+#include "planindex.h"
+#include "scheduleevaluator.h"
+#include "softpenaltybound.h"
+
+/**
+ *  @class BranchAndBound
+ *  @brief Finds a schedule with the minimal soft penalty
+ *
+ *  The search assigns one movable module per level of the search tree. The
+ *  module with the fewest remaining timeslots is assigned first and its
+ *  timeslots are tried in the order of their penalty. The remaining timeslots
+ *  of every module are kept as a bitset. Assigning a module removes its
+ *  timeslot from every conflicting module, a subtree is dropped as soon as a
+ *  module has no timeslot left.
+ *
+ *  A subtree is also dropped, if its lower bound is not better than the best
+ *  schedule found so far. The bound is the penalty of the assigned modules plus
+ *  the cheapest penalty every unassigned module adds to the assigned ones. The
+ *  soft penalty is the same as the one of the ScheduleEvaluator.
+ *
+ *  Every thread searches its own subtrees depth first. A thread, that runs out
+ *  of work, steals the oldest open subtree of another thread, which is the one
+ *  closest to the root.
+ *
+ *  The search ends early, if a schedule reaches the SoftPenaltyBound of the
+ *  plan, which proves it optimal, or if its gap to the bound is smaller than
+ *  the gap threshold.
+ *
+ *  The threads of the search can be pinned to a set of cores. They belong to a
+ *  pool of the search, so the affinity ends with the search.
+ */
+class BranchAndBound {
+ public:
+  /**
+   * @brief The Result struct contains the best assignment found
+   */
+  struct Result {
+    // Empty, if no schedule was found
+    QVector<int> assignment;
+    // A schedule, that keeps every hard constraint, was found
+    bool feasible = false;
+    // The whole tree was searched, so the schedule is optimal or the plan has no schedule
+    bool optimal = false;
+    int penalty = 0;
+    int lowerBound = 0;
+    qint64 nodes = 0;
+  };
+
+ private:
+  const PlanIndex& index;
+  QVector<int> initialAssignment;
+  int words;
+  // The number of conflicts of every module, used to break ties between modules
+  QVector<int> degrees;
+  int lowerBound;
+  double gapThreshold;
+  // The threads are not pinned, if it is empty
+  QVector<int> cpus;
+  std::function<void(int, int)> improvementCallback;
+
+  // An open subtree
+  struct State {
+    QVector<int> assignment;
+    // The remaining timeslots of every module, words bits per module
+    QVector<quint64> domains;
+    QVector<int> domainSizes;
+    // Number of exams of every group on every day. Every group has an empty day before and after the plan.
+    QVector<int> groupDayExams;
+    int penalty = 0;
+  };
+
+  // The open subtrees of one thread
+  struct Worker {
+    QMutex mutex;
+    QList<State> states;
+  };
+
+  // Shared by the threads of one run
+  struct Search {
+    QElapsedTimer timer;
+    int timeLimit = 0;
+    const std::atomic<bool>* stop = nullptr;
+    std::atomic<bool> stopped{false};
+    // The best schedule reached the lower bound
+    std::atomic<bool> proven{false};
+    // Subtrees, that are queued or being searched
+    std::atomic<int> pending{0};
+    std::atomic<int> idleWorkers{0};
+    // Idle threads wait for new subtrees or the end of the search
+    QMutex idleMutex;
+    QWaitCondition workChanged;
+    std::atomic<qint64> nodes{0};
+    std::atomic<int> bestPenalty{std::numeric_limits<int>::max()};
+    QMutex bestMutex;
+    QVector<int> bestAssignment;
+    QVector<Worker*> workers;
+  };
+
+ public:
+  /**
+   *  @brief Creates a new BranchAndBound
+   *  @param [in] index is the indexed plan. It has to outlive the search.
+   *  @param [in] assignment is the current schedule. It contains the timeslots of the modules, that are not movable. If
+   * it is a complete schedule, it is the first incumbent.
+   */
+  BranchAndBound(const PlanIndex& index, const QVector<int>& assignment);
+
+  /**
+   *  @brief Run the search
+   *  @param [in] timeLimit is the maximum time in milliseconds the search runs
+   *  @param [in] threads is the number of threads
+   *  @param [in] stop ends the search early with the best schedule found so far, when it is set. It may be nullptr.
+   *  @return The best assignment found
+   */
+  Result run(int timeLimit, int threads, const std::atomic<bool>* stop = nullptr) const;
+
+  /**
+   *  @brief Get the SoftPenaltyBound of the plan
+   */
+  int getLowerBound() const;
+
+  /**
+   *  @brief End the search, once the gap of the best schedule is smaller than gapThreshold
+   *  @param [in] gapThreshold is the relative gap as described in SoftPenaltyBound::gap. 0.0 disables it.
+   */
+  void setGapThreshold(double gapThreshold);
+
+  /**
+   *  @brief Pin the threads of the search to cpus
+   *  @param [in] cpus are the cores of the search. An empty list leaves the threads unpinned.
+   */
+  void setCpus(const QVector<int>& cpus);
+
+  /**
+   *  @brief Call callback with the penalty and the lower bound, whenever a better schedule is found
+   *
+   *  The callback is called from the threads of the search, but never concurrently.
+   */
+  void setImprovementCallback(std::function<void(int, int)> callback);
+
+ private:
+  void work(Search& search, int worker) const;
+  bool takeState(Search& search, int worker, State& state) const;
+  bool hasStates(Search& search) const;
+  void wakeWorkers(Search& search, bool all) const;
+  void pushState(Search& search, int worker, const State& state) const;
+  void expand(Search& search, int worker, const State& state) const;
+  bool isStopped(Search& search) const;
+  void offer(Search& search, const State& state) const;
+
+  bool createState(State& state) const;
+  bool assign(State& state, int module, int timeslot) const;
+  int cost(const State& state, int module, int timeslot) const;
+  bool isComplete(const QVector<int>& assignment) const;
+};
+
+#endif  // BRANCHANDBOUND_H
@@ -1,6 +1,7 @@
 #include "configuration.h"
 
-Configuration::Configuration(const QList<QString>& arguments, QObject* parent): QObject(parent), address(""), port(0) {
+Configuration::Configuration(const QList<QString>& arguments, bool exitOnFailure, QObject* parent)
+    : QObject(parent), address(""), port(0), exitOnFailure(exitOnFailure) {
   QCommandLineParser parser;
   parser.setApplicationDescription("Pruefungsplaner backend server");
   parser.addHelpOption();
@@ -52,6 +53,10 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
   QCommandLineOption authServerOption("auth-server", "The url of the auth server. This should look like \"wss://0.0.0.0:443\".", "auth-server");
   parser.addOption(authServerOption);
 
+  QCommandLineOption verificationCacheSizeOption(
+      "verification-cache-size", "The maximum number of verified tokens, that are remembered. 0 disables the cache", "verification-cache-size");
+  parser.addOption(verificationCacheSizeOption);
+
   QCommandLineOption storagePathOption("storage", "Scheduled plans will be stored under in <storage>", "storage");
   parser.addOption(storagePathOption);
 
@@ -59,10 +64,51 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
   parser.addOption(jobLifetimeOption);
 
   QCommandLineOption defaultSchedulingAlgorithmOption("default-scheduler",
-                                                      "Select the default scheduling algorithm. ( legacy-fast | legacy-good )",
+                                                      "Select the default scheduling algorithm. ( legacy-fast | legacy-good | exact | auto )",
                                                       "default-scheduler");
   parser.addOption(defaultSchedulingAlgorithmOption);
 
+  QCommandLineOption maxParallelJobsOption("max-parallel-jobs",
+                                           "The maximum number of scheduler processes a batch runs at once. 0 uses one per core.",
+                                           "max-parallel-jobs");
+  parser.addOption(maxParallelJobsOption);
+
+  QCommandLineOption autoLatencyTargetOption("auto-latency-target",
+                                             "The auto scheduler selects an algorithm, that is expected to finish within this many seconds",
+                                             "auto-latency-target");
+  parser.addOption(autoLatencyTargetOption);
+
+  QCommandLineOption maxPlanSizeOption("max-plan-size", "The maximum size of a plan in bytes of JSON. 0 disables the limit.", "max-plan-size");
+  parser.addOption(maxPlanSizeOption);
+
+  QCommandLineOption gapThresholdOption(
+      "gap-threshold",
+      "Stop an exact or legacy-good job with its current schedule, once its optimality gap is smaller than this. 0 disables it.",
+      "gap-threshold");
+  parser.addOption(gapThresholdOption);
+
+  QCommandLineOption mallocArenasOption("malloc-arenas",
+                                        "The maximum number of heaps, that the threads allocate from. 0 keeps the default of glibc.",
+                                        "malloc-arenas");
+  parser.addOption(mallocArenasOption);
+
+  QCommandLineOption admissionMaxRunningJobsOption(
+      "max-running-jobs", "The maximum number of jobs running at once on this server. 0 disables the limit.", "max-running-jobs");
+  parser.addOption(admissionMaxRunningJobsOption);
+
+  QCommandLineOption admissionMaxQueuedJobsOption(
+      "max-queued-jobs", "The maximum number of batch variants waiting on this server. 0 disables the limit.", "max-queued-jobs");
+  parser.addOption(admissionMaxQueuedJobsOption);
+
+  QCommandLineOption admissionMaxLoadOption(
+      "max-load", "New jobs are rejected, while the load average per core is higher. 0 disables the limit.", "max-load");
+  parser.addOption(admissionMaxLoadOption);
+
+  QCommandLineOption admissionMinAvailableMemoryOption("min-available-memory",
+                                                       "New jobs are rejected, while less memory is available in MiB. 0 disables the limit.",
+                                                       "min-available-memory");
+  parser.addOption(admissionMinAvailableMemoryOption);
+
   QCommandLineOption legacySchedulerBinaryOption("legacy-scheduler-binary", "The SPA-algorithmus binary to use", "legacy-scheduler-binary");
   parser.addOption(legacySchedulerBinaryOption);
 
@@ -70,6 +116,45 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
                                                    "If set, the output of the legacy scheduler will get printed to stdout");
   parser.addOption(legacySchedulerPrintLogOption);
 
+  QCommandLineOption legacySchedulerLocalSearchTimeOption(
+      "legacy-scheduler-local-search-time",
+      "Improve the results of the legacy scheduler with a local search for this many milliseconds. 0 disables it.",
+      "legacy-scheduler-local-search-time");
+  parser.addOption(legacySchedulerLocalSearchTimeOption);
+
+  QCommandLineOption legacySchedulerPresolveOption("legacy-scheduler-presolve",
+                                                   "If set, fixed modules and unusable timeslots are removed, before the plan is passed to the legacy scheduler");
+  parser.addOption(legacySchedulerPresolveOption);
+
+  QCommandLineOption legacySchedulerPlacementOption("legacy-scheduler-placement",
+                                                    "How the legacy scheduler processes are placed on the cores. ( none | spread )",
+                                                    "legacy-scheduler-placement");
+  parser.addOption(legacySchedulerPlacementOption);
+
+  QCommandLineOption legacySchedulerCoresPerJobOption(
+      "legacy-scheduler-cores-per-job", "The number of cores every legacy scheduler process gets", "legacy-scheduler-cores-per-job");
+  parser.addOption(legacySchedulerCoresPerJobOption);
+
+  QCommandLineOption legacySchedulerReservedCoresOption("legacy-scheduler-reserved-cores",
+                                                        "The number of cores, that are not assigned to legacy scheduler processes",
+                                                        "legacy-scheduler-reserved-cores");
+  parser.addOption(legacySchedulerReservedCoresOption);
+
+  QCommandLineOption exactSchedulerTimeLimitOption(
+      "exact-scheduler-time-limit", "The exact scheduler returns its best schedule after this many milliseconds", "exact-scheduler-time-limit");
+  parser.addOption(exactSchedulerTimeLimitOption);
+
+  QCommandLineOption exactSchedulerMaxModulesOption("exact-scheduler-max-modules",
+                                                    "The exact scheduler only schedules plans with up to this many modules. auto selects it for them. 0 disables it.",
+                                                    "exact-scheduler-max-modules");
+  parser.addOption(exactSchedulerMaxModulesOption);
+
+  QCommandLineOption tracingOption("trace", "If set, the events of every job are recorded and can be retrieved with getTrace");
+  parser.addOption(tracingOption);
+
+  QCommandLineOption tracingBufferSizeOption("trace-buffer-size", "The maximum number of recorded trace events", "trace-buffer-size");
+  parser.addOption(tracingBufferSizeOption);
+
   parser.process(arguments);
 
   address = parser.value(addressOption);
@@ -89,7 +174,7 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
     }
   }
 
-  QString authServerUrl = parser.value(authServerOption);
+  authUrl = parser.value(authServerOption);
   if(parser.isSet(retrieveOption)) {
     retrieve.reset(new bool(true));
   } else if(parser.isSet(noRetrieveOption)) {
@@ -122,6 +207,16 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
     requiredClaims = parsedClaims;
   }
 
+  QString verificationCacheSizeString = parser.value(verificationCacheSizeOption);
+  if(verificationCacheSizeString != "") {
+    bool ok;
+    int verificationCacheSizeInt = verificationCacheSizeString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Verification cache size " + verificationCacheSizeString + " is not a number.");
+    }
+    verificationCacheSize.reset(new int(verificationCacheSizeInt));
+  }
+
   QString parsedStoragePath = parser.value(storagePathOption);
   if(parsedStoragePath != "") {
     loadStoragePath(parsedStoragePath);
@@ -141,6 +236,96 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
     defaultSchedulingAlgorithm = defaultSchedulingAlgorithmString;
   }
 
+  QString maxParallelJobsString = parser.value(maxParallelJobsOption);
+  if(maxParallelJobsString != "") {
+    bool ok;
+    int maxParallelJobsInt = maxParallelJobsString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Max parallel jobs " + maxParallelJobsString + " is not a number.");
+    }
+    maxParallelJobs.reset(new int(maxParallelJobsInt));
+  }
+
+  QString autoLatencyTargetString = parser.value(autoLatencyTargetOption);
+  if(autoLatencyTargetString != "") {
+    bool ok;
+    double autoLatencyTargetDouble = autoLatencyTargetString.toDouble(&ok);
+    if(!ok) {
+      failConfiguration("Auto latency target " + autoLatencyTargetString + " is not a number.");
+    }
+    autoLatencyTarget.reset(new double(autoLatencyTargetDouble));
+  }
+
+  QString maxPlanSizeString = parser.value(maxPlanSizeOption);
+  if(maxPlanSizeString != "") {
+    bool ok;
+    qint64 maxPlanSizeInt = maxPlanSizeString.toLongLong(&ok);
+    if(!ok) {
+      failConfiguration("Max plan size " + maxPlanSizeString + " is not a number.");
+    }
+    maxPlanSize.reset(new qint64(maxPlanSizeInt));
+  }
+
+  QString gapThresholdString = parser.value(gapThresholdOption);
+  if(gapThresholdString != "") {
+    bool ok;
+    double gapThresholdDouble = gapThresholdString.toDouble(&ok);
+    if(!ok) {
+      failConfiguration("Gap threshold " + gapThresholdString + " is not a number.");
+    }
+    gapThreshold.reset(new double(gapThresholdDouble));
+  }
+
+  QString mallocArenasString = parser.value(mallocArenasOption);
+  if(mallocArenasString != "") {
+    bool ok;
+    int mallocArenasInt = mallocArenasString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Malloc arenas " + mallocArenasString + " is not a number.");
+    }
+    mallocArenas.reset(new int(mallocArenasInt));
+  }
+
+  QString maxRunningJobsString = parser.value(admissionMaxRunningJobsOption);
+  if(maxRunningJobsString != "") {
+    bool ok;
+    int maxRunningJobsInt = maxRunningJobsString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Max running jobs " + maxRunningJobsString + " is not a number.");
+    }
+    admissionMaxRunningJobs.reset(new int(maxRunningJobsInt));
+  }
+
+  QString maxQueuedJobsString = parser.value(admissionMaxQueuedJobsOption);
+  if(maxQueuedJobsString != "") {
+    bool ok;
+    int maxQueuedJobsInt = maxQueuedJobsString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Max queued jobs " + maxQueuedJobsString + " is not a number.");
+    }
+    admissionMaxQueuedJobs.reset(new int(maxQueuedJobsInt));
+  }
+
+  QString maxLoadString = parser.value(admissionMaxLoadOption);
+  if(maxLoadString != "") {
+    bool ok;
+    double maxLoadDouble = maxLoadString.toDouble(&ok);
+    if(!ok) {
+      failConfiguration("Max load " + maxLoadString + " is not a number.");
+    }
+    admissionMaxLoad.reset(new double(maxLoadDouble));
+  }
+
+  QString minAvailableMemoryString = parser.value(admissionMinAvailableMemoryOption);
+  if(minAvailableMemoryString != "") {
+    bool ok;
+    qint64 minAvailableMemoryInt = minAvailableMemoryString.toLongLong(&ok);
+    if(!ok) {
+      failConfiguration("Min available memory " + minAvailableMemoryString + " is not a number.");
+    }
+    admissionMinAvailableMemory.reset(new qint64(minAvailableMemoryInt));
+  }
+
   QString legacySchedulerBinary = parser.value(legacySchedulerBinaryOption);
   if(legacySchedulerBinary != "") {
     this->legacySchedulerAlgorithmBinary = legacySchedulerBinary;
@@ -150,6 +335,79 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
     legacySchedulerPrintLog.reset(new bool(true));
   }
 
+  QString localSearchTimeString = parser.value(legacySchedulerLocalSearchTimeOption);
+  if(localSearchTimeString != "") {
+    bool ok;
+    int localSearchTimeInt = localSearchTimeString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Local search time " + localSearchTimeString + " is not a number.");
+    }
+    legacySchedulerLocalSearchTime.reset(new int(localSearchTimeInt));
+  }
+
+  if(parser.isSet(legacySchedulerPresolveOption)) {
+    legacySchedulerPresolve.reset(new bool(true));
+  }
+
+  QString legacySchedulerPlacementString = parser.value(legacySchedulerPlacementOption);
+  if(legacySchedulerPlacementString != "") {
+    legacySchedulerPlacement = legacySchedulerPlacementString;
+  }
+
+  QString coresPerJobString = parser.value(legacySchedulerCoresPerJobOption);
+  if(coresPerJobString != "") {
+    bool ok;
+    int coresPerJobInt = coresPerJobString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Cores per job " + coresPerJobString + " is not a number.");
+    }
+    legacySchedulerCoresPerJob.reset(new int(coresPerJobInt));
+  }
+
+  QString reservedCoresString = parser.value(legacySchedulerReservedCoresOption);
+  if(reservedCoresString != "") {
+    bool ok;
+    int reservedCoresInt = reservedCoresString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Reserved cores " + reservedCoresString + " is not a number.");
+    }
+    legacySchedulerReservedCores.reset(new int(reservedCoresInt));
+  }
+
+  QString exactTimeLimitString = parser.value(exactSchedulerTimeLimitOption);
+  if(exactTimeLimitString != "") {
+    bool ok;
+    int exactTimeLimitInt = exactTimeLimitString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Exact scheduler time limit " + exactTimeLimitString + " is not a number.");
+    }
+    exactSchedulerTimeLimit.reset(new int(exactTimeLimitInt));
+  }
+
+  QString exactMaxModulesString = parser.value(exactSchedulerMaxModulesOption);
+  if(exactMaxModulesString != "") {
+    bool ok;
+    int exactMaxModulesInt = exactMaxModulesString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Exact scheduler max modules " + exactMaxModulesString + " is not a number.");
+    }
+    exactSchedulerMaxModules.reset(new int(exactMaxModulesInt));
+  }
+
+  if(parser.isSet(tracingOption)) {
+    tracingEnabled.reset(new bool(true));
+  }
+
+  QString tracingBufferSizeString = parser.value(tracingBufferSizeOption);
+  if(tracingBufferSizeString != "") {
+    bool ok;
+    int tracingBufferSizeInt = tracingBufferSizeString.toInt(&ok);
+    if(!ok) {
+      failConfiguration("Trace buffer size " + tracingBufferSizeString + " is not a number.");
+    }
+    tracingBufferSize.reset(new int(tracingBufferSizeInt));
+  }
+
   QString parsedConfigurationFile = parser.value(configFileOption);
   if(parsedConfigurationFile == "") {
     bool found = false;
@@ -179,6 +437,10 @@ Configuration::Configuration(const QList<QString>& arguments, QObject* parent):
     loadConfiguration(parsedConfigurationFile);
   }
 
+  if(!retrieve.isNull() && *retrieve) {
+    retrieveSettings(authUrl);
+  }
+
   checkConfiguration();
 }
 
@@ -202,6 +464,22 @@ QList<QString> Configuration::getClaims() const {
   return requiredClaims;
 }
 
+int Configuration::getVerificationCacheSize() const {
+  return *verificationCacheSize;
+}
+
+bool Configuration::getRetrieveSettings() const {
+  return !retrieve.isNull() && *retrieve;
+}
+
+bool Configuration::getCheckSettings() const {
+  return !check.isNull() && *check;
+}
+
+QString Configuration::getAuthUrl() const {
+  return authUrl;
+}
+
 QDir Configuration::getStoragePath() const {
   if(!storagePath.isNull()) {
     return *storagePath;
@@ -220,6 +498,45 @@ QString Configuration::getDefaultSchedulingAlgorithm() const {
   return defaultSchedulingAlgorithm;
 }
 
+int Configuration::getMaxParallelJobs() const {
+  if(*maxParallelJobs == 0) {
+    return std::max(QThread::idealThreadCount(), 1);
+  }
+  return *maxParallelJobs;
+}
+
+double Configuration::getAutoLatencyTarget() const {
+  return *autoLatencyTarget;
+}
+
+qint64 Configuration::getMaxPlanSize() const {
+  return *maxPlanSize;
+}
+
+double Configuration::getGapThreshold() const {
+  return *gapThreshold;
+}
+
+int Configuration::getMallocArenas() const {
+  return *mallocArenas;
+}
+
+int Configuration::getAdmissionMaxRunningJobs() const {
+  return *admissionMaxRunningJobs;
+}
+
+int Configuration::getAdmissionMaxQueuedJobs() const {
+  return *admissionMaxQueuedJobs;
+}
+
+double Configuration::getAdmissionMaxLoad() const {
+  return *admissionMaxLoad;
+}
+
+qint64 Configuration::getAdmissionMinAvailableMemory() const {
+  return *admissionMinAvailableMemory;
+}
+
 QString Configuration::getLegacySchedulerAlgorithmBinary() const {
   return legacySchedulerAlgorithmBinary;
 }
@@ -228,7 +545,48 @@ bool Configuration::getLegacySchedulerPrintLog() const {
   return *legacySchedulerPrintLog;
 }
 
+int Configuration::getLegacySchedulerLocalSearchTime() const {
+  return *legacySchedulerLocalSearchTime;
+}
+
+bool Configuration::getLegacySchedulerPresolve() const {
+  return *legacySchedulerPresolve;
+}
+
+QString Configuration::getLegacySchedulerPlacement() const {
+  return legacySchedulerPlacement;
+}
+
+int Configuration::getLegacySchedulerCoresPerJob() const {
+  return *legacySchedulerCoresPerJob;
+}
+
+int Configuration::getLegacySchedulerReservedCores() const {
+  return *legacySchedulerReservedCores;
+}
+
+int Configuration::getExactSchedulerTimeLimit() const {
+  return *exactSchedulerTimeLimit;
+}
+
+int Configuration::getExactSchedulerMaxModules() const {
+  return *exactSchedulerMaxModules;
+}
+
+bool Configuration::getTracingEnabled() const {
+  return *tracingEnabled;
+}
+
+int Configuration::getTracingBufferSize() const {
+  return *tracingBufferSize;
+}
+
+QString Configuration::getConfigurationFile() const {
+  return configurationFile;
+}
+
 void Configuration::loadConfiguration(const QFile& file) {
+  configurationFile = file.fileName();
   try {
     auto config = cpptoml::parse_file(file.fileName().toStdString());
     auto parseAddress = config->get_as<std::string>("server.address").value_or(defaultAddress);
@@ -240,12 +598,35 @@ void Configuration::loadConfiguration(const QFile& file) {
                            .value_or(std::vector<std::string>(defaultRequiredClaims.begin(), defaultRequiredClaims.end()));
     bool parseRetrieve = config->get_as<bool>("security.retrieveSettings").value_or(defaultRetrieveSettings);
     bool parseCheck = config->get_as<bool>("security.checkSettings").value_or(defaultCheckSettings);
+    auto parseVerificationCacheSize = config->get_as<int>("security.verificationCacheSize").value_or(defaultVerificationCacheSize);
     auto parseStoragePath = config->get_as<std::string>("scheduler.storagePath").value_or(defaultStoragePath);
     auto parseJobLifetime = config->get_as<uint16_t>("scheduler.jobLifetime").value_or(defaultJobLifetime);
     auto parseDefaultScheduler = config->get_as<std::string>("scheduler.defaultScheduler").value_or(defaultDefaultScheduler);
+    auto parseMaxParallelJobs = config->get_as<int>("scheduler.maxParallelJobs").value_or(defaultMaxParallelJobs);
+    auto parseAutoLatencyTarget = config->get_as<double>("scheduler.auto.latencyTarget").value_or(defaultAutoLatencyTarget);
+    auto parseMaxPlanSize = config->get_as<int64_t>("scheduler.maxPlanSize").value_or(defaultMaxPlanSize);
+    auto parseGapThreshold = config->get_as<double>("scheduler.gapThreshold").value_or(defaultGapThreshold);
+    auto parseMallocArenas = config->get_as<int>("scheduler.mallocArenas").value_or(defaultMallocArenas);
+    auto parseAdmissionMaxRunningJobs =
+        config->get_as<int>("scheduler.admission.maxRunningJobs").value_or(defaultAdmissionMaxRunningJobs);
+    auto parseAdmissionMaxQueuedJobs = config->get_as<int>("scheduler.admission.maxQueuedJobs").value_or(defaultAdmissionMaxQueuedJobs);
+    auto parseAdmissionMaxLoad = config->get_as<double>("scheduler.admission.maxLoad").value_or(defaultAdmissionMaxLoad);
+    auto parseAdmissionMinAvailableMemory =
+        config->get_as<int64_t>("scheduler.admission.minAvailableMemory").value_or(defaultAdmissionMinAvailableMemory);
     auto parseLegacySchedulerAlgorithmBinary = config->get_as<std::string>("scheduler.legacy.spaAlgorithmBinary")
                                                    .value_or(defaultLegacySchedulerAlgorithmBinary);
     bool parseLegacySchedulerPrintLog = config->get_as<bool>("scheduler.legacy.printLog").value_or(defaultLegacySchedulerPrintLog);
+    auto parseLegacySchedulerLocalSearchTime =
+        config->get_as<int>("scheduler.legacy.localSearchTime").value_or(defaultLegacySchedulerLocalSearchTime);
+    bool parseLegacySchedulerPresolve = config->get_as<bool>("scheduler.legacy.presolve").value_or(defaultLegacySchedulerPresolve);
+    auto parseLegacySchedulerPlacement = config->get_as<std::string>("scheduler.legacy.placement").value_or(defaultLegacySchedulerPlacement);
+    auto parseLegacySchedulerCoresPerJob = config->get_as<int>("scheduler.legacy.coresPerJob").value_or(defaultLegacySchedulerCoresPerJob);
+    auto parseLegacySchedulerReservedCores =
+        config->get_as<int>("scheduler.legacy.reservedCores").value_or(defaultLegacySchedulerReservedCores);
+    auto parseExactSchedulerTimeLimit = config->get_as<int>("scheduler.exact.timeLimit").value_or(defaultExactSchedulerTimeLimit);
+    auto parseExactSchedulerMaxModules = config->get_as<int>("scheduler.exact.maxModules").value_or(defaultExactSchedulerMaxModules);
+    bool parseTracingEnabled = config->get_as<bool>("tracing.enabled").value_or(defaultTracingEnabled);
+    auto parseTracingBufferSize = config->get_as<int>("tracing.bufferSize").value_or(defaultTracingBufferSize);
 
     if(address == "") {
       address = QString().fromStdString(parseAddress);
@@ -269,18 +650,75 @@ void Configuration::loadConfiguration(const QFile& file) {
     if(authUrl == "") {
       authUrl = QString().fromStdString(parseAuthUrl);
     }
+    if(verificationCacheSize.isNull()) {
+      verificationCacheSize.reset(new int(parseVerificationCacheSize));
+    }
     if(storagePath.isNull()) {
       loadStoragePath(QString().fromStdString(parseStoragePath));
     }
     if(defaultSchedulingAlgorithm == "") {
       defaultSchedulingAlgorithm = QString().fromStdString(parseDefaultScheduler);
     }
+    if(maxParallelJobs.isNull()) {
+      maxParallelJobs.reset(new int(parseMaxParallelJobs));
+    }
+    if(autoLatencyTarget.isNull()) {
+      autoLatencyTarget.reset(new double(parseAutoLatencyTarget));
+    }
+    if(maxPlanSize.isNull()) {
+      maxPlanSize.reset(new qint64(parseMaxPlanSize));
+    }
+    if(gapThreshold.isNull()) {
+      gapThreshold.reset(new double(parseGapThreshold));
+    }
+    if(mallocArenas.isNull()) {
+      mallocArenas.reset(new int(parseMallocArenas));
+    }
+    if(admissionMaxRunningJobs.isNull()) {
+      admissionMaxRunningJobs.reset(new int(parseAdmissionMaxRunningJobs));
+    }
+    if(admissionMaxQueuedJobs.isNull()) {
+      admissionMaxQueuedJobs.reset(new int(parseAdmissionMaxQueuedJobs));
+    }
+    if(admissionMaxLoad.isNull()) {
+      admissionMaxLoad.reset(new double(parseAdmissionMaxLoad));
+    }
+    if(admissionMinAvailableMemory.isNull()) {
+      admissionMinAvailableMemory.reset(new qint64(parseAdmissionMinAvailableMemory));
+    }
     if(legacySchedulerAlgorithmBinary == "") {
       legacySchedulerAlgorithmBinary = QString().fromStdString(parseLegacySchedulerAlgorithmBinary);
     }
     if(legacySchedulerPrintLog.isNull()) {
       legacySchedulerPrintLog.reset(new bool(parseLegacySchedulerPrintLog));
     }
+    if(legacySchedulerLocalSearchTime.isNull()) {
+      legacySchedulerLocalSearchTime.reset(new int(parseLegacySchedulerLocalSearchTime));
+    }
+    if(legacySchedulerPresolve.isNull()) {
+      legacySchedulerPresolve.reset(new bool(parseLegacySchedulerPresolve));
+    }
+    if(legacySchedulerPlacement == "") {
+      legacySchedulerPlacement = QString().fromStdString(parseLegacySchedulerPlacement);
+    }
+    if(legacySchedulerCoresPerJob.isNull()) {
+      legacySchedulerCoresPerJob.reset(new int(parseLegacySchedulerCoresPerJob));
+    }
+    if(legacySchedulerReservedCores.isNull()) {
+      legacySchedulerReservedCores.reset(new int(parseLegacySchedulerReservedCores));
+    }
+    if(exactSchedulerTimeLimit.isNull()) {
+      exactSchedulerTimeLimit.reset(new int(parseExactSchedulerTimeLimit));
+    }
+    if(exactSchedulerMaxModules.isNull()) {
+      exactSchedulerMaxModules.reset(new int(parseExactSchedulerMaxModules));
+    }
+    if(tracingEnabled.isNull()) {
+      tracingEnabled.reset(new bool(parseTracingEnabled));
+    }
+    if(tracingBufferSize.isNull()) {
+      tracingBufferSize.reset(new int(parseTracingBufferSize));
+    }
     if(jobLifetime.isNull()) {
       jobLifetime.reset(new int(parseJobLifetime));
     }
@@ -325,14 +763,15 @@ void Configuration::checkPublicKey(const QString& publicKey) {
   }
 }
 
-void Configuration::retrieveSettings(const QString&) {
-  warnConfiguration("Retrieving settings from server not implemented yet");
-  return;
-}
-
-void Configuration::checkKeyAndIssuer(const QString&) {
-  warnConfiguration("Checking setting with server not implemented yet");
-  return;
+void Configuration::retrieveSettings(const QString& authServerUrl) {
+  // Do not wait for the auth server, the AuthSettingsRevalidator retrieves the current settings in the background
+  AuthSettings cachedSettings = AuthSettings::readCache(getStoragePath());
+  if(cachedSettings.authUrl != authServerUrl || !cachedSettings.isValid()) {
+    warnConfiguration("No cached settings for the auth server " + authServerUrl + ". Tokens are rejected until they are retrieved.");
+    return;
+  }
+  publicKey = cachedSettings.publicKey;
+  issuer = cachedSettings.issuer;
 }
 
 void Configuration::loadStoragePath(const QString& storagePathString) {
@@ -346,6 +785,9 @@ void Configuration::loadStoragePath(const QString& storagePathString) {
 }
 
 [[noreturn]] void Configuration::failConfiguration(const QString& message) const {
+  if(!exitOnFailure) {
+    throw ConfigurationException(message);
+  }
   QTextStream(stderr) << message << Qt::endl;
   exit(1);
 }
@@ -381,18 +823,95 @@ void Configuration::checkConfiguration() {
       warnConfiguration("You specified no required claims.");
   }*/
 
-  if(defaultSchedulingAlgorithm != "legacy-fast" && defaultSchedulingAlgorithm != "legacy-good") {
-    failConfiguration("Legacy scheduler print log option not specified");
+  if(defaultSchedulingAlgorithm != "legacy-fast" && defaultSchedulingAlgorithm != "legacy-good" && defaultSchedulingAlgorithm != "exact" &&
+     defaultSchedulingAlgorithm != "auto") {
+    failConfiguration("Invalid default scheduler " + defaultSchedulingAlgorithm + " (needs to be legacy-fast, legacy-good, exact or auto).");
   }
 
   if(legacySchedulerPrintLog.isNull()) {
     failConfiguration("Legacy scheduler print log option not specified");
   }
 
+  if(!CpuPlacement::isValidPolicy(legacySchedulerPlacement)) {
+    failConfiguration("Invalid legacy scheduler placement " + legacySchedulerPlacement + " (needs to be none or spread).");
+  }
+
+  if(legacySchedulerCoresPerJob.isNull() || *legacySchedulerCoresPerJob < 1) {
+    failConfiguration("Invalid number of cores per job (needs to be bigger than 0).");
+  }
+
+  if(legacySchedulerReservedCores.isNull() || *legacySchedulerReservedCores < 0) {
+    failConfiguration("Invalid number of reserved cores (needs to be 0 or bigger).");
+  }
+
+  if(legacySchedulerLocalSearchTime.isNull() || *legacySchedulerLocalSearchTime < 0) {
+    failConfiguration("Invalid local search time (needs to be 0 or bigger).");
+  }
+
+  if(legacySchedulerPresolve.isNull()) {
+    failConfiguration("Legacy scheduler presolve option not specified");
+  }
+
+  if(exactSchedulerTimeLimit.isNull() || *exactSchedulerTimeLimit < 1) {
+    failConfiguration("Invalid exact scheduler time limit (needs to be bigger than 0).");
+  }
+
+  if(exactSchedulerMaxModules.isNull() || *exactSchedulerMaxModules < 0) {
+    failConfiguration("Invalid exact scheduler max modules (needs to be 0 or bigger).");
+  }
+
+  if(verificationCacheSize.isNull() || *verificationCacheSize < 0) {
+    failConfiguration("Invalid verification cache size (needs to be 0 or bigger).");
+  }
+
+  if(tracingEnabled.isNull()) {
+    failConfiguration("Tracing option not specified");
+  }
+
+  if(tracingBufferSize.isNull() || *tracingBufferSize < 1) {
+    failConfiguration("Invalid trace buffer size (needs to be bigger than 0).");
+  }
+
   if(jobLifetime.isNull() || *jobLifetime < -1) {
     failConfiguration("Invalid job lifetime (needs to be bigger than -1).");
   }
 
+  if(maxParallelJobs.isNull() || *maxParallelJobs < 0) {
+    failConfiguration("Invalid number of parallel jobs (needs to be 0 or bigger).");
+  }
+
+  if(maxPlanSize.isNull() || *maxPlanSize < 0) {
+    failConfiguration("Invalid max plan size (needs to be 0 or bigger).");
+  }
+
+  if(gapThreshold.isNull() || *gapThreshold < 0 || *gapThreshold > 1) {
+    failConfiguration("Invalid gap threshold (needs to be between 0 and 1).");
+  }
+
+  if(mallocArenas.isNull() || *mallocArenas < 0) {
+    failConfiguration("Invalid number of malloc arenas (needs to be 0 or bigger).");
+  }
+
+  if(admissionMaxRunningJobs.isNull() || *admissionMaxRunningJobs < 0) {
+    failConfiguration("Invalid number of running jobs (needs to be 0 or bigger).");
+  }
+
+  if(admissionMaxQueuedJobs.isNull() || *admissionMaxQueuedJobs < 0) {
+    failConfiguration("Invalid number of queued jobs (needs to be 0 or bigger).");
+  }
+
+  if(admissionMaxLoad.isNull() || *admissionMaxLoad < 0) {
+    failConfiguration("Invalid max load (needs to be 0 or bigger).");
+  }
+
+  if(admissionMinAvailableMemory.isNull() || *admissionMinAvailableMemory < 0) {
+    failConfiguration("Invalid min available memory (needs to be 0 or bigger).");
+  }
+
+  if(autoLatencyTarget.isNull() || *autoLatencyTarget <= 0) {
+    failConfiguration("Invalid auto latency target (needs to be bigger than 0).");
+  }
+
   if(!QFile(legacySchedulerAlgorithmBinary).exists()) {
     failConfiguration("Legacy scheduler binary not found (" + legacySchedulerAlgorithmBinary + ").");
   }
@@ -13,10 +13,15 @@
 #include <QString>
 #include <QTemporaryDir>
 #include <QTextStream>
+#include <QThread>
+#include <algorithm>
 #include <array>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "authsettings.h"
+#include "cpuplacement.h"
 #include "plan.h"
 #include "plancsvhelper.h"
 #include "semester.h"
@@ -31,6 +36,15 @@
 #define DEFAULT_STORAGE_PATH "/usr/share/pruefungsplaner-backend/data"
 #endif
 
+/**
+ *  @class ConfigurationException
+ *  @brief Thrown by Configuration instead of exiting, if it is not the startup configuration
+ */
+class ConfigurationException: public std::runtime_error {
+ public:
+  explicit ConfigurationException(const QString& message): std::runtime_error(message.toStdString()) {}
+};
+
 class Configuration: public QObject {
   Q_OBJECT
  private:
@@ -44,45 +58,113 @@ class Configuration: public QObject {
   static constexpr auto defaultStoragePath = DEFAULT_STORAGE_PATH;
   static constexpr auto defaultRetrieveSettings = false;
   static constexpr auto defaultCheckSettings = false;
+  static constexpr int defaultVerificationCacheSize = 1024;
   static constexpr int defaultJobLifetime = 86400;
   static constexpr auto defaultDefaultScheduler = "legacy-fast";
+  static constexpr int defaultMaxParallelJobs = 0;
+  static constexpr double defaultAutoLatencyTarget = 60.0;
+  static constexpr qint64 defaultMaxPlanSize = 64 * 1024 * 1024;
+  static constexpr double defaultGapThreshold = 0.0;
+  static constexpr int defaultMallocArenas = 0;
+  static constexpr int defaultAdmissionMaxRunningJobs = 32;
+  static constexpr int defaultAdmissionMaxQueuedJobs = 256;
+  static constexpr double defaultAdmissionMaxLoad = 0.0;
+  static constexpr qint64 defaultAdmissionMinAvailableMemory = 256;
   static constexpr auto defaultLegacySchedulerAlgorithmBinary = "/usr/bin/SPA-algorithmus";
   static constexpr auto defaultLegacySchedulerPrintLog = false;
+  static constexpr int defaultLegacySchedulerLocalSearchTime = 0;
+  static constexpr auto defaultLegacySchedulerPresolve = false;
+  static constexpr auto defaultLegacySchedulerPlacement = CpuPlacement::nonePolicy;
+  static constexpr int defaultLegacySchedulerCoresPerJob = 1;
+  static constexpr int defaultLegacySchedulerReservedCores = 1;
+  static constexpr int defaultExactSchedulerTimeLimit = 10000;
+  static constexpr int defaultExactSchedulerMaxModules = 0;
+  static constexpr auto defaultTracingEnabled = false;
+  static constexpr int defaultTracingBufferSize = 65536;
   QString address;
   quint16 port;
   QString publicKey;
   QString issuer;
   QList<QString> requiredClaims;
+  QScopedPointer<int> verificationCacheSize;
   QScopedPointer<QDir> storagePath;
   QScopedPointer<int> jobLifetime;
   QString defaultSchedulingAlgorithm;
+  QScopedPointer<int> maxParallelJobs;
+  QScopedPointer<double> autoLatencyTarget;
+  QScopedPointer<qint64> maxPlanSize;
+  QScopedPointer<double> gapThreshold;
+  QScopedPointer<int> mallocArenas;
+  QScopedPointer<int> admissionMaxRunningJobs;
+  QScopedPointer<int> admissionMaxQueuedJobs;
+  QScopedPointer<double> admissionMaxLoad;
+  QScopedPointer<qint64> admissionMinAvailableMemory;
   QString legacySchedulerAlgorithmBinary;
   QScopedPointer<bool> legacySchedulerPrintLog;
+  QScopedPointer<int> legacySchedulerLocalSearchTime;
+  QScopedPointer<bool> legacySchedulerPresolve;
+  QString legacySchedulerPlacement;
+  QScopedPointer<int> legacySchedulerCoresPerJob;
+  QScopedPointer<int> legacySchedulerReservedCores;
+  QScopedPointer<int> exactSchedulerTimeLimit;
+  QScopedPointer<int> exactSchedulerMaxModules;
+  QScopedPointer<bool> tracingEnabled;
+  QScopedPointer<int> tracingBufferSize;
+  QString configurationFile;
 
   // These are only used internally
   QString authUrl;
   QScopedPointer<bool> check;
   QScopedPointer<bool> retrieve;
+  bool exitOnFailure;
 
  public:
-  explicit Configuration(const QList<QString>& args, QObject* parent = nullptr);
+  /**
+   *  @brief Creates a new Configuration from the command line and the configuration file
+   *  @param [in] args are the command line arguments
+   *  @param [in] exitOnFailure if set, an invalid configuration exits the process, otherwise a ConfigurationException is thrown
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit Configuration(const QList<QString>& args, bool exitOnFailure = true, QObject* parent = nullptr);
   QString getAddress() const;
   quint16 getPort() const;
   QString getPublicKey() const;
   QString getIssuer() const;
   QList<QString> getClaims() const;
+  int getVerificationCacheSize() const;
+  bool getRetrieveSettings() const;
+  bool getCheckSettings() const;
+  QString getAuthUrl() const;
   QDir getStoragePath() const;
   int getJobLifetime() const;
   QString getDefaultSchedulingAlgorithm() const;
+  int getMaxParallelJobs() const;
+  double getAutoLatencyTarget() const;
+  qint64 getMaxPlanSize() const;
+  double getGapThreshold() const;
+  int getMallocArenas() const;
+  int getAdmissionMaxRunningJobs() const;
+  int getAdmissionMaxQueuedJobs() const;
+  double getAdmissionMaxLoad() const;
+  qint64 getAdmissionMinAvailableMemory() const;
   QString getLegacySchedulerAlgorithmBinary() const;
   bool getLegacySchedulerPrintLog() const;
+  int getLegacySchedulerLocalSearchTime() const;
+  bool getLegacySchedulerPresolve() const;
+  QString getLegacySchedulerPlacement() const;
+  int getLegacySchedulerCoresPerJob() const;
+  int getLegacySchedulerReservedCores() const;
+  int getExactSchedulerTimeLimit() const;
+  int getExactSchedulerMaxModules() const;
+  bool getTracingEnabled() const;
+  int getTracingBufferSize() const;
+  QString getConfigurationFile() const;
 
  private:
   void loadConfiguration(const QFile& configuration);
   void readPublicKey(QFile& publicKeyFile);
   void checkPublicKey(const QString& publicKey);
   void retrieveSettings(const QString& authServerUrl);
-  void checkKeyAndIssuer(const QString& authServerUrl);
   void loadStoragePath(const QString& storagePath);
   void checkConfiguration();
   [[noreturn]] void failConfiguration(const QString& message) const;
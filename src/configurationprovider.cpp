@@ -0,0 +1,97 @@
+#include "configurationprovider.h"
+
+int ConfigurationProvider::signalSockets[2] = {-1, -1};
+
+ConfigurationProvider::ConfigurationProvider(const QList<QString>& arguments, QObject* parent)
+    : QObject(parent), arguments(arguments), configuration(new Configuration(arguments)) {}
+
+ConfigurationProvider::ConfigurationProvider(const QSharedPointer<const Configuration>& configuration, QObject* parent)
+    : QObject(parent), configuration(configuration) {}
+
+QSharedPointer<const Configuration> ConfigurationProvider::getConfiguration() const {
+  QMutexLocker locker(&mutex);
+  return configuration;
+}
+
+bool ConfigurationProvider::reload() {
+  if(arguments.isEmpty()) {
+    emit reloadFailed("This configuration can not be reloaded");
+    return false;
+  }
+
+  QSharedPointer<const Configuration> newConfiguration;
+  try {
+    newConfiguration.reset(new Configuration(arguments, false));
+  } catch(const ConfigurationException& e) {
+    qDebug() << "Failed to reload configuration:" << e.what();
+    emit reloadFailed(QString(e.what()));
+    return false;
+  }
+
+  QSharedPointer<const Configuration> oldConfiguration = getConfiguration();
+  if(newConfiguration->getAddress() != oldConfiguration->getAddress() || newConfiguration->getPort() != oldConfiguration->getPort()) {
+    qDebug() << "The address and port can not be changed at runtime. The server will keep listening on" << oldConfiguration->getAddress()
+             << oldConfiguration->getPort();
+  }
+
+  publish(newConfiguration);
+  qDebug() << "Reloaded configuration";
+  emit configurationReloaded();
+  return true;
+}
+
+void ConfigurationProvider::watchConfigurationFile() {
+  QString configurationFile = getConfiguration()->getConfigurationFile();
+  if(configurationFile.isEmpty() || !configurationFileWatcher.files().isEmpty()) {
+    return;
+  }
+  configurationFileWatcher.addPath(configurationFile);
+  connect(&configurationFileWatcher, &QFileSystemWatcher::fileChanged, this, [this](const QString& path) {
+    reload();
+    // Editors often replace the file, which removes it from the watcher
+    if(!configurationFileWatcher.files().contains(path) && QFile::exists(path)) {
+      configurationFileWatcher.addPath(path);
+    }
+  });
+}
+
+bool ConfigurationProvider::watchReloadSignal() {
+  if(!signalNotifier.isNull()) {
+    return true;
+  }
+  if(::socketpair(AF_UNIX, SOCK_STREAM, 0, signalSockets) != 0) {
+    qDebug() << "Failed to create socket pair for SIGHUP handling";
+    return false;
+  }
+
+  // The handler only writes to the socket, the reload happens in the event loop
+  signalNotifier.reset(new QSocketNotifier(signalSockets[1], QSocketNotifier::Read));
+  connect(signalNotifier.data(), &QSocketNotifier::activated, this, [this]() {
+    signalNotifier->setEnabled(false);
+    char signalByte;
+    if(::read(signalSockets[1], &signalByte, sizeof(signalByte)) > 0) {
+      reload();
+    }
+    signalNotifier->setEnabled(true);
+  });
+
+  struct sigaction hangupAction = {};
+  hangupAction.sa_handler = ConfigurationProvider::reloadSignalHandler;
+  sigemptyset(&hangupAction.sa_mask);
+  hangupAction.sa_flags = SA_RESTART;
+  if(sigaction(SIGHUP, &hangupAction, nullptr) != 0) {
+    qDebug() << "Failed to install SIGHUP handler";
+    return false;
+  }
+  return true;
+}
+
+void ConfigurationProvider::reloadSignalHandler(int) {
+  char signalByte = 1;
+  [[maybe_unused]] auto written = ::write(signalSockets[0], &signalByte, sizeof(signalByte));
+}
+
+void ConfigurationProvider::publish(const QSharedPointer<const Configuration>& newConfiguration) {
+  QMutexLocker locker(&mutex);
+  configuration = newConfiguration;
+}
@@ -0,0 +1,101 @@
+#ifndef CONFIGURATIONPROVIDER_H
+#define CONFIGURATIONPROVIDER_H
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <QDebug>
+#include <QFileSystemWatcher>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QSharedPointer>
+#include <QSocketNotifier>
+#include <QString>
+
+#include "configuration.h"
+
+/**
+ *  @class ConfigurationProvider
+ *  @brief Publishes the current Configuration and reloads it at runtime
+ *
+ *  Every published Configuration is an immutable snapshot. Jobs take the
+ *  snapshot, that is current when they start, and keep it until they are
+ *  finished. A reload only replaces the published snapshot, so running jobs
+ *  are not affected by it.
+ *
+ *  A reload is triggered by SIGHUP or by a change of the configuration file.
+ *  If the new configuration is invalid, the old one stays published.
+ *  The address and the port are only read at startup.
+ */
+class ConfigurationProvider: public QObject {
+  Q_OBJECT
+
+ private:
+  static int signalSockets[2];
+
+  QList<QString> arguments;
+  mutable QMutex mutex;
+  QSharedPointer<const Configuration> configuration;
+  QFileSystemWatcher configurationFileWatcher;
+  QScopedPointer<QSocketNotifier> signalNotifier;
+
+ public:
+  /**
+   *  @brief Creates a new ConfigurationProvider, that loads its configuration from the command line arguments
+   *  @param [in] arguments are the command line arguments
+   *  @param [in] parent is the parent of this QObject
+   *
+   *  Exits the process, if the initial configuration is invalid.
+   */
+  explicit ConfigurationProvider(const QList<QString>& arguments, QObject* parent = nullptr);
+
+  /**
+   *  @brief Creates a new ConfigurationProvider, that always provides the same configuration
+   *  @param [in] configuration is the configuration, that will be provided
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit ConfigurationProvider(const QSharedPointer<const Configuration>& configuration, QObject* parent = nullptr);
+
+  /**
+   *  @brief Get the currently published configuration
+   *  @return A snapshot of the current configuration. It will not change, even if the configuration is reloaded.
+   */
+  QSharedPointer<const Configuration> getConfiguration() const;
+
+  /**
+   *  @brief Reload the configuration from the command line arguments and the configuration file
+   *  @return A boolean indicating if the new configuration was published
+   */
+  bool reload();
+
+  /**
+   *  @brief Reload the configuration, when the configuration file changes
+   */
+  void watchConfigurationFile();
+
+  /**
+   *  @brief Reload the configuration, when the process receives SIGHUP
+   *  @return A boolean indicating if the signal handler was installed
+   */
+  bool watchReloadSignal();
+
+ private:
+  static void reloadSignalHandler(int);
+  void publish(const QSharedPointer<const Configuration>& newConfiguration);
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, when a new configuration was published
+   */
+  void configurationReloaded();
+
+  /**
+   *  @brief This signal will be emitted, when reloading the configuration failed
+   *  @param message contains a message with information about the failure
+   */
+  void reloadFailed(QString message);
+};
+
+#endif  // CONFIGURATIONPROVIDER_H
@@ -0,0 +1,149 @@
+#include "cpuplacement.h"
+
+bool CpuPlacement::Placement::isPlaced() const {
+  return node != -1;
+}
+
+QJsonObject CpuPlacement::Placement::toJsonObject() const {
+  QJsonObject placement;
+  placement["node"] = node;
+  QJsonArray cpuArray;
+  for(int cpu : cpus) {
+    cpuArray.append(cpu);
+  }
+  placement["cpus"] = cpuArray;
+  return placement;
+}
+
+CpuPlacement::CpuPlacement(): CpuPlacement(readTopology()) {}
+
+CpuPlacement::CpuPlacement(const QVector<QVector<int>>& nodes): enabled(false), coresPerJob(1), reservedCores(1), nodes(nodes) {
+  resetFreeCpus();
+}
+
+CpuPlacement& CpuPlacement::global() {
+  static CpuPlacement placement;
+  return placement;
+}
+
+void CpuPlacement::configure(const QString& policy, int coresPerJob, int reservedCores) {
+  QMutexLocker locker(&mutex);
+  enabled = policy == spreadPolicy;
+  this->coresPerJob = std::max(coresPerJob, 1);
+  this->reservedCores = std::max(reservedCores, 0);
+  resetFreeCpus();
+}
+
+bool CpuPlacement::isEnabled() const {
+  QMutexLocker locker(&mutex);
+  return enabled;
+}
+
+CpuPlacement::Placement CpuPlacement::acquire() {
+  QMutexLocker locker(&mutex);
+  Placement placement;
+  if(!enabled) {
+    return placement;
+  }
+
+  int bestNode = -1;
+  for(int node = 0; node < freeCpus.size(); node++) {
+    if(freeCpus[node].size() >= coresPerJob && (bestNode == -1 || freeCpus[node].size() > freeCpus[bestNode].size())) {
+      bestNode = node;
+    }
+  }
+  if(bestNode == -1) {
+    // The job shares the cores of the placed jobs, but keeps off the reserved ones
+    for(int node = 0; node < nodes.size(); node++) {
+      placement.cpus += node == 0 ? nodes[node].mid(std::min(reservedCores, nodes[node].size())) : nodes[node];
+    }
+    return placement;
+  }
+
+  placement.node = bestNode;
+  for(int i = 0; i < coresPerJob; i++) {
+    placement.cpus.append(freeCpus[bestNode].takeFirst());
+  }
+  heldCpus += placement.cpus;
+  return placement;
+}
+
+void CpuPlacement::release(const Placement& placement) {
+  QMutexLocker locker(&mutex);
+  if(!placement.isPlaced()) {
+    return;
+  }
+  for(int cpu : placement.cpus) {
+    heldCpus.removeOne(cpu);
+  }
+  // The configuration may have changed, while the job was running
+  resetFreeCpus();
+}
+
+QVector<int> CpuPlacement::parseCpuList(const QString& cpuList) {
+  QVector<int> cpus;
+  for(const QString& range : cpuList.trimmed().split(',', Qt::SkipEmptyParts)) {
+    QStringList borders = range.split('-');
+    bool firstOk;
+    bool lastOk = true;
+    int first = borders.first().toInt(&firstOk);
+    int last = borders.size() == 2 ? borders.last().toInt(&lastOk) : first;
+    if(!firstOk || !lastOk || borders.size() > 2 || last < first || first < 0 || last >= CPU_SETSIZE) {
+      return QVector<int>();
+    }
+    for(int cpu = first; cpu <= last; cpu++) {
+      cpus.append(cpu);
+    }
+  }
+  return cpus;
+}
+
+bool CpuPlacement::isValidPolicy(const QString& policy) {
+  return policy == nonePolicy || policy == spreadPolicy;
+}
+
+QVector<QVector<int>> CpuPlacement::readTopology() {
+  // Only use cpus, that this process may use
+  cpu_set_t allowedCpus;
+  CPU_ZERO(&allowedCpus);
+  bool restricted = sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) == 0;
+
+  QVector<QVector<int>> topology;
+  QDir nodeDirectory("/sys/devices/system/node");
+  for(const QString& node : nodeDirectory.entryList(QStringList{"node*"}, QDir::Dirs, QDir::Name)) {
+    QFile cpuListFile(nodeDirectory.filePath(node + "/cpulist"));
+    if(!cpuListFile.open(QFile::ReadOnly)) {
+      continue;
+    }
+    QVector<int> cpus;
+    for(int cpu : parseCpuList(QString::fromLatin1(cpuListFile.readAll()))) {
+      if(!restricted || CPU_ISSET(cpu, &allowedCpus)) {
+        cpus.append(cpu);
+      }
+    }
+    if(!cpus.isEmpty()) {
+      topology.append(cpus);
+    }
+  }
+
+  if(topology.isEmpty() && restricted) {
+    QVector<int> cpus;
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if(CPU_ISSET(cpu, &allowedCpus)) {
+        cpus.append(cpu);
+      }
+    }
+    topology.append(cpus);
+  }
+  return topology;
+}
+
+void CpuPlacement::resetFreeCpus() {
+  freeCpus = nodes;
+  if(!freeCpus.isEmpty()) {
+    freeCpus[0] = freeCpus[0].mid(std::min(reservedCores, freeCpus[0].size()));
+  }
+  for(QVector<int>& nodeCpus : freeCpus) {
+    nodeCpus.erase(std::remove_if(nodeCpus.begin(), nodeCpus.end(), [this](int cpu) { return heldCpus.contains(cpu); }), nodeCpus.end());
+  }
+}
@@ -0,0 +1,116 @@
+#ifndef CPUPLACEMENT_H
+#define CPUPLACEMENT_H
+
+#include <sched.h>
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+
+/**
+ *  @class CpuPlacement
+ *  @brief Assigns a set of cores to every scheduler process
+ *
+ *  Every process gets coresPerJob cores of a single NUMA node, so it keeps
+ *  its caches and its memory is allocated on the local node. Jobs are spread
+ *  over the nodes, a new job goes to the node with the most free cores. The
+ *  first reservedCores cores of the first node are never assigned, they are
+ *  left for the RPC event loop.
+ *
+ *  If no node has enough free cores, the job is not placed. It may still run
+ *  on every core except the reserved ones, shared with the other jobs.
+ *
+ *  The topology is read from /sys/devices/system/node. Without NUMA
+ *  information all cores, that this process may use, are a single node.
+ */
+class CpuPlacement {
+ public:
+  static constexpr auto nonePolicy = "none";
+  static constexpr auto spreadPolicy = "spread";
+
+  /**
+   *  @brief The cores assigned to a job
+   */
+  struct Placement {
+    // -1, if the job was not placed
+    int node = -1;
+    // The cores of the job. A job, that was not placed, shares the cores, that are not reserved. Empty, if the job may
+    // use every core.
+    QVector<int> cpus;
+
+    bool isPlaced() const;
+    QJsonObject toJsonObject() const;
+  };
+
+ private:
+  mutable QMutex mutex;
+  bool enabled;
+  int coresPerJob;
+  int reservedCores;
+  // The cpus of every node
+  QVector<QVector<int>> nodes;
+  // The free cpus of every node
+  QVector<QVector<int>> freeCpus;
+  // The cpus of all running jobs
+  QVector<int> heldCpus;
+
+ public:
+  /**
+   *  @brief Creates a new disabled CpuPlacement with the topology of this machine
+   */
+  CpuPlacement();
+
+  /**
+   *  @brief Creates a new disabled CpuPlacement with the given topology
+   *  @param [in] nodes contains the cpus of every NUMA node
+   */
+  explicit CpuPlacement(const QVector<QVector<int>>& nodes);
+
+  /**
+   *  @brief The placement used by the scheduler processes
+   */
+  static CpuPlacement& global();
+
+  /**
+   *  @brief Configure the placement. Running jobs keep their cores, until they release them.
+   *  @param [in] policy is nonePolicy or spreadPolicy
+   *  @param [in] coresPerJob is the number of cores of every job
+   *  @param [in] reservedCores is the number of cores left for the event loop
+   */
+  void configure(const QString& policy, int coresPerJob, int reservedCores);
+
+  bool isEnabled() const;
+
+  /**
+   *  @brief Take cores for a new job
+   *  @return The placement of the job. It is not placed, if placement is disabled or there are not enough free cores. In
+   * the second case, it contains the cores, that are not reserved.
+   */
+  Placement acquire();
+
+  /**
+   *  @brief Return the cores of a finished job
+   */
+  void release(const Placement& placement);
+
+  /**
+   *  @brief Parse a cpu list like 0-3,8,10-11
+   */
+  static QVector<int> parseCpuList(const QString& cpuList);
+
+  /**
+   *  @brief Check if policy is a valid placement policy
+   */
+  static bool isValidPolicy(const QString& policy);
+
+ private:
+  static QVector<QVector<int>> readTopology();
+  void resetFreeCpus();
+};
+
+#endif  // CPUPLACEMENT_H
@@ -0,0 +1,177 @@
+#include "exactscheduler.h"
+
+ExactScheduler::ExactScheduler(QSharedPointer<Plan> plan, const int timeLimit, const int maxModules, QObject* parent)
+    : Scheduler(parent),
+      originalPlan(plan),
+      timeLimit(timeLimit),
+      maxModules(maxModules),
+      threads(1),
+      cpuPlacement(nullptr),
+      placementHeld(false),
+      stopRequested(false),
+      finished(false),
+      initialPenalty(-1) {}
+
+ExactScheduler::~ExactScheduler() {
+  // A running search returns its best schedule, so the destruction does not wait for the time limit
+  stopRequested = true;
+  pipeline = JobPipeline::Task();
+  releasePlacement();
+}
+
+bool ExactScheduler::startScheduling() {
+  if(originalPlan == nullptr || pipeline.isRunning()) {
+    return false;
+  }
+  stopRequested = false;
+  finished = false;
+  initialPenalty = -1;
+  result = BranchAndBound::Result();
+  jobMemory.start();
+  emit updateProgress(0.0);
+  pipeline = runPipeline();
+  return true;
+}
+
+void ExactScheduler::stopScheduling() {
+  stopRequested = true;
+}
+
+QJsonObject ExactScheduler::getMetrics() const {
+  QJsonObject metrics;
+  metrics["threads"] = placement.isPlaced() ? placement.cpus.size() : threads;
+  if(!placement.cpus.isEmpty()) {
+    metrics["placement"] = placement.toJsonObject();
+  } else {
+    metrics["placement"] = QJsonValue::Null;
+  }
+  if(finished) {
+    metrics["nodes"] = result.nodes;
+    metrics["optimal"] = result.optimal;
+    metrics["lowerBound"] = result.lowerBound;
+  } else {
+    metrics["nodes"] = QJsonValue::Null;
+    metrics["optimal"] = QJsonValue::Null;
+    metrics["lowerBound"] = QJsonValue::Null;
+  }
+  metrics["peakProcessHeapGrowth"] = jobMemory.getPeakProcessHeapGrowth();
+  return metrics;
+}
+
+void ExactScheduler::setThreads(int threads) {
+  this->threads = std::max(threads, 1);
+}
+
+void ExactScheduler::setCpuPlacement(CpuPlacement* cpuPlacement) {
+  this->cpuPlacement = cpuPlacement;
+}
+
+int ExactScheduler::countMovableModules(Plan* plan) {
+  int modules = 0;
+  for(Module* module : plan->getModules()) {
+    if(module->getActive() && module->getOrigin() != "EIT") {
+      modules++;
+    }
+  }
+  return modules;
+}
+
+JobPipeline::Task ExactScheduler::runPipeline() {
+  QSharedPointer<Plan> plan = originalPlan;
+  QString jobTraceId = traceId;
+
+  int planMaxModules = maxModules;
+  FeasibilityCheck::Result feasibility = co_await JobPipeline::runInPool([plan, planMaxModules, jobTraceId]() {
+    Tracer::Span span("feasibilityCheck", jobTraceId);
+    int modules = countMovableModules(plan.get());
+    if(modules > planMaxModules) {
+      FeasibilityCheck::Result result;
+      result.feasible = false;
+      if(planMaxModules == 0) {
+        result.reason = "The exact scheduler is disabled, set maxModules in the [scheduler.exact] section to enable it";
+        return result;
+      }
+      result.reason = "The plan has " + QString::number(modules) + " modules, the exact scheduler only schedules plans with up to " +
+                      QString::number(planMaxModules) + " modules";
+      return result;
+    }
+    return FeasibilityCheck::check(plan.get());
+  });
+  if(!feasibility.feasible) {
+    emit updateProgress(1.0);
+    emit failedScheduling(feasibility.reason);
+    co_return;
+  }
+
+  placement = CpuPlacement::Placement();
+  if(cpuPlacement != nullptr) {
+    placement = cpuPlacement->acquire();
+    placementHeld = placement.isPlaced();
+    if(Tracer::global().isEnabled()) {
+      Tracer::global().instant("placement", jobTraceId, QJsonDocument(placement.toJsonObject()).toJson(QJsonDocument::Compact));
+    }
+  }
+
+  int searchTimeLimit = timeLimit;
+  int searchThreads = placement.isPlaced() ? placement.cpus.size() : threads;
+  QVector<int> searchCpus = placement.cpus;
+  double searchGapThreshold = gapThreshold;
+  result = co_await JobPipeline::runInPool([this, plan, searchTimeLimit, searchThreads, searchCpus, searchGapThreshold, jobTraceId]() {
+    qint64 searchStart = Tracer::global().now();
+    PlanIndex index(plan.get());
+    BranchAndBound search(index, index.readAssignment());
+    search.setGapThreshold(searchGapThreshold);
+    search.setCpus(searchCpus);
+    search.setImprovementCallback([this](int penalty, int lowerBound) {
+      // The search states are alive, while the search runs
+      jobMemory.sample();
+      QMetaObject::invokeMethod(
+          this,
+          [this, penalty, lowerBound]() {
+            updatePenalty(penalty, lowerBound);
+          },
+          Qt::QueuedConnection);
+    });
+    BranchAndBound::Result searchResult = search.run(searchTimeLimit, searchThreads, &stopRequested);
+    if(searchResult.feasible) {
+      index.writeAssignment(searchResult.assignment);
+    }
+    if(Tracer::global().isEnabled()) {
+      Tracer::global().complete("branchAndBound",
+                                jobTraceId,
+                                searchStart,
+                                QString::number(searchResult.nodes) + " nodes, " + (searchResult.optimal ? "optimal" : "stopped"));
+    }
+    return searchResult;
+  });
+  releasePlacement();
+  finished = true;
+  emit updateProgress(1.0);
+  if(!result.feasible) {
+    emit failedScheduling(result.optimal ? "The plan can not be scheduled" : "The exact scheduler stopped, before it found a schedule");
+    co_return;
+  }
+  if(!result.optimal) {
+    emit emitWarning("The exact scheduler stopped, before it proved, that the schedule is optimal");
+  }
+  emit finishedScheduling(plan);
+}
+
+void ExactScheduler::updatePenalty(int penalty, int lowerBound) {
+  if(finished) {
+    return;
+  }
+  if(initialPenalty < 0) {
+    initialPenalty = penalty;
+  }
+  emit updateGap(penalty, lowerBound);
+  // Progress is at least 0.05, to indicate, that a schedule was found. 1.0 is reached, when the search ended.
+  emit updateProgress(0.05 + 0.9 * SoftPenaltyBound::closedGap(initialPenalty, penalty, lowerBound));
+}
+
+void ExactScheduler::releasePlacement() {
+  if(cpuPlacement != nullptr && placementHeld) {
+    cpuPlacement->release(placement);
+  }
+  placementHeld = false;
+}
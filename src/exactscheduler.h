@@ -0,0 +1,128 @@
+#ifndef EXACTSCHEDULER_H
+#define EXACTSCHEDULER_H
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+#include "branchandbound.h"
+#include "cpuplacement.h"
+#include "feasibilitycheck.h"
+#include "jobpipeline.h"
+#include "planindex.h"
+#include "scheduleevaluator.h"
+#include "scheduler.h"
+#include "softpenaltybound.h"
+#include "tracer.h"
+
+/**
+ *  @class ExactScheduler
+ *  @brief Schedules small plans with a BranchAndBound search
+ *
+ *  The scheduler proves, that its schedule has the minimal soft penalty, or
+ *  returns the best schedule found, when its time limit runs out or it is
+ *  stopped. Plans with more movable modules than maxModules are rejected, the
+ *  search tree grows exponentially with the modules. A maxModules of 0 rejects
+ *  every plan with movable modules.
+ *
+ *  A job runs as a JobPipeline with the stages feasibility check and search.
+ *  Both are executed on the global QThreadPool. Every better schedule is
+ *  reported with updateGap. The progress is the share of the gap between the
+ *  first schedule and the SoftPenaltyBound, that was closed.
+ *
+ *  The search runs on the cores of the placement of the job. A job without a
+ *  placement runs with the configured number of threads, a single one by
+ *  default, so concurrent jobs do not oversubscribe the machine.
+ */
+class ExactScheduler: public Scheduler {
+  Q_OBJECT
+
+ private:
+  QSharedPointer<Plan> originalPlan;
+  int timeLimit;
+  int maxModules;
+  int threads;
+  CpuPlacement* cpuPlacement;
+  // The placement stays available for the metrics, after its cores were released
+  CpuPlacement::Placement placement;
+  bool placementHeld;
+  std::atomic<bool> stopRequested;
+  BranchAndBound::Result result;
+  bool finished;
+  // The penalty of the first schedule of the job or -1, before one was found
+  int initialPenalty;
+  // Destroyed first, because its stages use the other members
+  JobPipeline::Task pipeline;
+
+ public:
+  /**
+   *  @brief Creates a new ExactScheduler, that will schedule a plan
+   *  @param [in] plan will be scheduled
+   *  @param [in] timeLimit is the maximum time in milliseconds the search runs
+   *  @param [in] maxModules is the maximum number of movable modules of a plan
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit ExactScheduler(QSharedPointer<Plan> plan, const int timeLimit = 10000, const int maxModules = 30, QObject* parent = nullptr);
+
+  ~ExactScheduler();
+
+  /**
+   *  @brief Start scheduling the plan passed in the constructor
+   *  @return A boolean indicating if scheduling was started
+   *
+   *  Returns false, if there is no plan or if a job is already running. Every other failure is reported with
+   * failedScheduling from the event loop.
+   */
+  bool startScheduling() override;
+
+  /**
+   * @brief Stop the search and emit the best schedule found so far, if there is one
+   */
+  void stopScheduling() override;
+
+  /**
+   *  @brief Get the size and the placement of the search and whether the schedule is proven optimal
+   */
+  QJsonObject getMetrics() const override;
+
+  /**
+   *  @brief Set the number of threads of a search, that was not placed
+   *  @param [in] threads is the number of threads. It defaults to 1.
+   */
+  void setThreads(int threads);
+
+  /**
+   *  @brief Run the search on the cores assigned by cpuPlacement
+   *  @param [in] cpuPlacement assigns the cores. It has to outlive this scheduler. If it is nullptr, the search is not
+   * placed.
+   */
+  void setCpuPlacement(CpuPlacement* cpuPlacement);
+
+  /**
+   *  @brief Count the modules, that the search has to assign
+   */
+  static int countMovableModules(Plan* plan);
+
+ private:
+  /**
+   *  @brief The stages of a job
+   */
+  JobPipeline::Task runPipeline();
+
+  /**
+   *  @brief Report the gap and the progress of a better schedule
+   */
+  void updatePenalty(int penalty, int lowerBound);
+
+  /**
+   *  @brief Return the cores of the search to the CpuPlacement
+   */
+  void releasePlacement();
+};
+
+#endif  // EXACTSCHEDULER_H
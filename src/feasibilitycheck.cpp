@@ -0,0 +1,116 @@
+#include "feasibilitycheck.h"
+
+FeasibilityCheck::Result FeasibilityCheck::check(Plan* plan) {
+  if(plan == nullptr) {
+    return Result();
+  }
+  return check(PlanIndex(plan));
+}
+
+FeasibilityCheck::Result FeasibilityCheck::check(const PlanIndex& index) {
+  Result result;
+  QVector<QVector<int>> groupModules(index.getGroupCount());
+  QVector<int> movableModules;
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(!index.isMovable(module)) {
+      continue;
+    }
+    movableModules.append(module);
+    if(index.getAdmissibleTimeslots(module).count(true) == 0) {
+      result.feasible = false;
+      result.reason = "Module " + index.getModule(module)->getNumber() + " has no timeslot, in which all its groups are active.";
+      return result;
+    }
+    for(int group : index.getGroups(module)) {
+      groupModules[group].append(module);
+    }
+  }
+
+  for(const QVector<int>& modules : groupModules) {
+    result = checkModules(index, modules, "share a group");
+    if(!result.feasible) {
+      return result;
+    }
+  }
+
+  // Modules of different groups can still conflict pairwise, like A and B in group 1, B and C in group 2 and A and C in group 3
+  QVector<int> movableConflicts(index.getModuleCount(), 0);
+  for(int module : movableModules) {
+    for(int other : index.getConflicts(module)) {
+      movableConflicts[module] += index.isMovable(other) ? 1 : 0;
+    }
+  }
+  std::stable_sort(movableModules.begin(), movableModules.end(), [&movableConflicts](int a, int b) {
+    return movableConflicts[a] > movableConflicts[b];
+  });
+  // How many members of the current clique every module conflicts with
+  QVector<int> cliqueConflicts(index.getModuleCount(), 0);
+  for(int start = 0; start < std::min<int>(cliqueSearches, movableModules.size()); start++) {
+    int firstModule = movableModules[start];
+    QVector<int> candidates;
+    for(int other : index.getConflicts(firstModule)) {
+      if(index.isMovable(other)) {
+        candidates.append(other);
+      }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [&movableConflicts](int a, int b) {
+      return movableConflicts[a] > movableConflicts[b];
+    });
+
+    QVector<int> clique{firstModule};
+    QVector<int> touchedModules;
+    auto addToClique = [&](int module) {
+      for(int other : index.getConflicts(module)) {
+        if(cliqueConflicts[other]++ == 0) {
+          touchedModules.append(other);
+        }
+      }
+    };
+    addToClique(firstModule);
+    for(int candidate : candidates) {
+      if(cliqueConflicts[candidate] == clique.size()) {
+        clique.append(candidate);
+        addToClique(candidate);
+      }
+    }
+    for(int module : touchedModules) {
+      cliqueConflicts[module] = 0;
+    }
+
+    result = checkModules(index, clique, "pairwise share groups");
+    if(!result.feasible) {
+      return result;
+    }
+  }
+  return result;
+}
+
+FeasibilityCheck::Result FeasibilityCheck::checkModules(const PlanIndex& index, const QVector<int>& modules, const QString& relation) {
+  Result result;
+  if(modules.size() < 2) {
+    return result;
+  }
+  QBitArray availableTimeslots(index.getTimeslotCount());
+  for(int module : modules) {
+    availableTimeslots |= index.getAdmissibleTimeslots(module);
+  }
+  int timeslotCount = availableTimeslots.count(true);
+  if(modules.size() > timeslotCount) {
+    result.feasible = false;
+    result.reason = "The " + QString::number(modules.size()) + " modules " + describeModules(index, modules) + " " + relation + ", but only " +
+                    QString::number(timeslotCount) + " timeslots are available to them.";
+  }
+  return result;
+}
+
+QString FeasibilityCheck::describeModules(const PlanIndex& index, const QVector<int>& modules) {
+  constexpr int listedModules = 5;
+  QStringList numbers;
+  for(int i = 0; i < std::min<int>(listedModules, modules.size()); i++) {
+    numbers.append(index.getModule(modules[i])->getNumber());
+  }
+  if(modules.size() > listedModules) {
+    numbers.append("...");
+  }
+  return numbers.join(", ");
+}
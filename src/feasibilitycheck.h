@@ -0,0 +1,58 @@
+#ifndef FEASIBILITYCHECK_H
+#define FEASIBILITYCHECK_H
+
+#include <QBitArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+
+#include "plan.h"
+#include "planindex.h"
+
+/**
+ *  @class FeasibilityCheck
+ *  @brief Finds plans, that can not be scheduled, before SPA-algorithmus is started
+ *
+ *  The check only tests necessary conditions, so a plan, that passes it, may
+ *  still be unschedulable. A plan, that fails it, can never be scheduled:
+ *  - Every module needs a timeslot, in which all its groups are active. A
+ *    module without groups can be placed in every timeslot.
+ *  - The modules of a group need different timeslots, so there have to be at
+ *    least as many timeslots available to them as there are modules
+ *  - The same holds for every set of modules, that pairwise share a group.
+ *    Such cliques are searched greedily around the modules with the most
+ *    conflicts.
+ *
+ *  Modules with the origin EIT are scheduled externally and not checked.
+ */
+class FeasibilityCheck {
+ public:
+  struct Result {
+    bool feasible = true;
+    // Why the plan can not be scheduled
+    QString reason;
+  };
+
+  // The number of modules, that a clique search starts from
+  static constexpr int cliqueSearches = 64;
+
+  /**
+   *  @brief Check if plan may be schedulable
+   */
+  static Result check(Plan* plan);
+
+  /**
+   *  @brief Check if the indexed plan may be schedulable
+   */
+  static Result check(const PlanIndex& index);
+
+ private:
+  /**
+   *  @brief Check if modules, that pairwise share a group, have enough timeslots
+   */
+  static Result checkModules(const PlanIndex& index, const QVector<int>& modules, const QString& relation);
+  static QString describeModules(const PlanIndex& index, const QVector<int>& modules);
+};
+
+#endif  // FEASIBILITYCHECK_H
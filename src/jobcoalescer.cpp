@@ -0,0 +1,90 @@
+#include "jobcoalescer.h"
+
+JobCoalescer& JobCoalescer::global() {
+  static JobCoalescer coalescer;
+  return coalescer;
+}
+
+QByteArray JobCoalescer::createKey(const QJsonObject& plan, const QString& algorithm, const QString& settings) {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(algorithm.toUtf8());
+  hash.addData("\n", 1);
+  hash.addData(settings.toUtf8());
+  hash.addData("\n", 1);
+  hash.addData(QJsonDocument(plan).toJson(QJsonDocument::Compact));
+  return hash.result();
+}
+
+void JobCoalescer::add(const QByteArray& key, const QSharedPointer<Scheduler>& scheduler, const QString& algorithm) {
+  if(scheduler.isNull()) {
+    return;
+  }
+  {
+    QMutexLocker locker(&mutex);
+    jobs.insert(key, Entry{scheduler.data(), scheduler.toWeakRef(), algorithm, 0.0, 1});
+  }
+
+  // The coalescer outlives every scheduler, so the connections need no context
+  const Scheduler* schedulerPointer = scheduler.data();
+  QObject::connect(scheduler.data(), &Scheduler::updateProgress, [this, key, schedulerPointer](double progress) {
+    QMutexLocker locker(&mutex);
+    auto job = jobs.find(key);
+    if(job != jobs.end() && job->scheduler == schedulerPointer) {
+      job->progress = progress;
+    }
+  });
+  QObject::connect(scheduler.data(), &Scheduler::finishedScheduling, [this, key, schedulerPointer]() {
+    remove(key, schedulerPointer);
+  });
+  QObject::connect(scheduler.data(), &Scheduler::failedScheduling, [this, key, schedulerPointer]() {
+    remove(key, schedulerPointer);
+  });
+  QObject::connect(scheduler.data(), &QObject::destroyed, [this, key, schedulerPointer]() {
+    remove(key, schedulerPointer);
+  });
+}
+
+JobCoalescer::Job JobCoalescer::subscribe(const QByteArray& key) {
+  QMutexLocker locker(&mutex);
+  Job job;
+  auto entry = jobs.find(key);
+  if(entry == jobs.end()) {
+    return job;
+  }
+  job.scheduler = entry->sharedScheduler.toStrongRef();
+  if(job.scheduler.isNull()) {
+    return job;
+  }
+  job.algorithm = entry->algorithm;
+  job.progress = entry->progress;
+  entry->subscribers++;
+  return job;
+}
+
+bool JobCoalescer::unsubscribe(const QByteArray& key, const Scheduler* scheduler) {
+  QMutexLocker locker(&mutex);
+  auto entry = jobs.find(key);
+  if(entry == jobs.end() || entry->scheduler != scheduler) {
+    return false;
+  }
+  entry->subscribers--;
+  if(entry->subscribers > 0) {
+    return false;
+  }
+  // The job gets stopped, so nobody may subscribe to it anymore
+  jobs.erase(entry);
+  return true;
+}
+
+int JobCoalescer::getSubscriberCount(const QByteArray& key) const {
+  QMutexLocker locker(&mutex);
+  return jobs.contains(key) ? jobs.value(key).subscribers : 0;
+}
+
+void JobCoalescer::remove(const QByteArray& key, const Scheduler* scheduler) {
+  QMutexLocker locker(&mutex);
+  auto entry = jobs.find(key);
+  if(entry != jobs.end() && entry->scheduler == scheduler) {
+    jobs.erase(entry);
+  }
+}
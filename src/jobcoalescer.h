@@ -0,0 +1,104 @@
+#ifndef JOBCOALESCER_H
+#define JOBCOALESCER_H
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QWeakPointer>
+
+#include "scheduler.h"
+
+/**
+ *  @class JobCoalescer
+ *  @brief Shares running jobs between clients, that submit the same plan
+ *
+ *  A job is identified by the SHA-256 of the plan, the requested algorithm
+ *  and the settings of the configuration, that change the result. While a
+ *  job is running, a client, that submits the same plan with the same
+ *  algorithm and settings, subscribes to it instead of starting another
+ *  scheduler. Every subscriber gets the progress and the result of the job.
+ *
+ *  A subscriber lets go, when it stops the job or disconnects. The job is
+ *  only stopped, when every subscriber has let go.
+ *
+ *  A finished or failed job is not shared anymore, the next identical
+ *  request starts a new job.
+ */
+class JobCoalescer {
+ public:
+  /**
+   *  @brief A running job
+   */
+  struct Job {
+    // nullptr, if no job is running for the key
+    QSharedPointer<Scheduler> scheduler;
+    // The resolved algorithm of the job
+    QString algorithm;
+    // The last progress of the job
+    double progress = 0.0;
+  };
+
+ private:
+  struct Entry {
+    // Only used to recognize the scheduler, it may already be deleted
+    const Scheduler* scheduler;
+    QWeakPointer<Scheduler> sharedScheduler;
+    QString algorithm;
+    double progress;
+    int subscribers;
+  };
+
+  mutable QMutex mutex;
+  QHash<QByteArray, Entry> jobs;
+
+ public:
+  /**
+   *  @brief The running jobs of the server
+   */
+  static JobCoalescer& global();
+
+  /**
+   *  @brief Get the key of a job. It serializes the plan, so large plans should be hashed in the pool.
+   *  @param [in] plan is the submitted plan
+   *  @param [in] algorithm is the requested algorithm
+   *  @param [in] settings are the settings of the job, as described by SchedulerFactory::describeSettings
+   */
+  static QByteArray createKey(const QJsonObject& plan, const QString& algorithm, const QString& settings);
+
+  /**
+   *  @brief Share a job, that was just created. The caller is its first subscriber.
+   *  @param [in] key is the key of the job
+   *  @param [in] scheduler is the scheduler of the job. It has to be added before it is started.
+   *  @param [in] algorithm is the resolved algorithm of the job
+   */
+  void add(const QByteArray& key, const QSharedPointer<Scheduler>& scheduler, const QString& algorithm);
+
+  /**
+   *  @brief Subscribe to the running job with key
+   *  @return The job. Its scheduler is nullptr, if no job with key is running.
+   */
+  Job subscribe(const QByteArray& key);
+
+  /**
+   *  @brief Let go of a job
+   *  @param [in] key is the key of the job
+   *  @param [in] scheduler is the scheduler of the job
+   *  @return A boolean indicating if the caller was the last subscriber of the running job and should stop it
+   */
+  bool unsubscribe(const QByteArray& key, const Scheduler* scheduler);
+
+  /**
+   *  @brief Get the number of subscribers of the running job with key
+   */
+  int getSubscriberCount(const QByteArray& key) const;
+
+ private:
+  void remove(const QByteArray& key, const Scheduler* scheduler);
+};
+
+#endif  // JOBCOALESCER_H
@@ -0,0 +1,300 @@
+#include "jobjournal.h"
+
+JobJournal::JobJournal(const QDir& storagePath, QObject* parent)
+    : QObject(parent), storagePath(storagePath), journalFile(storagePath.filePath(journalFileName)), jobLifetime(-1) {
+  syncTimer.setSingleShot(true);
+  syncTimer.setInterval(syncInterval);
+  connect(&syncTimer, &QTimer::timeout, this, &JobJournal::sync);
+  expiryTimer.setInterval(expiryInterval);
+  connect(&expiryTimer, &QTimer::timeout, this, &JobJournal::removeExpiredJobs);
+}
+
+JobJournal::~JobJournal() {
+  sync();
+}
+
+bool JobJournal::open(int jobLifetime) {
+  if(!storagePath.mkpath("plans") || !storagePath.mkpath("results")) {
+    return false;
+  }
+  this->jobLifetime = jobLifetime;
+  replay();
+  compact();
+  if(!journalFile.open(QFile::WriteOnly | QFile::Append)) {
+    return false;
+  }
+  expiryTimer.start();
+  return true;
+}
+
+bool JobJournal::removeExpiredJobs() {
+  // The compacted journal replaces the file, so the open file would point to the old one
+  sync();
+  journalFile.close();
+  compact();
+  return journalFile.open(QFile::WriteOnly | QFile::Append);
+}
+
+QString JobJournal::submitJob(const QJsonObject& plan, const QString& algorithm) {
+  QString id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+  // The plan has to be on disk, before the journal references it
+  if(!writeFile(planPath(id), plan)) {
+    return "";
+  }
+  submitStoredJob(id, algorithm);
+  return id;
+}
+
+void JobJournal::submitStoredJob(const QString& id, const QString& algorithm) {
+  QJsonObject record;
+  record["type"] = stateName(Submitted);
+  record["id"] = id;
+  record["algorithm"] = algorithm;
+  record["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  applyRecord(record);
+  appendRecord(record);
+}
+
+void JobJournal::startJob(const QString& id) {
+  if(!jobs.contains(id)) {
+    return;
+  }
+  QJsonObject record;
+  record["type"] = stateName(Running);
+  record["id"] = id;
+  record["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  applyRecord(record);
+  appendRecord(record);
+}
+
+void JobJournal::finishJob(const QString& id, const QJsonObject& result) {
+  if(!jobs.contains(id)) {
+    return;
+  }
+  if(!writeFile(resultPath(id), result)) {
+    failJob(id, "Failed to store the result");
+    return;
+  }
+  finishStoredJob(id);
+}
+
+void JobJournal::finishStoredJob(const QString& id) {
+  if(!jobs.contains(id)) {
+    return;
+  }
+  QJsonObject record;
+  record["type"] = stateName(Finished);
+  record["id"] = id;
+  record["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  applyRecord(record);
+  appendRecord(record);
+}
+
+void JobJournal::failJob(const QString& id, const QString& message) {
+  if(!jobs.contains(id)) {
+    return;
+  }
+  QJsonObject record;
+  record["type"] = stateName(Failed);
+  record["id"] = id;
+  record["message"] = message;
+  record["time"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+  applyRecord(record);
+  appendRecord(record);
+}
+
+void JobJournal::updateProgress(const QString& id, double progress) {
+  auto job = jobs.find(id);
+  if(job != jobs.end()) {
+    job->progress = progress;
+  }
+}
+
+bool JobJournal::containsJob(const QString& id) const {
+  return jobs.contains(id);
+}
+
+JobJournal::JobRecord JobJournal::getJob(const QString& id) const {
+  return jobs.value(id);
+}
+
+QList<JobJournal::JobRecord> JobJournal::getUnfinishedJobs() const {
+  QList<JobRecord> unfinishedJobs;
+  for(const JobRecord& job : jobs) {
+    if(job.state == Submitted || job.state == Running) {
+      unfinishedJobs.append(job);
+    }
+  }
+  std::sort(unfinishedJobs.begin(), unfinishedJobs.end(), [](const JobRecord& a, const JobRecord& b) {
+    return a.submitted < b.submitted;
+  });
+  return unfinishedJobs;
+}
+
+QJsonObject JobJournal::readPlan(const QString& id) const {
+  return readFile(planPath(id));
+}
+
+QJsonObject JobJournal::readResult(const QString& id) const {
+  return readFile(resultPath(id));
+}
+
+void JobJournal::sync() {
+  syncTimer.stop();
+  if(!journalFile.isOpen()) {
+    return;
+  }
+  journalFile.flush();
+  ::fsync(journalFile.handle());
+}
+
+void JobJournal::replay() {
+  jobs.clear();
+  QFile existingJournal(journalFile.fileName());
+  if(!existingJournal.open(QFile::ReadOnly)) {
+    return;
+  }
+  while(!existingJournal.atEnd()) {
+    QByteArray line = existingJournal.readLine();
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(line, &error);
+    // The last line may be incomplete after a crash
+    if(error.error != QJsonParseError::NoError || !document.isObject()) {
+      continue;
+    }
+    applyRecord(document.object());
+  }
+}
+
+void JobJournal::compact() {
+  QDateTime expiry = QDateTime::currentDateTimeUtc().addSecs(-jobLifetime);
+  QSaveFile compactedJournal(journalFile.fileName());
+  if(!compactedJournal.open(QFile::WriteOnly)) {
+    return;
+  }
+
+  for(auto job = jobs.begin(); job != jobs.end();) {
+    bool done = job->state == Finished || job->state == Failed;
+    if(done && jobLifetime != -1 && job->changed < expiry) {
+      QFile::remove(planPath(job->id));
+      QFile::remove(resultPath(job->id));
+      job = jobs.erase(job);
+      continue;
+    }
+
+    QJsonObject submitted;
+    submitted["type"] = stateName(Submitted);
+    submitted["id"] = job->id;
+    submitted["algorithm"] = job->algorithm;
+    submitted["time"] = job->submitted.toString(Qt::ISODateWithMs);
+    compactedJournal.write(QJsonDocument(submitted).toJson(QJsonDocument::Compact) + "\n");
+    if(job->state != Submitted) {
+      QJsonObject state;
+      state["type"] = stateName(job->state);
+      state["id"] = job->id;
+      state["time"] = job->changed.toString(Qt::ISODateWithMs);
+      if(job->state == Failed) {
+        state["message"] = job->message;
+      }
+      compactedJournal.write(QJsonDocument(state).toJson(QJsonDocument::Compact) + "\n");
+    }
+    job++;
+  }
+  compactedJournal.commit();
+}
+
+void JobJournal::applyRecord(const QJsonObject& record) {
+  QString id = record["id"].toString();
+  if(id.isEmpty()) {
+    return;
+  }
+  JobState state = stateFromName(record["type"].toString());
+  QDateTime time = QDateTime::fromString(record["time"].toString(), Qt::ISODateWithMs);
+  if(state == Submitted) {
+    JobRecord job;
+    job.id = id;
+    job.algorithm = record["algorithm"].toString();
+    job.submitted = time;
+    job.changed = time;
+    jobs.insert(id, job);
+    return;
+  }
+
+  auto job = jobs.find(id);
+  if(job == jobs.end()) {
+    return;
+  }
+  job->state = state;
+  job->changed = time;
+  job->message = record["message"].toString();
+  if(state == Finished || state == Failed) {
+    job->progress = 1.0;
+  }
+}
+
+void JobJournal::appendRecord(const QJsonObject& record) {
+  if(!journalFile.isOpen()) {
+    return;
+  }
+  journalFile.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + "\n");
+  if(!syncTimer.isActive()) {
+    syncTimer.start();
+  }
+}
+
+QString JobJournal::planPath(const QString& id) const {
+  return storagePath.filePath("plans/" + id + ".json");
+}
+
+QString JobJournal::resultPath(const QString& id) const {
+  return storagePath.filePath("results/" + id + ".json");
+}
+
+bool JobJournal::writeFile(const QString& path, const QJsonObject& content) {
+  QSaveFile file(path);
+  if(!file.open(QFile::WriteOnly)) {
+    return false;
+  }
+  file.write(QJsonDocument(content).toJson(QJsonDocument::Compact));
+  return file.commit();
+}
+
+QJsonObject JobJournal::readFile(const QString& path) {
+  QFile file(path);
+  if(!file.open(QFile::ReadOnly) || file.size() == 0) {
+    return QJsonObject();
+  }
+  // Parse from the mapping without copying the file into memory
+  uchar* data = file.map(0, file.size());
+  if(data == nullptr) {
+    return QJsonObject();
+  }
+  QJsonObject content = QJsonDocument::fromJson(QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size())).object();
+  file.unmap(data);
+  return content;
+}
+
+QString JobJournal::stateName(JobState state) {
+  switch(state) {
+    case Submitted:
+      return "submitted";
+    case Running:
+      return "running";
+    case Finished:
+      return "finished";
+    case Failed:
+    default:
+      return "failed";
+  }
+}
+
+JobJournal::JobState JobJournal::stateFromName(const QString& name) {
+  if(name == "submitted") {
+    return Submitted;
+  } else if(name == "running") {
+    return Running;
+  } else if(name == "finished") {
+    return Finished;
+  }
+  return Failed;
+}
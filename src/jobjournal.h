@@ -0,0 +1,195 @@
+#ifndef JOBJOURNAL_H
+#define JOBJOURNAL_H
+
+#include <unistd.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QSaveFile>
+#include <QString>
+#include <QTimer>
+#include <QUuid>
+#include <algorithm>
+
+/**
+ *  @class JobJournal
+ *  @brief An append-only journal of all scheduling jobs
+ *
+ *  The journal is stored in the storage path. Every line of journal.jsonl is
+ *  one JSON record, that describes the submission of a job or a state change
+ *  of a job. The submitted plan and the result of a job are stored next to the
+ *  journal in the plans and results directories.
+ *
+ *  Records are written immediately, but synced to disk in batches. A crash
+ *  loses at most the records of the last syncInterval milliseconds. The plan
+ *  and result files are synced, when they are written, so services write
+ *  them with writeFile in the pool and record them afterwards with
+ *  submitStoredJob and finishStoredJob.
+ *  After a restart the journal is replayed and unfinished jobs can be
+ *  submitted again.
+ *
+ *  Every expiryInterval milliseconds the expired jobs are removed and the
+ *  journal is rewritten with one record per state, so it does not grow
+ *  without bound on a long running server.
+ */
+class JobJournal: public QObject {
+  Q_OBJECT
+
+ public:
+  enum JobState { Submitted, Running, Finished, Failed };
+
+  /**
+   * @brief The JobRecord struct contains everything the journal knows about a job
+   */
+  struct JobRecord {
+    QString id;
+    QString algorithm;
+    JobState state = Submitted;
+    QDateTime submitted;
+    QDateTime changed;
+    QString message;
+    double progress = 0.0;
+  };
+
+  static constexpr auto journalFileName = "journal.jsonl";
+  static constexpr int syncInterval = 200;
+  static constexpr int expiryInterval = 3600000;
+
+ private:
+  QDir storagePath;
+  QFile journalFile;
+  QTimer syncTimer;
+  QTimer expiryTimer;
+  int jobLifetime;
+  QHash<QString, JobRecord> jobs;
+
+ public:
+  /**
+   *  @brief Creates a new JobJournal
+   *  @param [in] storagePath is the directory for the journal, the plans and the results
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit JobJournal(const QDir& storagePath, QObject* parent = nullptr);
+  ~JobJournal();
+
+  /**
+   *  @brief Replay the journal and open it for appending
+   *  @param [in] jobLifetime is the time in seconds finished jobs are kept. Older jobs are removed. -1 keeps them forever.
+   *  @return A boolean indicating if the journal was opened
+   *
+   *  Starts removing the expired jobs every expiryInterval milliseconds.
+   */
+  bool open(int jobLifetime = -1);
+
+  /**
+   *  @brief Remove the expired jobs and rewrite the journal with only the current state of every job
+   *  @return A boolean indicating if the journal is open for appending again
+   */
+  bool removeExpiredJobs();
+
+  /**
+   *  @brief Record a new job
+   *  @param [in] plan is the plan, that will be scheduled
+   *  @param [in] algorithm is the scheduling algorithm of the job
+   *  @return The id of the new job or an empty string, if the plan could not be stored
+   */
+  QString submitJob(const QJsonObject& plan, const QString& algorithm);
+
+  /**
+   *  @brief Record a new job, whose plan was already written to planPath(id)
+   *  @param [in] id is a new id, like QUuid::createUuid without braces
+   *  @param [in] algorithm is the scheduling algorithm of the job
+   */
+  void submitStoredJob(const QString& id, const QString& algorithm);
+
+  /**
+   *  @brief Record that a job started running
+   */
+  void startJob(const QString& id);
+
+  /**
+   *  @brief Record the result of a successful job
+   */
+  void finishJob(const QString& id, const QJsonObject& result);
+
+  /**
+   *  @brief Record the success of a job, whose result was already written to resultPath(id)
+   */
+  void finishStoredJob(const QString& id);
+
+  /**
+   *  @brief Record that a job failed
+   */
+  void failJob(const QString& id, const QString& message);
+
+  /**
+   *  @brief Update the progress of a job. The progress is not written to disk.
+   */
+  void updateProgress(const QString& id, double progress);
+
+  /**
+   *  @brief Check if the journal contains the job id
+   */
+  bool containsJob(const QString& id) const;
+
+  /**
+   *  @brief Get the record of a job
+   */
+  JobRecord getJob(const QString& id) const;
+
+  /**
+   *  @brief Get every job, that was submitted or running, when the journal was last written
+   */
+  QList<JobRecord> getUnfinishedJobs() const;
+
+  /**
+   *  @brief Read the plan, that was submitted with a job
+   */
+  QJsonObject readPlan(const QString& id) const;
+
+  /**
+   *  @brief Get the path of the file containing the plan of a job. Use it to read large plans with a PlanReader.
+   */
+  QString planPath(const QString& id) const;
+
+  /**
+   *  @brief Get the path of the file containing the result of a job
+   */
+  QString resultPath(const QString& id) const;
+
+  /**
+   *  @brief Write content to path and sync it to disk
+   *  @return A boolean indicating if the file was written
+   *
+   *  It does not use the journal, so it can run in the pool.
+   */
+  static bool writeFile(const QString& path, const QJsonObject& content);
+
+  /**
+   *  @brief Read the result of a finished job
+   */
+  QJsonObject readResult(const QString& id) const;
+
+  /**
+   *  @brief Write all pending records to disk
+   */
+  void sync();
+
+ private:
+  void replay();
+  void compact();
+  void applyRecord(const QJsonObject& record);
+  void appendRecord(const QJsonObject& record);
+  static QJsonObject readFile(const QString& path);
+  static QString stateName(JobState state);
+  static JobState stateFromName(const QString& name);
+};
+
+#endif  // JOBJOURNAL_H
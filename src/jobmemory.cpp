@@ -0,0 +1,92 @@
+#include "jobmemory.h"
+
+std::atomic<bool> JobMemory::trimPending(false);
+std::atomic<qint64> JobMemory::lastTrim(0);
+
+JobMemory::JobMemory(): baseline(0), peak(0), started(false), running(false) {}
+
+JobMemory::~JobMemory() {
+  // The members of the scheduler, like its plan, are already destroyed
+  if(started) {
+    releaseFreedMemory();
+  }
+}
+
+void JobMemory::start() {
+  baseline = getHeapBytes();
+  peak = 0;
+  started = true;
+  running = true;
+}
+
+void JobMemory::sample() {
+  if(!running) {
+    return;
+  }
+  qint64 growth = getHeapBytes() - baseline;
+  qint64 currentPeak = peak;
+  while(growth > currentPeak && !peak.compare_exchange_weak(currentPeak, growth)) {
+  }
+}
+
+void JobMemory::finish() {
+  if(!running) {
+    return;
+  }
+  sample();
+  running = false;
+  releaseFreedMemory();
+}
+
+qint64 JobMemory::getPeakProcessHeapGrowth() const {
+  return peak;
+}
+
+qint64 JobMemory::getHeapBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  // Small blocks are allocated in the heaps, large blocks are mapped separately
+  return qint64(info.uordblks) + qint64(info.hblkhd);
+#else
+  return 0;
+#endif
+}
+
+qint64 JobMemory::getResidentBytes() {
+  // The second field of statm is the number of resident pages
+  QFile statm("/proc/self/statm");
+  if(!statm.open(QFile::ReadOnly)) {
+    return 0;
+  }
+  QList<QByteArray> fields = statm.readAll().split(' ');
+  if(fields.size() < 2) {
+    return 0;
+  }
+  return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+}
+
+void JobMemory::releaseFreedMemory() {
+#ifdef __GLIBC__
+  if(trimPending.exchange(true)) {
+    // The pending trim releases the memory of this job, too
+    return;
+  }
+  qint64 delay = std::max<qint64>(0, lastTrim + minTrimInterval - QDateTime::currentMSecsSinceEpoch());
+  QTimer::singleShot(delay, []() {
+    QtConcurrent::run([]() {
+      // Memory freed after this point needs another trim
+      trimPending = false;
+      malloc_trim(0);
+      lastTrim = QDateTime::currentMSecsSinceEpoch();
+    });
+  });
+#endif
+}
+
+void JobMemory::limitArenas(int arenas) {
+#ifdef __GLIBC__
+  if(arenas > 0) {
+    mallopt(M_ARENA_MAX, arenas);
+  }
+#endif
+}
@@ -0,0 +1,111 @@
+#ifndef JOBMEMORY_H
+#define JOBMEMORY_H
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QList>
+#include <QTimer>
+#include <QtConcurrent>
+#include <QtGlobal>
+#include <algorithm>
+#include <atomic>
+
+/**
+ *  @class JobMemory
+ *  @brief Accounts the heap of a job and gives the memory freed by the job back to the system
+ *
+ *  A job allocates the object graph of its plan, the JSON of the plan and of
+ *  the result, the CSV files and the log lines of SPA-algorithmus. These are
+ *  freed, when the job ends, but glibc keeps the freed memory in the heaps of
+ *  the threads, that allocated it. Over many jobs the resident memory of the
+ *  server creeps up. Every job requests to return the freed memory to the
+ *  system, when it finishes and when its scheduler is destroyed. Trimming the
+ *  heaps walks all of them, so it runs in the QThreadPool and at most once per
+ *  minTrimInterval. The requests of the jobs, that end in between, are served
+ *  by the next trim. limitArenas additionally limits the number of heaps, so
+ *  the freed memory is reused by the next job instead of staying in the heap
+ *  of an idle thread.
+ *
+ *  The peak process heap growth of a job is the growth of the heap of the whole
+ *  process between the start of the job and the highest sample. Samples are
+ *  taken inside the stages, while their temporary data is alive, and once
+ *  more, when the job ends. The heap is shared by every job of the server, so
+ *  with concurrent jobs the growth includes theirs, too. The heap is read with
+ *  mallinfo2, so it is always 0 with glibc older than 2.33.
+ */
+class JobMemory {
+ public:
+  static constexpr qint64 minTrimInterval = 1000;
+
+ private:
+  // Set while a trim is scheduled, that has not started yet
+  static std::atomic<bool> trimPending;
+  // The time of the last trim in milliseconds since epoch
+  static std::atomic<qint64> lastTrim;
+
+  std::atomic<qint64> baseline;
+  std::atomic<qint64> peak;
+  bool started;
+  std::atomic<bool> running;
+
+ public:
+  JobMemory();
+
+  /**
+   *  @brief Requests to give the memory freed by the last job back to the system
+   */
+  ~JobMemory();
+
+  /**
+   *  @brief Start accounting a new job
+   */
+  void start();
+
+  /**
+   *  @brief Update the peak of the running job. May be called from any thread.
+   */
+  void sample();
+
+  /**
+   *  @brief Take the last sample and request to give the memory freed by the job back to the system
+   */
+  void finish();
+
+  /**
+   *  @brief Get the peak growth of the heap of the process during the current or the last job in bytes
+   *
+   *  The growth includes the allocations of concurrent jobs. It is 0 with glibc older than 2.33.
+   */
+  qint64 getPeakProcessHeapGrowth() const;
+
+  /**
+   *  @brief Get the bytes, that are allocated on the heap of this process
+   */
+  static qint64 getHeapBytes();
+
+  /**
+   *  @brief Get the resident memory of this process in bytes
+   */
+  static qint64 getResidentBytes();
+
+  /**
+   *  @brief Give the free memory of the heaps back to the system in the QThreadPool
+   *
+   *  Trims at most once per minTrimInterval milliseconds. Has to be called from a thread with an event loop.
+   */
+  static void releaseFreedMemory();
+
+  /**
+   *  @brief Limit the number of heaps, that the threads of this process allocate from
+   *  @param [in] arenas is the maximum number of heaps. 0 keeps the default of glibc, that is eight per core.
+   *
+   *  Has to be called before the threads of the process are started, a thread keeps its heap.
+   */
+  static void limitArenas(int arenas);
+};
+
+#endif  // JOBMEMORY_H
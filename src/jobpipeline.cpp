@@ -0,0 +1,28 @@
+#include "jobpipeline.h"
+
+JobPipeline::Task::Task(std::coroutine_handle<promise_type> handle): handle(handle) {}
+
+JobPipeline::Task::Task(Task&& other) noexcept: handle(std::exchange(other.handle, nullptr)) {}
+
+JobPipeline::Task& JobPipeline::Task::operator=(Task&& other) noexcept {
+  if(this != &other) {
+    destroy();
+    handle = std::exchange(other.handle, nullptr);
+  }
+  return *this;
+}
+
+JobPipeline::Task::~Task() {
+  destroy();
+}
+
+bool JobPipeline::Task::isRunning() const {
+  return handle && !handle.done();
+}
+
+void JobPipeline::Task::destroy() {
+  if(handle) {
+    handle.destroy();
+    handle = nullptr;
+  }
+}
@@ -0,0 +1,169 @@
+#ifndef JOBPIPELINE_H
+#define JOBPIPELINE_H
+
+#include <QFutureWatcher>
+#include <QMetaObject>
+#include <QObject>
+#include <QtConcurrent>
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+/**
+ *  @class JobPipeline
+ *  @brief Runs the stages of a job as a C++20 coroutine
+ *
+ *  A job is a coroutine returning a JobPipeline::Task. The coroutine runs on
+ *  the thread of the event loop and is suspended at every stage:
+ *  - co_await JobPipeline::runInPool(function) runs a CPU-bound or blocking
+ *    stage on the global QThreadPool and resumes with its result.
+ *  - co_await JobPipeline::waitFor(sender, signal) resumes, when sender emits
+ *    signal. This is used to wait for I/O, like a process.
+ *  While a job is suspended, the event loop answers RPC calls and runs the
+ *  stages of other jobs.
+ *
+ *  The Task owns the coroutine. Destroying a suspended Task destroys the
+ *  coroutine without resuming it. If a stage is running in the pool, the
+ *  destruction waits for it, so the stages may use the object, that owns the
+ *  Task, as long as the Task is destroyed first. The owner must not be
+ *  deleted from a slot, that is connected to a signal the coroutine emits.
+ */
+class JobPipeline {
+ public:
+  /**
+   *  @brief A running job
+   */
+  class Task {
+   public:
+    struct promise_type {
+      Task get_return_object() {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+      // The job starts immediately and runs until its first stage
+      std::suspend_never initial_suspend() noexcept {
+        return {};
+      }
+      // A finished coroutine stays suspended, so the Task can destroy it
+      std::suspend_always final_suspend() noexcept {
+        return {};
+      }
+      void return_void() {}
+      void unhandled_exception() {
+        std::terminate();
+      }
+    };
+
+   private:
+    std::coroutine_handle<promise_type> handle;
+
+   public:
+    Task() = default;
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task();
+
+    /**
+     *  @brief Check, if the job has not reached its end yet
+     */
+    bool isRunning() const;
+
+   private:
+    explicit Task(std::coroutine_handle<promise_type> handle);
+    void destroy();
+  };
+
+  /**
+   *  @brief Awaitable, that runs a function on the global QThreadPool
+   */
+  template<typename Function>
+  class PoolStage {
+    using Result = std::invoke_result_t<Function>;
+
+    Function function;
+    // Deleted later, because the coroutine is resumed from its finished signal
+    QFutureWatcher<Result>* watcher;
+
+   public:
+    explicit PoolStage(Function function): function(std::move(function)), watcher(new QFutureWatcher<Result>()) {}
+    PoolStage(const PoolStage&) = delete;
+    PoolStage& operator=(const PoolStage&) = delete;
+
+    ~PoolStage() {
+      watcher->disconnect();
+      watcher->waitForFinished();
+      watcher->deleteLater();
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      QObject::connect(watcher, &QFutureWatcherBase::finished, [handle]() {
+        handle.resume();
+      });
+      watcher->setFuture(QtConcurrent::run(std::move(function)));
+    }
+
+    Result await_resume() {
+      if constexpr(std::is_void_v<Result>) {
+        return;
+      } else {
+        return watcher->result();
+      }
+    }
+  };
+
+  /**
+   *  @brief Awaitable, that waits for a signal
+   */
+  template<typename Sender, typename Signal>
+  class SignalStage {
+    const Sender* sender;
+    Signal signal;
+    QMetaObject::Connection connection;
+
+   public:
+    SignalStage(const Sender* sender, Signal signal): sender(sender), signal(signal) {}
+    SignalStage(const SignalStage&) = delete;
+    SignalStage& operator=(const SignalStage&) = delete;
+
+    ~SignalStage() {
+      QObject::disconnect(connection);
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      connection = QObject::connect(sender, signal, [this, handle]() {
+        QObject::disconnect(connection);
+        handle.resume();
+      });
+    }
+
+    void await_resume() {}
+  };
+
+  /**
+   *  @brief Run function on the global QThreadPool and resume with its result
+   */
+  template<typename Function>
+  static PoolStage<Function> runInPool(Function function) {
+    return PoolStage<Function>(std::move(function));
+  }
+
+  /**
+   *  @brief Resume, when sender emits signal. The arguments of the signal are dropped.
+   */
+  template<typename Sender, typename Signal>
+  static SignalStage<Sender, Signal> waitFor(const Sender* sender, Signal signal) {
+    return SignalStage<Sender, Signal>(sender, signal);
+  }
+};
+
+#endif  // JOBPIPELINE_H
@@ -0,0 +1,108 @@
+#include "jobrecovery.h"
+
+JobRecovery::JobRecovery(const QSharedPointer<JobJournal>& journal,
+                         const QSharedPointer<ConfigurationProvider>& configurationProvider,
+                         QObject* parent)
+    : QObject(parent),
+      journal(journal),
+      configurationProvider(configurationProvider),
+      runningJobs(0),
+      admissionControl(nullptr),
+      retryTimer(this) {
+  retryTimer.setSingleShot(true);
+  connect(&retryTimer, &QTimer::timeout, this, &JobRecovery::startPendingJobs);
+}
+
+void JobRecovery::setAdmissionControl(AdmissionControl* admissionControl) {
+  this->admissionControl = admissionControl;
+  connect(admissionControl, &AdmissionControl::slotFreed, this, &JobRecovery::startPendingJobs, Qt::QueuedConnection);
+}
+
+int JobRecovery::resubmitUnfinishedJobs() {
+  QList<JobJournal::JobRecord> unfinishedJobs = journal->getUnfinishedJobs();
+  pendingJobs.append(unfinishedJobs);
+  startPendingJobs();
+  return unfinishedJobs.size();
+}
+
+void JobRecovery::startPendingJobs() {
+  int maxParallelJobs = configurationProvider->getConfiguration()->getMaxParallelJobs();
+  while(runningJobs < maxParallelJobs && !pendingJobs.isEmpty()) {
+    if(admissionControl != nullptr) {
+      AdmissionControl::Decision decision = admissionControl->tryStart();
+      if(!decision.admitted) {
+        // Resources can recover without a finished job, so the job is also retried after a while
+        retryTimer.start(decision.retryAfter * 1000);
+        return;
+      }
+    }
+    if(!startJob(pendingJobs.takeFirst()) && admissionControl != nullptr) {
+      admissionControl->finish();
+    }
+  }
+}
+
+bool JobRecovery::startJob(const JobJournal::JobRecord& job) {
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  PlanReader planReader(configuration->getMaxPlanSize());
+  QSharedPointer<Plan> plan = planReader.readFile(journal->planPath(job.id));
+  if(plan.isNull()) {
+    if(planReader.getError() == PlanReader::TooLarge) {
+      journal->failJob(job.id, planReader.getErrorString());
+    } else {
+      journal->failJob(job.id, "The submitted plan was lost");
+    }
+    return false;
+  }
+
+  QString algorithm = job.algorithm;
+  if(!SchedulerFactory::isValidAlgorithm(algorithm)) {
+    algorithm = AlgorithmSelector().resolve(configuration->getDefaultSchedulingAlgorithm(),
+                                            plan.get(),
+                                            configuration->getAutoLatencyTarget(),
+                                            configuration->getExactSchedulerMaxModules());
+  }
+  Scheduler* scheduler = SchedulerFactory::createScheduler(plan, algorithm, *configuration, this);
+  if(scheduler == nullptr) {
+    journal->failJob(job.id, "Unknown scheduling algorithm");
+    return false;
+  }
+
+  QString id = job.id;
+  QElapsedTimer timer;
+  connect(scheduler, &Scheduler::updateProgress, this, [this, id](double progress) {
+    journal->updateProgress(id, progress);
+  });
+  timer.start();
+  connect(scheduler, &Scheduler::finishedScheduling, this, [this, id, scheduler, timer](QSharedPointer<Plan> scheduledPlan) {
+    journal->finishJob(id, scheduledPlan->toJsonObject());
+    scheduler->deleteLater();
+    finishJob(timer.elapsed() / 1000.0);
+  });
+  connect(scheduler, &Scheduler::failedScheduling, this, [this, id, scheduler, timer](QString message) {
+    journal->failJob(id, message);
+    scheduler->deleteLater();
+    finishJob(timer.elapsed() / 1000.0);
+  });
+
+  qDebug() << "Recovering job" << id;
+  runningJobs++;
+  journal->startJob(id);
+  if(!scheduler->startScheduling()) {
+    // A synchronous failure already finished the job
+    if(journal->getJob(id).state == JobJournal::Running) {
+      journal->failJob(id, "Failed to start scheduling");
+      scheduler->deleteLater();
+      finishJob(timer.elapsed() / 1000.0);
+    }
+  }
+  return true;
+}
+
+void JobRecovery::finishJob(double runtime) {
+  runningJobs--;
+  if(admissionControl != nullptr) {
+    admissionControl->finish(runtime);
+  }
+  startPendingJobs();
+}
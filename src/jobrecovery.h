@@ -0,0 +1,79 @@
+#ifndef JOBRECOVERY_H
+#define JOBRECOVERY_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QTimer>
+
+#include "admissioncontrol.h"
+#include "algorithmselector.h"
+#include "configurationprovider.h"
+#include "jobjournal.h"
+#include "plan.h"
+#include "planreader.h"
+#include "scheduler.h"
+#include "schedulerfactory.h"
+
+/**
+ *  @class JobRecovery
+ *  @brief Runs the jobs, that were not finished, when the server stopped
+ *
+ *  The recovered jobs are read from the JobJournal and scheduled again with
+ *  their original algorithm. At most Configuration::getMaxParallelJobs jobs
+ *  are running at once. Their progress and results are written to the
+ *  journal, so clients can attach to them with SchedulerService::attachJob.
+ *
+ *  Like every other job, a recovered job has to be admitted by the
+ *  AdmissionControl. A rejected job is tried again, when a slot was freed or
+ *  after the time the AdmissionControl suggested.
+ */
+class JobRecovery: public QObject {
+  Q_OBJECT
+
+ private:
+  QSharedPointer<JobJournal> journal;
+  QSharedPointer<ConfigurationProvider> configurationProvider;
+  QList<JobJournal::JobRecord> pendingJobs;
+  int runningJobs;
+  AdmissionControl* admissionControl;
+  QTimer retryTimer;
+
+ public:
+  /**
+   *  @brief Creates a new JobRecovery
+   *  @param [in] journal is the replayed journal
+   *  @param [in] configurationProvider provides the configuration for the recovered jobs
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit JobRecovery(const QSharedPointer<JobJournal>& journal,
+                       const QSharedPointer<ConfigurationProvider>& configurationProvider,
+                       QObject* parent = nullptr);
+
+  /**
+   *  @brief Admit the recovered jobs with admissionControl
+   *  @param [in] admissionControl has to outlive this JobRecovery
+   */
+  void setAdmissionControl(AdmissionControl* admissionControl);
+
+  /**
+   *  @brief Submit every unfinished job of the journal again
+   *  @return The number of recovered jobs
+   */
+  int resubmitUnfinishedJobs();
+
+ private:
+  void startPendingJobs();
+  /**
+   *  @return A boolean indicating if the job is running
+   */
+  bool startJob(const JobJournal::JobRecord& job);
+  /**
+   *  @param [in] runtime is the runtime of the job in seconds
+   */
+  void finishJob(double runtime);
+};
+
+#endif  // JOBRECOVERY_H
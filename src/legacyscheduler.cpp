@@ -4,6 +4,7 @@ LegacyScheduler::LegacyScheduler(QSharedPointer<Plan> plan,
                                  const QString& algorithmBinary,
                                  const bool printLog,
                                  const SchedulingMode mode,
+                                 const int localSearchTime,
                                  QObject* parent)
     : Scheduler(parent),
       workingDirectory(),
@@ -12,9 +13,19 @@ LegacyScheduler::LegacyScheduler(QSharedPointer<Plan> plan,
       printLog(printLog),
       mode(mode),
       schedulerProcess(this),
-      emitedFailedOrFinished(false) {
-  prepareEnvironment();
-
+      localSearchTime(localSearchTime),
+      presolve(false),
+      processStart(0),
+      cpuPlacement(nullptr),
+      placementHeld(false),
+      emitedFailedOrFinished(false),
+      stopRequested(false),
+      initialSoftBest(-1),
+      lowerBound(-1),
+      gapCheckPending(false),
+      gapStopRequested(false),
+      localSearchInitialPenalty(-1),
+      localSearchFinalPenalty(-1) {
   QList<QString> arguments;
   arguments += "-p";
   arguments += workingDirectory.path();
@@ -37,7 +48,7 @@ LegacyScheduler::LegacyScheduler(QSharedPointer<Plan> plan,
   });
   connect(&schedulerProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
     qDebug() << "The error is: " << error;
-    emit updateProgress(1.0);
+    releasePlacement();
     switch(error) {
       case QProcess::FailedToStart:
         failScheduling("Failed to start legacy scheduler");
@@ -60,28 +71,13 @@ LegacyScheduler::LegacyScheduler(QSharedPointer<Plan> plan,
         return;
     }
   });
-  connect(&schedulerProcess,
-          QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-          this,
-          [this](int exitCode, QProcess::ExitStatus exitStatus) {
-            std::clog << "finished with code " << exitCode << "!\n";
-            emit updateProgress(1.0);
-            if(exitStatus == QProcess::CrashExit) {
-              failScheduling("LegacyScheduler crashed");
-              return;
-            }
-            if(exitCode != 0) {
-              failScheduling("LegacyScheduler did not exit with code 0");
-              return;
-            }
-            if(!readResults()) {
-              failScheduling("Failed to read plan");
-              return;
-            }
-          });
 }
 
 LegacyScheduler::~LegacyScheduler() {
+  // Waits for the running stage. The local search ends at the stop flag, so this does not wait for its time limit
+  stopRequested = true;
+  pipeline = JobPipeline::Task();
+  gapCheck = JobPipeline::Task();
   if(schedulerProcess.state() != QProcess::NotRunning) {
     schedulerProcess.terminate();
     schedulerProcess.waitForFinished(500);
@@ -89,42 +85,223 @@ LegacyScheduler::~LegacyScheduler() {
       schedulerProcess.kill();
     }
   }
+  releasePlacement();
 }
 
 bool LegacyScheduler::startScheduling() {
+  if(originalPlan == nullptr || pipeline.isRunning()) {
+    return false;
+  }
   emitedFailedOrFinished = false;
+  stopRequested = false;
+  initialSoftBest = -1;
+  lowerBound = -1;
+  interimPlan = QJsonObject();
+  gapCheckPending = false;
+  gapStopRequested = false;
+  localSearchInitialPenalty = -1;
+  localSearchFinalPenalty = -1;
+  scored = false;
   failReason = "";
-  prepareCommand = "";
+  reportedResultDirectory = "";
+  jobMemory.start();
   emit updateProgress(0.0);
-  if(!prepareEnvironment()) {
-    return false;
-  }
-  if(!executeScheduler()) {
-    return false;
-  }
+  pipeline = runPipeline();
   return true;
 }
 
 void LegacyScheduler::stopScheduling() {
+  stopRequested = true;
   schedulerProcess.terminate();
 }
 
-bool LegacyScheduler::prepareEnvironment() {
-  if(!csvHelper.writePlan(originalPlan.get())) {
-    return false;
+QJsonObject LegacyScheduler::getMetrics() const {
+  QJsonObject metrics;
+  metrics["mode"] = mode == Good ? "good" : "fast";
+  if(!placement.cpus.isEmpty()) {
+    metrics["placement"] = placement.toJsonObject();
+  } else {
+    metrics["placement"] = QJsonValue::Null;
+  }
+  if(lowerBound >= 0) {
+    metrics["lowerBound"] = lowerBound;
   } else {
-    return true;
+    metrics["lowerBound"] = QJsonValue::Null;
+  }
+  if(localSearchFinalPenalty >= 0) {
+    metrics["localSearch"] = QJsonObject{{"initialPenalty", localSearchInitialPenalty}, {"finalPenalty", localSearchFinalPenalty}};
+  } else {
+    metrics["localSearch"] = QJsonValue::Null;
+  }
+  metrics["peakProcessHeapGrowth"] = jobMemory.getPeakProcessHeapGrowth();
+  return metrics;
+}
+
+void LegacyScheduler::setCpuPlacement(CpuPlacement* cpuPlacement) {
+  this->cpuPlacement = cpuPlacement;
+}
+
+void LegacyScheduler::setPresolve(bool presolve) {
+  this->presolve = presolve;
+}
+
+JobPipeline::Task LegacyScheduler::runPipeline() {
+  QSharedPointer<Plan> plan = originalPlan;
+  QString jobTraceId = traceId;
+
+  FeasibilityCheck::Result feasibility = co_await JobPipeline::runInPool([plan, jobTraceId]() {
+    Tracer::Span span("feasibilityCheck", jobTraceId);
+    return FeasibilityCheck::check(plan.get());
+  });
+  if(!feasibility.feasible) {
+    failReason = feasibility.reason;
+    failScheduling("The plan can not be scheduled");
+    co_return;
+  }
+
+  // Only Good mode reports interim schedules, that can be compared with the bound
+  if(mode == Good) {
+    GapReference reference = co_await JobPipeline::runInPool([plan, jobTraceId]() {
+      Tracer::Span span("lowerBound", jobTraceId);
+      GapReference reference;
+      reference.lowerBound = SoftPenaltyBound::compute(PlanIndex(plan.get()));
+      reference.plan = plan->toJsonObject();
+      return reference;
+    });
+    lowerBound = reference.lowerBound;
+    interimPlan = reference.plan;
+  }
+
+  bool written = co_await JobPipeline::runInPool([this, plan, jobTraceId]() {
+    return writePlan(plan, jobTraceId);
+  });
+  if(stopRequested || !written) {
+    failScheduling(stopRequested ? "Scheduling was stopped" : "Failed to write the plan for the legacy scheduler");
+    co_return;
+  }
+
+  if(!executeScheduler()) {
+    // errorOccurred already reported the reason
+    failScheduling("Failed to start legacy scheduler");
+    co_return;
+  }
+  co_await JobPipeline::waitFor(&schedulerProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished));
+  int exitCode = schedulerProcess.exitCode();
+  std::clog << "finished with code " << exitCode << "!\n";
+  if(Tracer::global().isEnabled()) {
+    Tracer::global().complete("process", traceId, processStart, "exit code " + QString::number(exitCode));
+  }
+  releasePlacement();
+  // A running gap check keeps its own copy
+  interimPlan = QJsonObject();
+  // errorOccurred may have reported a failure already, but the process still finishes
+  if(emitedFailedOrFinished || stopRequested) {
+    failScheduling("Scheduling was stopped");
+    co_return;
+  }
+  if(schedulerProcess.exitStatus() == QProcess::CrashExit) {
+    failScheduling(gapStopRequested ? "LegacyScheduler crashed, after it was interrupted at the gap threshold" : "LegacyScheduler crashed");
+    co_return;
+  }
+  if(exitCode != 0) {
+    failScheduling("LegacyScheduler did not exit with code 0");
+    co_return;
+  }
+
+  QString resultDirectory = getResultDirectory();
+  bool scheduleRead = co_await JobPipeline::runInPool([this, plan, resultDirectory, jobTraceId]() {
+    return readSchedule(plan, resultDirectory, jobTraceId);
+  });
+  if(!scheduleRead) {
+    failReason = "Failed to read scheduling results. Maybe the algorithm was not able "
+                 "to schedule, but did not error.";
+    failScheduling("Failed to read plan");
+    co_return;
+  }
+
+  if(localSearchTime > 0) {
+    int timeLimit = localSearchTime;
+    // The search gets the cores of SPA-algorithmus, so concurrent jobs do not oversubscribe the machine
+    int threads = placement.isPlaced() ? placement.cpus.size() : 1;
+    JobMemory* memory = &jobMemory;
+    const std::atomic<bool>* stop = &stopRequested;
+    LocalSearch::Result result = co_await JobPipeline::runInPool([plan, timeLimit, threads, jobTraceId, memory, stop]() {
+      qint64 localSearchStart = Tracer::global().now();
+      PlanIndex index(plan.get());
+      LocalSearch::Result result = LocalSearch(index, index.readAssignment()).run(timeLimit, threads, stop);
+      memory->sample();
+      if(result.finalPenalty < result.initialPenalty) {
+        index.writeAssignment(result.assignment);
+      }
+      if(Tracer::global().isEnabled()) {
+        Tracer::global().complete("localSearch",
+                                  jobTraceId,
+                                  localSearchStart,
+                                  QString::number(result.initialPenalty) + " -> " + QString::number(result.finalPenalty));
+      }
+      return result;
+    });
+    localSearchInitialPenalty = result.initialPenalty;
+    localSearchFinalPenalty = result.finalPenalty;
+    emit improvedSchedule(result.initialPenalty, result.finalPenalty);
   }
+
+  score = co_await JobPipeline::runInPool([plan, jobTraceId]() {
+    Tracer::Span span("validate", jobTraceId);
+    return ScheduleEvaluator::evaluate(plan.get());
+  });
+  scored = true;
+  if(emitedFailedOrFinished || stopRequested) {
+    failScheduling("Scheduling was stopped");
+    co_return;
+  }
+  if(!score.isFeasible()) {
+    emit emitWarning("The schedule has " + QString::number(score.groupConflicts) + " group conflicts and " +
+                     QString::number(score.unscheduledModules) + " unscheduled modules");
+  }
+  emitedFailedOrFinished = true;
+  // Only reported with the result, so a client never sees a finished job without a schedule
+  emit updateProgress(1.0);
+  emit finishedScheduling(plan);
+}
+
+bool LegacyScheduler::writePlan(QSharedPointer<Plan> plan, const QString& jobTraceId) {
+  if(presolve) {
+    qint64 presolveStart = Tracer::global().now();
+    plan = presolver.presolve(plan.get());
+    if(Tracer::global().isEnabled()) {
+      Tracer::global().complete("presolve", jobTraceId, presolveStart, presolver.getStatistics().toString());
+    }
+  }
+  Tracer::Span span("writeCsv", jobTraceId);
+  bool written = csvHelper.writePlan(plan.get());
+  // The presolved plan is still alive
+  jobMemory.sample();
+  return written;
 }
 
 bool LegacyScheduler::executeScheduler() {
   std::clog << "Starting scheduling";
 
-  schedulerProcess.open();
+  // The process is pinned before it executes, so it never runs on other cores
+  if(cpuPlacement != nullptr) {
+    placement = cpuPlacement->acquire();
+    placementHeld = placement.isPlaced();
+    if(Tracer::global().isEnabled()) {
+      Tracer::global().instant("placement", traceId, QJsonDocument(placement.toJsonObject()).toJson(QJsonDocument::Compact));
+    }
+  }
+  schedulerProcess.setPlacement(placement);
 
-  schedulerProcess.waitForStarted();
+  {
+    Tracer::Span span("spawn", traceId);
+    schedulerProcess.open();
+    schedulerProcess.waitForStarted();
+  }
+  processStart = Tracer::global().now();
 
   if(schedulerProcess.state() != QProcess::Running) {
+    releasePlacement();
     return false;
   }
 
@@ -146,67 +323,138 @@ void LegacyScheduler::processLine(const QString& line, QProcess::ProcessChannel)
   if(printLog) {
     qDebug() << "Read line: " << line;
   }
-  if(line.contains("FEHLER") || (line.contains("WARNUNG") && !line.contains("WARNUNGEN")) || line.contains("kann nicht zugeteilt werden")) {
-    emit emitWarning(line);
-    return;
+  SpaLogParser::Line parsedLine = SpaLogParser::parse(line);
+  switch(parsedLine.type) {
+    case SpaLogParser::Warning:
+      emit emitWarning(line);
+      return;
+    case SpaLogParser::Stuck:
+      // The scheduler is stuck, stop it
+      if(Tracer::global().isEnabled()) {
+        Tracer::global().instant("stuckKill", traceId, line.trimmed());
+      }
+      schedulerProcess.terminate();
+      return;
+    case SpaLogParser::ResultDirectory:
+      // Good mode names the output directory with a timestamp, the results are read from there
+      if(mode == Good) {
+        reportedResultDirectory = QFileInfo(parsedLine.resultDirectory).absoluteFilePath();
+      }
+      return;
+    case SpaLogParser::SoftBest:
+      if(mode == Good) {
+        if(Tracer::global().isEnabled()) {
+          Tracer::global().instant("softBest", traceId, QString::number(parsedLine.softBest));
+        }
+        updateSoftBest(parsedLine.softBest);
+      }
+      return;
+    case SpaLogParser::Other:
+      return;
   }
+}
 
-  // Detect if the scheduler is stuck and send sigint
-  QRegularExpression schedulerStuckExpression("hängt \\([0-9][0-9]+\\)");
-  if(schedulerStuckExpression.match(line).hasMatch()) {
-    schedulerProcess.terminate();
+void LegacyScheduler::updateSoftBest(int softBest) {
+  if(initialSoftBest < 0) {
+    initialSoftBest = softBest;
   }
+  // ESoftBest is weighted by SPA-algorithmus, so it is only compared with itself and not with the SoftPenaltyBound.
+  // Progress is at least 0.05, to indicate, that it started. 1.0 is reached, when the schedule was read.
+  emit updateProgress(0.05 + 0.9 * SoftPenaltyBound::closedGap(initialSoftBest, softBest, 0));
 
-  if(mode == Good) {
-    // Detect the real location of the output directory and move it to the expected location
-    // Good mode names the output directory with a timestamp
-    QRegularExpression matchResultFolderExpression("Details in: (.*)/[^/]*");
-    auto resultFolderMatch = matchResultFolderExpression.match(line);
-    if(resultFolderMatch.hasMatch()) {
-      QString path = resultFolderMatch.captured(1);
-      QString targetPath = workingDirectory.path() + "/SPA-ERGEBNIS-PP";
-      prepareCommand = "rm -r '" + targetPath + "' ; mv '" + path + "' '" + targetPath + "'";
+  if(lowerBound < 0 || gapStopRequested) {
+    return;
+  }
+  if(gapCheck.isRunning()) {
+    gapCheckPending = true;
+    return;
+  }
+  gapCheck = checkGap();
+}
+
+JobPipeline::Task LegacyScheduler::checkGap() {
+  QJsonObject jsonPlan = interimPlan;
+  QString jobTraceId = traceId;
+  do {
+    gapCheckPending = false;
+    QString resultDirectory = getResultDirectory();
+    int penalty = co_await JobPipeline::runInPool([this, jsonPlan, resultDirectory, jobTraceId]() {
+      Tracer::Span span("rateInterimSchedule", jobTraceId);
+      return rateInterimSchedule(jsonPlan, resultDirectory);
+    });
+    // The schedule of a finished process is read by the pipeline
+    if(schedulerProcess.state() != QProcess::Running || stopRequested) {
+      co_return;
     }
+    if(penalty < 0) {
+      continue;
+    }
+    emit updateGap(penalty, lowerBound);
 
-    QRegularExpression currentBestExpression("ESoftBest: ([0-9]+)");
-    auto currentBestMatch = currentBestExpression.match(line);
-    if(currentBestMatch.hasMatch()) {
-      QString currentBestString = currentBestMatch.captured(1);
-      bool ok;
-      int currentBest = currentBestString.toInt(&ok);
-      if(ok) {
-        // Progress is at least 0.05, to indicate, that it started
-        float progress = ((1.0 - (std::clamp(currentBest, 0, 150) / 150.0)) * 0.95) + 0.05;
-        emit updateProgress(progress);
+    if(gapThreshold > 0.0 && SoftPenaltyBound::gap(penalty, lowerBound) < gapThreshold) {
+      gapStopRequested = true;
+      if(Tracer::global().isEnabled()) {
+        Tracer::global().instant("gapStop", traceId, QString::number(penalty) + " with lower bound " + QString::number(lowerBound));
       }
+      // SPA-algorithmus writes its best schedule and exits, when it is interrupted
+      kill(schedulerProcess.processId(), SIGINT);
+      co_return;
     }
-  }
+  } while(gapCheckPending);
 }
 
-bool LegacyScheduler::readResults() {
-  if(!prepareCommand.isEmpty()) {
-    system(prepareCommand.toStdString().data());
+int LegacyScheduler::rateInterimSchedule(const QJsonObject& jsonPlan, const QString& resultDirectory) const {
+  if(!QFileInfo::exists(resultDirectory + "/" + ScheduleCsvReader::scheduleFileName)) {
+    return -1;
   }
-  QSharedPointer<Plan> plan = originalPlan;
-  if(plan == nullptr) {
-    failReason = "Failed to read plan";
-    return false;
+  Plan plan;
+  plan.fromJsonObject(jsonPlan);
+  if(!ScheduleCsvReader(resultDirectory).readSchedule(&plan) || (presolve && !presolver.restore(&plan))) {
+    return -1;
   }
+  ScheduleScore score = ScheduleEvaluator::evaluate(&plan);
+  return score.isFeasible() ? score.softPenalty : -1;
+}
 
-  if(csvHelper.readSchedule(plan.get())) {
-    emit finishedScheduling(plan);
-    emitedFailedOrFinished = true;
-    return true;
+bool LegacyScheduler::readSchedule(QSharedPointer<Plan> plan, const QString& resultDirectory, const QString& jobTraceId) {
+  Tracer::Span span("readResults", jobTraceId);
+  ScheduleCsvReader scheduleReader(resultDirectory);
+  bool scheduleRead = scheduleReader.readSchedule(plan.get());
+  // The presolved plan numbers the timeslots like the original plan, only the fixed modules are missing
+  if(scheduleRead && presolve) {
+    scheduleRead = presolver.restore(plan.get());
+  }
+  jobMemory.sample();
+  // The reported directory comes from the output of the process, so only a result directory of this job is removed
+  QString workingPath = QFileInfo(workingDirectory.path()).canonicalFilePath();
+  QString canonicalResultDirectory = QFileInfo(resultDirectory).canonicalFilePath();
+  if(!workingPath.isEmpty() && canonicalResultDirectory.startsWith(workingPath + "/") &&
+     QFileInfo(canonicalResultDirectory).fileName().startsWith("SPA-ERGEBNIS-PP")) {
+    QDir(canonicalResultDirectory).removeRecursively();
   } else {
-    failReason = "Failed to read scheduling results. Maybe the algorithm was not able "
-                 "to schedule, but did not error.";
-    return false;
+    qDebug() << "Not removing the result directory" << resultDirectory << "outside of the working directory of the job";
   }
+  return scheduleRead;
+}
+
+QString LegacyScheduler::getResultDirectory() const {
+  if(!reportedResultDirectory.isEmpty() && QFileInfo(reportedResultDirectory).isDir()) {
+    return reportedResultDirectory;
+  }
+  return workingDirectory.path() + "/SPA-ERGEBNIS-PP";
+}
+
+void LegacyScheduler::releasePlacement() {
+  if(cpuPlacement != nullptr && placementHeld) {
+    cpuPlacement->release(placement);
+  }
+  placementHeld = false;
 }
 
 void LegacyScheduler::failScheduling(QString alternativeReason) {
   if(emitedFailedOrFinished == false) {
     emitedFailedOrFinished = true;
+    emit updateProgress(1.0);
     if(failReason != "") {
       emit failedScheduling(failReason);
       return;
@@ -4,13 +4,32 @@
 #include <signal.h>
 #include <unistd.h>
 
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QObject>
 #include <QProcess>
 #include <QSharedPointer>
 #include <QString>
-
+#include <QThread>
+#include <QTimer>
+#include <atomic>
+
+#include "cpuplacement.h"
+#include "feasibilitycheck.h"
+#include "jobpipeline.h"
+#include "localsearch.h"
+#include "placedprocess.h"
 #include "plancsvhelper.h"
+#include "planindex.h"
+#include "planpresolver.h"
+#include "schedulecsvreader.h"
+#include "scheduleevaluator.h"
 #include "scheduler.h"
+#include "softpenaltybound.h"
+#include "spalogparser.h"
+#include "tracer.h"
 
 /**
  *  @class LegacyScheduler
@@ -18,6 +37,21 @@
  *
  *  This class provides a scheduler implementation, which uses the legacy
  * sp-automatisch scheduler. It needs a sp-automatisch binary.
+ *
+ *  A job runs as a JobPipeline with the stages feasibility check, lower bound,
+ * presolve and CSV write, run, read, local search and validate. Every stage
+ * except run is executed on the global QThreadPool, run waits for the process
+ * without blocking the event loop.
+ *
+ *  In Good mode the progress is the share of the first ESoftBest of
+ * SPA-algorithmus, that was removed since. ESoftBest is weighted by
+ * SPA-algorithmus and not by the ScheduleEvaluator, so it is not compared with
+ * the SoftPenaltyBound. Instead, every ESoftBest makes the scheduler rate the
+ * interim schedule, that SPA-algorithmus wrote to its result directory, with
+ * the ScheduleEvaluator and report its gap to the SoftPenaltyBound. Once the
+ * gap is smaller than the gap threshold, SPA-algorithmus is interrupted with
+ * SIGINT, which makes it write its best schedule and exit. Fast mode lists no
+ * interim schedules and reports no gap.
  */
 class LegacyScheduler: public Scheduler {
   Q_OBJECT
@@ -31,28 +65,67 @@ class LegacyScheduler: public Scheduler {
   Q_DECLARE_FLAGS(SchedulingMode, SchedulingModeFlag)
 
  private:
+  /**
+   *  @brief The result of the lower bound stage
+   */
+  struct GapReference {
+    int lowerBound = -1;
+    // The plan as it was passed to SPA-algorithmus. The interim schedules are read into copies of it.
+    QJsonObject plan;
+  };
+
   QTemporaryDir workingDirectory;
   PlanCsvHelper csvHelper;
   QSharedPointer<Plan> originalPlan;
   bool printLog;
   SchedulingMode mode;
-  QProcess schedulerProcess;
+  PlacedProcess schedulerProcess;
+  int localSearchTime;
+  bool presolve;
+  PlanPresolver presolver;
+  qint64 processStart;
+  CpuPlacement* cpuPlacement;
+  // The placement stays available for the metrics, after its cores were released
+  CpuPlacement::Placement placement;
+  bool placementHeld;
 
   QString failReason;
   bool emitedFailedOrFinished;
-  QString prepareCommand;
+  // Also ends the local search, that runs in the pool
+  std::atomic<bool> stopRequested;
+  // The first ESoftBest of the job or -1, before it is reported
+  int initialSoftBest;
+  // The SoftPenaltyBound of the plan in Good mode or -1, before it is known
+  int lowerBound;
+  // Not shared with the stages of the pipeline, that change the plan
+  QJsonObject interimPlan;
+  // Another ESoftBest was reported, while the interim schedule was rated
+  bool gapCheckPending;
+  bool gapStopRequested;
+  // The soft penalty before and after the local search or -1, if it did not run
+  int localSearchInitialPenalty;
+  int localSearchFinalPenalty;
+  // Rates the interim schedules of SPA-algorithmus
+  JobPipeline::Task gapCheck;
+  // Destroyed first, because its stages use the other members
+  JobPipeline::Task pipeline;
+  // The directory, that SPA-algorithmus reported as its result directory
+  QString reportedResultDirectory;
 
  public:
   /**
    *  @brief Creates a new LegacyScheduler, that will schedule a plan
    *  @param [in] plan will be scheduled
    *  @param [in] configuration is the configuration for this scheduler
+   *  @param [in] localSearchTime is the time in milliseconds a LocalSearch improves the result. 0 disables it. The
+   * search uses the cores of the placement of the job or a single thread, if the job was not placed.
    *  @param [in] parent is the parent of this QObject
    */
   explicit LegacyScheduler(QSharedPointer<Plan> plan,
                            const QString& algorithmBinary = "./SPA-algorithmus",
                            const bool printLog = false,
                            const SchedulingMode mode = Fast,
+                           const int localSearchTime = 0,
                            QObject* parent = nullptr);
 
   ~LegacyScheduler();
@@ -60,27 +133,103 @@ class LegacyScheduler: public Scheduler {
   /**
    *  @brief Start scheduling the plan passed in the constructor
    *  @return A boolean indicating if scheduling was started
+   *
+   *  Returns false, if there is no plan or if a job is already running. Every other failure is reported with
+   * failedScheduling from the event loop. If the FeasibilityCheck finds, that the plan can not be scheduled,
+   * SPA-algorithmus is not started.
    */
   bool startScheduling() override;
 
   /**
-   * @brief Stop the running scheduling and emit result, if possible
+   * @brief Stop the running scheduling
+   *
+   * The job fails with "Scheduling was stopped", also if SPA-algorithmus already exited or the local search is running.
    */
   void stopScheduling() override;
 
+  /**
+   *  @brief Get the mode and the placement of the SPA-algorithmus process, the lower bound and the penalties of the local
+   * search
+   */
+  QJsonObject getMetrics() const override;
+
+  /**
+   *  @brief Place the SPA-algorithmus process on the cores assigned by cpuPlacement
+   *  @param [in] cpuPlacement assigns the cores. It has to outlive this scheduler. If it is nullptr, the process is not
+   * placed. A process, that gets no cores of its own, runs on the cores, that are not reserved.
+   */
+  void setCpuPlacement(CpuPlacement* cpuPlacement);
+
+  /**
+   *  @brief Pass a presolved plan to SPA-algorithmus, as described in PlanPresolver
+   *  @param [in] presolve enables presolving. It is disabled by default.
+   */
+  void setPresolve(bool presolve);
+
  private:
-  bool prepareEnvironment();
+  /**
+   *  @brief The stages of a job
+   */
+  JobPipeline::Task runPipeline();
+
+  /**
+   *  @brief Presolve the plan and write it as CSV for SPA-algorithmus. Runs in the pool.
+   *  @param [in] jobTraceId is the trace id of the job, copied when the pipeline started
+   */
+  bool writePlan(QSharedPointer<Plan> plan, const QString& jobTraceId);
 
   bool executeScheduler();
 
   void processLine(const QString& line, QProcess::ProcessChannel channel);
 
-  bool readResults();
+  /**
+   *  @brief Report the progress of a new ESoftBest and rate the interim schedule
+   */
+  void updateSoftBest(int softBest);
+
+  /**
+   *  @brief Report the gap of the interim schedule and interrupt SPA-algorithmus, if the gap is small enough
+   */
+  JobPipeline::Task checkGap();
+
+  /**
+   *  @brief Rate the schedule in resultDirectory with the ScheduleEvaluator. Runs in the pool.
+   *  @param [in] jsonPlan is the plan, that the schedule is read into
+   *  @return The soft penalty of the schedule or -1, if it could not be read or is not feasible
+   */
+  int rateInterimSchedule(const QJsonObject& jsonPlan, const QString& resultDirectory) const;
+
+  /**
+   *  @brief Read the schedule of SPA-algorithmus into plan and remove the result directory. Runs in the pool.
+   *  @param [in] jobTraceId is the trace id of the job, copied when the pipeline started
+   */
+  bool readSchedule(QSharedPointer<Plan> plan, const QString& resultDirectory, const QString& jobTraceId);
+
+  /**
+   *  @brief Get the directory containing the results of SPA-algorithmus
+   *
+   *  Good mode names the result directory with a timestamp and reports it in the log. Otherwise the results are in
+   * SPA-ERGEBNIS-PP in the working directory.
+   */
+  QString getResultDirectory() const;
+
+  /**
+   *  @brief Return the cores of the process to the CpuPlacement
+   */
+  void releasePlacement();
 
   /**
    *  @brief Emits failedScheduling with the message reason. If reason is not set, alternativeReason is used
    */
   void failScheduling(QString alternativeReason);
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, when the local search finished
+   *  @param initialPenalty is the soft penalty of the schedule of the legacy algorithm
+   *  @param finalPenalty is the soft penalty after the local search
+   */
+  void improvedSchedule(int initialPenalty, int finalPenalty);
 };
 
 #endif  // LEGACYSCHEDULER_H
@@ -0,0 +1,183 @@
+#include "localsearch.h"
+
+LocalSearch::LocalSearch(const PlanIndex& index, const QVector<int>& assignment): index(index), initialAssignment(assignment) {}
+
+LocalSearch::Result LocalSearch::run(int timeLimit, int threads, const std::atomic<bool>* stop) const {
+  threads = std::max(threads, 1);
+  // Every search gets its own pool, so a search started from another pool thread can not starve
+  QThreadPool pool;
+  pool.setMaxThreadCount(threads);
+  QList<QFuture<Result>> searches;
+  for(int thread = 0; thread < threads; thread++) {
+    quint32 seed = 0x5eed + thread;
+    searches.append(QtConcurrent::run(&pool, [this, timeLimit, seed, stop]() {
+      return search(timeLimit, seed, stop);
+    }));
+  }
+
+  Result best;
+  best.assignment = initialAssignment;
+  best.initialPenalty = penalty(initialAssignment);
+  best.finalPenalty = best.initialPenalty;
+  for(QFuture<Result>& future : searches) {
+    Result result = future.result();
+    if(result.finalPenalty < best.finalPenalty) {
+      best = result;
+    }
+  }
+  return best;
+}
+
+int LocalSearch::penalty(const QVector<int>& assignment) const {
+  Search search = createSearch();
+  for(int module = 0; module < assignment.size(); module++) {
+    if(assignment[module] != -1) {
+      place(search, module, assignment[module]);
+    }
+  }
+  return search.penalty;
+}
+
+LocalSearch::Result LocalSearch::search(int timeLimit, quint32 seed, const std::atomic<bool>* stop) const {
+  QElapsedTimer timer;
+  timer.start();
+  QRandomGenerator random(seed);
+
+  Search search = createSearch();
+  for(int module = 0; module < initialAssignment.size(); module++) {
+    if(initialAssignment[module] != -1) {
+      place(search, module, initialAssignment[module]);
+    }
+  }
+
+  Result result;
+  result.initialPenalty = search.penalty;
+  if(index.getModuleCount() > 1 && index.getTimeslotCount() > 1) {
+    for(int iteration = 0;; iteration++) {
+      // Checking the time is expensive compared to a move
+      if(iteration % 256 == 0 && (timer.elapsed() >= timeLimit || (stop != nullptr && *stop))) {
+        break;
+      }
+      if(random.bounded(2) == 0) {
+        tryMove(search, random);
+      } else {
+        trySwap(search, random);
+      }
+    }
+  }
+
+  result.assignment = search.assignment;
+  result.finalPenalty = search.penalty;
+  result.acceptedMoves = search.acceptedMoves;
+  return result;
+}
+
+LocalSearch::Search LocalSearch::createSearch() const {
+  Search search;
+  search.assignment = QVector<int>(index.getModuleCount(), -1);
+  search.groupTimeslotExams = QVector<int>(index.getGroupCount() * index.getTimeslotCount(), 0);
+  search.groupDayExams = QVector<int>(index.getGroupCount() * (index.getDayCount() + 2), 0);
+  return search;
+}
+
+bool LocalSearch::canPlace(const Search& search, int module, int timeslot) const {
+  if(!index.isAdmissible(module, timeslot)) {
+    return false;
+  }
+  for(int group : index.getGroups(module)) {
+    if(search.groupTimeslotExams[group * index.getTimeslotCount() + timeslot] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int LocalSearch::place(Search& search, int module, int timeslot) const {
+  int delta = 0;
+  int day = index.getDay(timeslot);
+  for(int group : index.getGroups(module)) {
+    search.groupTimeslotExams[group * index.getTimeslotCount() + timeslot]++;
+    delta += addExam(search, group, day);
+  }
+  search.assignment[module] = timeslot;
+  search.penalty += delta;
+  return delta;
+}
+
+int LocalSearch::unplace(Search& search, int module) const {
+  int delta = 0;
+  int timeslot = search.assignment[module];
+  int day = index.getDay(timeslot);
+  for(int group : index.getGroups(module)) {
+    search.groupTimeslotExams[group * index.getTimeslotCount() + timeslot]--;
+    delta += removeExam(search, group, day);
+  }
+  search.assignment[module] = -1;
+  search.penalty += delta;
+  return delta;
+}
+
+int LocalSearch::addExam(Search& search, int group, int day) const {
+  int* exams = search.groupDayExams.data() + group * (index.getDayCount() + 2) + day + 1;
+  int delta = ScheduleEvaluator::sameDayPenalty * exams[0] + ScheduleEvaluator::consecutiveDayPenalty * (exams[-1] + exams[1]);
+  exams[0]++;
+  return delta;
+}
+
+int LocalSearch::removeExam(Search& search, int group, int day) const {
+  int* exams = search.groupDayExams.data() + group * (index.getDayCount() + 2) + day + 1;
+  exams[0]--;
+  return -(ScheduleEvaluator::sameDayPenalty * exams[0] + ScheduleEvaluator::consecutiveDayPenalty * (exams[-1] + exams[1]));
+}
+
+bool LocalSearch::tryMove(Search& search, QRandomGenerator& random) const {
+  int module = random.bounded(index.getModuleCount());
+  int oldTimeslot = search.assignment[module];
+  int newTimeslot = random.bounded(index.getTimeslotCount());
+  if(oldTimeslot == -1 || oldTimeslot == newTimeslot || !index.isMovable(module)) {
+    return false;
+  }
+
+  int delta = unplace(search, module);
+  if(!canPlace(search, module, newTimeslot)) {
+    place(search, module, oldTimeslot);
+    return false;
+  }
+  delta += place(search, module, newTimeslot);
+  if(delta > 0) {
+    unplace(search, module);
+    place(search, module, oldTimeslot);
+    return false;
+  }
+  search.acceptedMoves++;
+  return true;
+}
+
+bool LocalSearch::trySwap(Search& search, QRandomGenerator& random) const {
+  int first = random.bounded(index.getModuleCount());
+  int second = random.bounded(index.getModuleCount());
+  int firstTimeslot = search.assignment[first];
+  int secondTimeslot = search.assignment[second];
+  if(firstTimeslot == -1 || secondTimeslot == -1 || firstTimeslot == secondTimeslot || !index.isMovable(first) ||
+     !index.isMovable(second)) {
+    return false;
+  }
+
+  int delta = unplace(search, first) + unplace(search, second);
+  if(!canPlace(search, first, secondTimeslot) || !canPlace(search, second, firstTimeslot)) {
+    place(search, first, firstTimeslot);
+    place(search, second, secondTimeslot);
+    return false;
+  }
+  delta += place(search, first, secondTimeslot);
+  delta += place(search, second, firstTimeslot);
+  if(delta > 0) {
+    unplace(search, first);
+    unplace(search, second);
+    place(search, first, firstTimeslot);
+    place(search, second, secondTimeslot);
+    return false;
+  }
+  search.acceptedMoves++;
+  return true;
+}
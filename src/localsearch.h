@@ -0,0 +1,87 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrent>
+#include <atomic>
+
+#include "planindex.h"
+#include "scheduleevaluator.h"
+
+/**
+ *  @class LocalSearch
+ *  @brief Improves the soft penalty of a feasible schedule
+ *
+ *  The search moves single exams to other timeslots and swaps the timeslots of
+ *  two exams. A move is only accepted, if it keeps every hard constraint of
+ *  the PlanIndex and does not increase the soft penalty. The soft penalty is
+ *  the same as the one of the ScheduleEvaluator.
+ *
+ *  Several independent searches with different seeds run in parallel on
+ *  copies of the assignment. The best result is returned.
+ */
+class LocalSearch {
+ public:
+  /**
+   * @brief The Result struct contains the improved assignment
+   */
+  struct Result {
+    QVector<int> assignment;
+    int initialPenalty = 0;
+    int finalPenalty = 0;
+    int acceptedMoves = 0;
+  };
+
+ private:
+  const PlanIndex& index;
+  QVector<int> initialAssignment;
+
+  // State of a single search
+  struct Search {
+    QVector<int> assignment;
+    // Number of exams of every group in every timeslot
+    QVector<int> groupTimeslotExams;
+    // Number of exams of every group on every day. Every group has an empty day before and after the plan.
+    QVector<int> groupDayExams;
+    int penalty = 0;
+    int acceptedMoves = 0;
+  };
+
+ public:
+  /**
+   *  @brief Creates a new LocalSearch
+   *  @param [in] index is the indexed plan. It has to outlive the search.
+   *  @param [in] assignment is a schedule, that keeps the hard constraints
+   */
+  LocalSearch(const PlanIndex& index, const QVector<int>& assignment);
+
+  /**
+   *  @brief Run the search
+   *  @param [in] timeLimit is the time in milliseconds the search runs
+   *  @param [in] threads is the number of independent searches
+   *  @param [in] stop ends the search early with the best assignment found so far, when it is set. It may be nullptr.
+   *  @return The best assignment found
+   */
+  Result run(int timeLimit, int threads, const std::atomic<bool>* stop = nullptr) const;
+
+  /**
+   *  @brief Calculate the soft penalty of an assignment
+   */
+  int penalty(const QVector<int>& assignment) const;
+
+ private:
+  Result search(int timeLimit, quint32 seed, const std::atomic<bool>* stop) const;
+  Search createSearch() const;
+  bool canPlace(const Search& search, int module, int timeslot) const;
+  int place(Search& search, int module, int timeslot) const;
+  int unplace(Search& search, int module) const;
+  int addExam(Search& search, int group, int day) const;
+  int removeExam(Search& search, int group, int day) const;
+  bool tryMove(Search& search, QRandomGenerator& random) const;
+  bool trySwap(Search& search, QRandomGenerator& random) const;
+};
+
+#endif  // LOCALSEARCH_H
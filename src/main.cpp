@@ -1,14 +1,68 @@
 #include <QCoreApplication>
+#include <QTimer>
 
 #include "server.h"
+#include "src/admissioncontrol.h"
+#include "src/authsettingsrevalidator.h"
+#include "src/cpuplacement.h"
+#include "src/jobmemory.h"
+#include "src/jobrecovery.h"
 #include "src/schedulerservice.h"
+#include "src/tokenverifier.h"
+#include "src/tracer.h"
 
 int main(int argc, char* argv[]) {
   QCoreApplication a(argc, argv);
-  QSharedPointer<Configuration> configuration(new Configuration(a.arguments()));
+  QSharedPointer<ConfigurationProvider> configurationProvider(new ConfigurationProvider(a.arguments()));
+  configurationProvider->watchConfigurationFile();
+  configurationProvider->watchReloadSignal();
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  // Before the thread pool starts, so every thread uses the limited heaps
+  JobMemory::limitArenas(configuration->getMallocArenas());
+  Tracer::global().setEnabled(configuration->getTracingEnabled(), configuration->getTracingBufferSize());
+  CpuPlacement::global().configure(configuration->getLegacySchedulerPlacement(),
+                                   configuration->getLegacySchedulerCoresPerJob(),
+                                   configuration->getLegacySchedulerReservedCores());
+  AdmissionControl::global().configure(configuration->getAdmissionMaxRunningJobs(),
+                                       configuration->getAdmissionMaxQueuedJobs(),
+                                       configuration->getAdmissionMaxLoad(),
+                                       configuration->getAdmissionMinAvailableMemory());
+  TokenVerifier::global().configure(
+      configuration->getPublicKey(), configuration->getIssuer(), configuration->getClaims(), configuration->getVerificationCacheSize());
+  QObject::connect(configurationProvider.data(), &ConfigurationProvider::configurationReloaded, [configurationProvider]() {
+    QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+    Tracer::global().setEnabled(configuration->getTracingEnabled(), configuration->getTracingBufferSize());
+    CpuPlacement::global().configure(configuration->getLegacySchedulerPlacement(),
+                                     configuration->getLegacySchedulerCoresPerJob(),
+                                     configuration->getLegacySchedulerReservedCores());
+    AdmissionControl::global().configure(configuration->getAdmissionMaxRunningJobs(),
+                                         configuration->getAdmissionMaxQueuedJobs(),
+                                         configuration->getAdmissionMaxLoad(),
+                                         configuration->getAdmissionMinAvailableMemory());
+    TokenVerifier::global().configure(
+        configuration->getPublicKey(), configuration->getIssuer(), configuration->getClaims(), configuration->getVerificationCacheSize());
+  });
+
+  QSharedPointer<JobJournal> journal(new JobJournal(configuration->getStoragePath()));
+  if(!journal->open(configuration->getJobLifetime())) {
+    qDebug() << "Failed to open the job journal in" << configuration->getStoragePath().path();
+    return 1;
+  }
+  QSharedPointer<AlgorithmSelector> algorithmSelector(
+      new AlgorithmSelector(configuration->getStoragePath().filePath(AlgorithmSelector::historyFileName)));
+
   jsonrpc::Server<SchedulerService> server(configuration->getPort());
-  server.setConstructorArguments(configuration);
+  server.setConstructorArguments(configurationProvider, journal, algorithmSelector);
   server.startListening();
 
+  // Everything, that is not needed to accept connections, starts after the server is listening
+  JobRecovery recovery(journal, configurationProvider);
+  recovery.setAdmissionControl(&AdmissionControl::global());
+  AuthSettingsRevalidator authSettingsRevalidator(configurationProvider);
+  QTimer::singleShot(0, [&recovery, &authSettingsRevalidator]() {
+    authSettingsRevalidator.start();
+    recovery.resubmitUnfinishedJobs();
+  });
+
   return a.exec();
 }
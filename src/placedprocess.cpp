@@ -0,0 +1,28 @@
+#include "placedprocess.h"
+
+PlacedProcess::PlacedProcess(QObject* parent): QProcess(parent), placed(false) {
+  CPU_ZERO(&cpuSet);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  setChildProcessModifier([this]() { applyInChild(); });
+#endif
+}
+
+void PlacedProcess::setPlacement(const CpuPlacement::Placement& placement) {
+  placed = !placement.cpus.isEmpty();
+  CPU_ZERO(&cpuSet);
+  for(int cpu : placement.cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+void PlacedProcess::setupChildProcess() {
+  applyInChild();
+}
+#endif
+
+void PlacedProcess::applyInChild() {
+  if(placed) {
+    sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+  }
+}
@@ -0,0 +1,43 @@
+#ifndef PLACEDPROCESS_H
+#define PLACEDPROCESS_H
+
+#include <sched.h>
+
+#include <QProcess>
+#include <QtGlobal>
+
+#include "cpuplacement.h"
+
+/**
+ *  @class PlacedProcess
+ *  @brief A QProcess, that is restricted to the cores of a placement before it executes its program
+ *
+ *  The affinity is set in the child between fork and exec, so the program never
+ *  runs on other cores and every thread it starts inherits the placement.
+ */
+class PlacedProcess: public QProcess {
+  Q_OBJECT
+
+ private:
+  bool placed;
+  // Prepared in the parent, the child must not allocate
+  cpu_set_t cpuSet;
+
+ public:
+  explicit PlacedProcess(QObject* parent = nullptr);
+
+  /**
+   *  @brief Set the cores for the next start. A placement without cores removes the restriction.
+   */
+  void setPlacement(const CpuPlacement::Placement& placement);
+
+ protected:
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+  void setupChildProcess() override;
+#endif
+
+ private:
+  void applyInChild();
+};
+
+#endif  // PLACEDPROCESS_H
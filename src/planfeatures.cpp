@@ -0,0 +1,77 @@
+#include "planfeatures.h"
+
+PlanFeatures PlanFeatures::extract(Plan* plan) {
+  PlanFeatures features;
+  if(plan == nullptr) {
+    return features;
+  }
+
+  // Number of active modules per group
+  QHash<const Group*, int> modulesPerGroup;
+  for(Module* module : plan->getModules()) {
+    if(!module->getActive()) {
+      continue;
+    }
+    features.moduleCount++;
+    for(Group* group : module->getGroups()) {
+      modulesPerGroup[group]++;
+    }
+  }
+  features.groupCount = modulesPerGroup.size();
+
+  // Every group with n modules forbids n*(n-1)/2 module pairs. Pairs sharing more than one group are counted multiple
+  // times, which is good enough for an estimate.
+  double conflictingPairs = 0.0;
+  for(int modules : modulesPerGroup) {
+    conflictingPairs += modules * (modules - 1) / 2.0;
+  }
+  double modulePairs = features.moduleCount * (features.moduleCount - 1) / 2.0;
+  if(modulePairs > 0) {
+    features.conflictDensity = std::min(conflictingPairs / modulePairs, 1.0);
+  }
+
+  for(Week* week : plan->getWeeks()) {
+    features.weekCount++;
+    for(Day* day : week->getDays()) {
+      features.dayCount++;
+      features.slotsPerDay = std::max(features.slotsPerDay, static_cast<int>(day->getTimeslots().size()));
+    }
+  }
+  return features;
+}
+
+double PlanFeatures::distance(const PlanFeatures& other) const {
+  auto logDifference = [](int a, int b) {
+    return std::log1p(a) - std::log1p(b);
+  };
+  double moduleDifference = logDifference(moduleCount, other.moduleCount);
+  double groupDifference = logDifference(groupCount, other.groupCount);
+  double dayDifference = logDifference(dayCount, other.dayCount);
+  double slotDifference = logDifference(slotsPerDay, other.slotsPerDay);
+  // The density is between 0 and 1, scale it to be comparable to the logarithmic counts
+  double densityDifference = (conflictDensity - other.conflictDensity) * 4.0;
+  return std::sqrt(moduleDifference * moduleDifference + groupDifference * groupDifference + dayDifference * dayDifference +
+                   slotDifference * slotDifference + densityDifference * densityDifference);
+}
+
+QJsonObject PlanFeatures::toJsonObject() const {
+  QJsonObject object;
+  object["moduleCount"] = moduleCount;
+  object["groupCount"] = groupCount;
+  object["conflictDensity"] = conflictDensity;
+  object["weekCount"] = weekCount;
+  object["dayCount"] = dayCount;
+  object["slotsPerDay"] = slotsPerDay;
+  return object;
+}
+
+PlanFeatures PlanFeatures::fromJsonObject(const QJsonObject& object) {
+  PlanFeatures features;
+  features.moduleCount = object["moduleCount"].toInt();
+  features.groupCount = object["groupCount"].toInt();
+  features.conflictDensity = object["conflictDensity"].toDouble();
+  features.weekCount = object["weekCount"].toInt();
+  features.dayCount = object["dayCount"].toInt();
+  features.slotsPerDay = object["slotsPerDay"].toInt();
+  return features;
+}
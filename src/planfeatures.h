@@ -0,0 +1,48 @@
+#ifndef PLANFEATURES_H
+#define PLANFEATURES_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <algorithm>
+#include <cmath>
+
+#include "plan.h"
+
+/**
+ *  @struct PlanFeatures
+ *  @brief Cheap structural features of a plan
+ *
+ *  The features are used to predict, how long scheduling a plan takes and how
+ *  good the result will be. Extracting them needs a single pass over the
+ *  modules and the timeslots.
+ */
+struct PlanFeatures {
+  // Active modules
+  int moduleCount = 0;
+  // Groups, that have at least one active module
+  int groupCount = 0;
+  // Share of module pairs, that share a group and can not be scheduled at the same time
+  double conflictDensity = 0.0;
+  int weekCount = 0;
+  int dayCount = 0;
+  // The maximum number of timeslots on a day
+  int slotsPerDay = 0;
+
+  /**
+   *  @brief Extract the features of plan
+   */
+  static PlanFeatures extract(Plan* plan);
+
+  /**
+   *  @brief The distance between two feature vectors
+   *
+   *  Counts are compared on a logarithmic scale, so a plan with 100 modules is
+   *  as far from one with 200 modules as one with 1000 is from one with 2000.
+   */
+  double distance(const PlanFeatures& other) const;
+
+  QJsonObject toJsonObject() const;
+  static PlanFeatures fromJsonObject(const QJsonObject& object);
+};
+
+#endif  // PLANFEATURES_H
@@ -0,0 +1,161 @@
+#include "planindex.h"
+
+PlanIndex::PlanIndex(Plan* plan): days(0), groups(0) {
+  if(plan == nullptr) {
+    return;
+  }
+
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        timeslots.append(timeslot);
+        timeslotDays.append(days);
+      }
+      days++;
+    }
+  }
+
+  QHash<const Group*, int> groupNumbers;
+  QVector<QVector<int>> groupModules;
+  for(Module* module : plan->getModules()) {
+    if(!module->getActive()) {
+      continue;
+    }
+    int moduleNumber = modules.size();
+    modules.append(module);
+    moduleNumbers.insert(module, moduleNumber);
+
+    QVector<int> groupsOfModule;
+    for(Group* group : module->getGroups()) {
+      auto groupNumber = groupNumbers.constFind(group);
+      if(groupNumber == groupNumbers.constEnd()) {
+        groupNumber = groupNumbers.insert(group, groups++);
+        groupModules.append(QVector<int>());
+      }
+      if(!groupsOfModule.contains(groupNumber.value())) {
+        groupsOfModule.append(groupNumber.value());
+        groupModules[groupNumber.value()].append(moduleNumber);
+      }
+    }
+    moduleGroups.append(groupsOfModule);
+  }
+
+  moduleConflicts.resize(modules.size());
+  QVector<int> lastSeenBy(modules.size(), -1);
+  for(int module = 0; module < modules.size(); module++) {
+    for(int group : moduleGroups[module]) {
+      for(int other : groupModules[group]) {
+        if(other != module && lastSeenBy[other] != module) {
+          lastSeenBy[other] = module;
+          moduleConflicts[module].append(other);
+        }
+      }
+    }
+  }
+
+  // A module is admissible in a timeslot, if all of its groups are active in that timeslot
+  QVector<QBitArray> activeGroups(timeslots.size(), QBitArray(groups));
+  for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+    for(Group* group : timeslots[timeslot]->getActiveGroups()) {
+      auto groupNumber = groupNumbers.constFind(group);
+      if(groupNumber != groupNumbers.constEnd()) {
+        activeGroups[timeslot].setBit(groupNumber.value());
+      }
+    }
+  }
+  movableModules = QBitArray(modules.size());
+  for(int module = 0; module < modules.size(); module++) {
+    QBitArray admissible(timeslots.size());
+    for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+      bool allGroupsActive = true;
+      for(int group : moduleGroups[module]) {
+        allGroupsActive &= activeGroups[timeslot].testBit(group);
+      }
+      admissible.setBit(timeslot, allGroupsActive);
+    }
+    admissibleTimeslots.append(admissible);
+    movableModules.setBit(module, modules[module]->getOrigin() != "EIT");
+  }
+}
+
+int PlanIndex::getModuleCount() const {
+  return modules.size();
+}
+
+int PlanIndex::getTimeslotCount() const {
+  return timeslots.size();
+}
+
+int PlanIndex::getDayCount() const {
+  return days;
+}
+
+int PlanIndex::getGroupCount() const {
+  return groups;
+}
+
+Module* PlanIndex::getModule(int module) const {
+  return modules[module];
+}
+
+Timeslot* PlanIndex::getTimeslot(int timeslot) const {
+  return timeslots[timeslot];
+}
+
+int PlanIndex::getModuleIndex(const Module* module) const {
+  return moduleNumbers.value(module, -1);
+}
+
+int PlanIndex::getDay(int timeslot) const {
+  return timeslotDays[timeslot];
+}
+
+const QVector<int>& PlanIndex::getGroups(int module) const {
+  return moduleGroups[module];
+}
+
+const QVector<int>& PlanIndex::getConflicts(int module) const {
+  return moduleConflicts[module];
+}
+
+bool PlanIndex::isAdmissible(int module, int timeslot) const {
+  return admissibleTimeslots[module].testBit(timeslot);
+}
+
+const QBitArray& PlanIndex::getAdmissibleTimeslots(int module) const {
+  return admissibleTimeslots[module];
+}
+
+bool PlanIndex::isMovable(int module) const {
+  return movableModules.testBit(module);
+}
+
+QVector<int> PlanIndex::readAssignment() const {
+  QVector<int> assignment(modules.size(), -1);
+  for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+    for(Module* module : timeslots[timeslot]->getModules()) {
+      int moduleNumber = getModuleIndex(module);
+      if(moduleNumber != -1 && assignment[moduleNumber] == -1) {
+        assignment[moduleNumber] = timeslot;
+      }
+    }
+  }
+  return assignment;
+}
+
+void PlanIndex::writeAssignment(const QVector<int>& assignment) const {
+  for(Timeslot* timeslot : timeslots) {
+    QList<Module*> scheduledModules = timeslot->getModules();
+    for(Module* module : scheduledModules) {
+      int moduleNumber = getModuleIndex(module);
+      if(moduleNumber != -1 && isMovable(moduleNumber)) {
+        timeslot->removeModule(module);
+      }
+    }
+  }
+  for(int module = 0; module < modules.size(); module++) {
+    if(isMovable(module) && assignment[module] != -1) {
+      timeslots[assignment[module]]->addModule(modules[module]);
+    }
+  }
+}
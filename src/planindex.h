@@ -0,0 +1,103 @@
+#ifndef PLANINDEX_H
+#define PLANINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include "plan.h"
+
+/**
+ *  @class PlanIndex
+ *  @brief A compact, indexed copy of the structure of a plan
+ *
+ *  Modules, groups and timeslots are numbered, so algorithms can work on
+ *  plain integer vectors instead of the object graph of the plan. Timeslots
+ *  are numbered over all days of all weeks. An assignment maps every module
+ *  to a timeslot or to -1, if the module is not scheduled.
+ *
+ *  Hard constraints:
+ *  - A group can only have one exam per timeslot
+ *  - A module can only be scheduled in a timeslot, where all its groups are active
+ *
+ *  Only active modules are indexed. Modules with the origin EIT are scheduled
+ *  externally, they are indexed but not movable.
+ */
+class PlanIndex {
+ private:
+  QList<Module*> modules;
+  QList<Timeslot*> timeslots;
+  QVector<int> timeslotDays;
+  int days;
+  int groups;
+  QHash<const Module*, int> moduleNumbers;
+  QVector<QVector<int>> moduleGroups;
+  QVector<QVector<int>> moduleConflicts;
+  QVector<QBitArray> admissibleTimeslots;
+  QBitArray movableModules;
+
+ public:
+  /**
+   *  @brief Creates a new PlanIndex for the structure of plan
+   *  @param [in] plan is indexed. It has to outlive the index.
+   */
+  explicit PlanIndex(Plan* plan);
+
+  int getModuleCount() const;
+  int getTimeslotCount() const;
+  int getDayCount() const;
+  int getGroupCount() const;
+
+  Module* getModule(int module) const;
+  Timeslot* getTimeslot(int timeslot) const;
+
+  /**
+   *  @brief Get the index of module or -1, if it is not indexed
+   */
+  int getModuleIndex(const Module* module) const;
+
+  /**
+   *  @brief Get the day of a timeslot. Days are numbered over all weeks.
+   */
+  int getDay(int timeslot) const;
+
+  /**
+   *  @brief Get the groups of a module
+   */
+  const QVector<int>& getGroups(int module) const;
+
+  /**
+   *  @brief Get every module, that shares a group with module
+   */
+  const QVector<int>& getConflicts(int module) const;
+
+  /**
+   *  @brief Check if module may be scheduled in timeslot
+   */
+  bool isAdmissible(int module, int timeslot) const;
+
+  /**
+   *  @brief Get the timeslots module may be scheduled in
+   */
+  const QBitArray& getAdmissibleTimeslots(int module) const;
+
+  /**
+   *  @brief Check if the scheduler may change the timeslot of module
+   */
+  bool isMovable(int module) const;
+
+  /**
+   *  @brief Read the current schedule of the plan
+   *  @return The timeslot of every module or -1, if a module is not scheduled
+   */
+  QVector<int> readAssignment() const;
+
+  /**
+   *  @brief Replace the schedule of the movable modules in the plan
+   *  @param [in] assignment contains the timeslot of every module or -1
+   */
+  void writeAssignment(const QVector<int>& assignment) const;
+};
+
+#endif  // PLANINDEX_H
@@ -0,0 +1,229 @@
+#include "planpresolver.h"
+
+QString PlanPresolver::Statistics::toString() const {
+  return QString("%1 inactive, %2 external and %3 forced modules, %4 unused and %5 merged groups, %6 dead timeslots")
+      .arg(inactiveModules)
+      .arg(externalModules)
+      .arg(forcedModules)
+      .arg(unusedGroups)
+      .arg(mergedGroups)
+      .arg(deadTimeslots);
+}
+
+QSharedPointer<Plan> PlanPresolver::presolve(Plan* plan) {
+  fixedAssignments.clear();
+  statistics = Statistics();
+  if(plan == nullptr) {
+    return nullptr;
+  }
+
+  QSharedPointer<Plan> presolvedPlan(new Plan());
+  presolvedPlan->fromJsonObject(plan->toJsonObject());
+
+  // Number the timeslots over all days of all weeks, like the PlanIndex
+  QList<Timeslot*> timeslots;
+  QVector<FixedAssignment> positions;
+  QList<Day*> days;
+  QList<Week*> weeks = presolvedPlan->getWeeks();
+  for(int week = 0; week < weeks.size(); week++) {
+    QList<Day*> daysOfWeek = weeks[week]->getDays();
+    for(int day = 0; day < daysOfWeek.size(); day++) {
+      days.append(daysOfWeek[day]);
+      QList<Timeslot*> timeslotsOfDay = daysOfWeek[day]->getTimeslots();
+      for(int slot = 0; slot < timeslotsOfDay.size(); slot++) {
+        timeslots.append(timeslotsOfDay[slot]);
+        positions.append(FixedAssignment{QString(), week, day, slot});
+      }
+    }
+  }
+
+  QVector<QSet<Group*>> activeGroups(timeslots.size());
+  QHash<Module*, QVector<int>> scheduledTimeslots;
+  for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+    for(Group* group : timeslots[timeslot]->getActiveGroups()) {
+      activeGroups[timeslot].insert(group);
+    }
+    for(Module* module : timeslots[timeslot]->getModules()) {
+      scheduledTimeslots[module].append(timeslot);
+    }
+  }
+
+  auto fix = [&](Module* module, int timeslot) {
+    FixedAssignment assignment = positions[timeslot];
+    assignment.module = module->getNumber();
+    fixedAssignments.append(assignment);
+    for(Group* group : module->getGroups()) {
+      activeGroups[timeslot].remove(group);
+    }
+  };
+  auto isAdmissible = [&activeGroups](Module* module, int timeslot) {
+    for(Group* group : module->getGroups()) {
+      if(!activeGroups[timeslot].contains(group)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  QList<Module*> openModules;
+  for(Module* module : presolvedPlan->getModules()) {
+    if(!module->getActive()) {
+      statistics.inactiveModules++;
+    } else if(module->getOrigin() == "EIT") {
+      statistics.externalModules++;
+      for(int timeslot : scheduledTimeslots.value(module)) {
+        fix(module, timeslot);
+      }
+    } else {
+      openModules.append(module);
+    }
+  }
+
+  // Fixing a module can force other modules of its groups into a single timeslot
+  bool changed = true;
+  while(changed) {
+    changed = false;
+    QList<Module*> stillOpenModules;
+    for(Module* module : openModules) {
+      // Modules without groups fit everywhere, SPA-algorithmus decides what happens to them
+      int admissibleTimeslot = -1;
+      int admissibleCount = 0;
+      for(int timeslot = 0; timeslot < timeslots.size() && admissibleCount < 2 && !module->getGroups().isEmpty(); timeslot++) {
+        if(isAdmissible(module, timeslot)) {
+          admissibleTimeslot = timeslot;
+          admissibleCount++;
+        }
+      }
+      if(admissibleCount == 1) {
+        fix(module, admissibleTimeslot);
+        statistics.forcedModules++;
+        changed = true;
+      } else {
+        stillOpenModules.append(module);
+      }
+    }
+    openModules = stillOpenModules;
+  }
+
+  // Groups are equivalent, if they have the same modules and are active in the same timeslots
+  QHash<Group*, QVector<int>> modulesOfGroups;
+  for(int module = 0; module < openModules.size(); module++) {
+    for(Group* group : openModules[module]->getGroups()) {
+      QVector<int>& modulesOfGroup = modulesOfGroups[group];
+      if(modulesOfGroup.isEmpty() || modulesOfGroup.last() != module) {
+        modulesOfGroup.append(module);
+      }
+    }
+  }
+  QHash<QPair<QVector<int>, QBitArray>, Group*> groupsBySignature;
+  QHash<Group*, Group*> representatives;
+  QList<Group*> remainingGroups;
+  for(Group* group : presolvedPlan->getGroups()) {
+    auto modulesOfGroup = modulesOfGroups.constFind(group);
+    if(modulesOfGroup == modulesOfGroups.constEnd()) {
+      statistics.unusedGroups++;
+      continue;
+    }
+    QBitArray activeTimeslots(timeslots.size());
+    for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+      activeTimeslots.setBit(timeslot, activeGroups[timeslot].contains(group));
+    }
+    QPair<QVector<int>, QBitArray> signature(modulesOfGroup.value(), activeTimeslots);
+    Group* representative = groupsBySignature.value(signature, nullptr);
+    if(representative == nullptr) {
+      groupsBySignature.insert(signature, group);
+      remainingGroups.append(group);
+      representative = group;
+    } else {
+      statistics.mergedGroups++;
+    }
+    representatives.insert(group, representative);
+  }
+
+  QSet<Module*> remainingModules;
+  for(Module* module : openModules) {
+    remainingModules.insert(module);
+    QList<Group*> groups;
+    for(Group* group : module->getGroups()) {
+      Group* representative = representatives.value(group, group);
+      if(!groups.contains(representative)) {
+        groups.append(representative);
+      }
+    }
+    module->setGroups(groups);
+  }
+  presolvedPlan->setModules(openModules);
+  presolvedPlan->setGroups(remainingGroups);
+
+  QBitArray usableTimeslots(timeslots.size());
+  for(int timeslot = 0; timeslot < timeslots.size(); timeslot++) {
+    QList<Group*> groups;
+    for(Group* group : timeslots[timeslot]->getActiveGroups()) {
+      if(activeGroups[timeslot].contains(group) && representatives.value(group) == group) {
+        groups.append(group);
+      }
+    }
+    timeslots[timeslot]->setActiveGroups(groups);
+
+    QList<Module*> modules;
+    for(Module* module : timeslots[timeslot]->getModules()) {
+      if(remainingModules.contains(module)) {
+        modules.append(module);
+      }
+    }
+    timeslots[timeslot]->setModules(modules);
+
+    for(int module = 0; module < openModules.size() && !usableTimeslots.testBit(timeslot); module++) {
+      usableTimeslots.setBit(timeslot, isAdmissible(openModules[module], timeslot));
+    }
+  }
+
+  // Only the end of a day is cut, so the numbers of the remaining timeslots do not change
+  int timeslot = 0;
+  for(Day* day : days) {
+    QList<Timeslot*> timeslotsOfDay = day->getTimeslots();
+    int usableCount = timeslotsOfDay.size();
+    while(usableCount > 1 && !usableTimeslots.testBit(timeslot + usableCount - 1)) {
+      usableCount--;
+    }
+    if(usableCount < timeslotsOfDay.size()) {
+      statistics.deadTimeslots += timeslotsOfDay.size() - usableCount;
+      day->setTimeslots(timeslotsOfDay.mid(0, usableCount));
+    }
+    timeslot += timeslotsOfDay.size();
+  }
+
+  return presolvedPlan;
+}
+
+bool PlanPresolver::restore(Plan* plan) const {
+  if(plan == nullptr) {
+    return false;
+  }
+
+  QHash<QString, Module*> modules;
+  for(Module* module : plan->getModules()) {
+    modules.insert(module->getNumber(), module);
+  }
+  QList<Week*> weeks = plan->getWeeks();
+  for(const FixedAssignment& assignment : fixedAssignments) {
+    Module* module = modules.value(assignment.module, nullptr);
+    if(module == nullptr || assignment.week >= weeks.size()) {
+      return false;
+    }
+    QList<Day*> days = weeks[assignment.week]->getDays();
+    if(assignment.day >= days.size()) {
+      return false;
+    }
+    QList<Timeslot*> timeslots = days[assignment.day]->getTimeslots();
+    if(assignment.slot >= timeslots.size()) {
+      return false;
+    }
+    timeslots[assignment.slot]->addModule(module);
+  }
+  return true;
+}
+
+const PlanPresolver::Statistics& PlanPresolver::getStatistics() const {
+  return statistics;
+}
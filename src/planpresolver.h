@@ -0,0 +1,86 @@
+#ifndef PLANPRESOLVER_H
+#define PLANPRESOLVER_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "plan.h"
+
+/**
+ *  @class PlanPresolver
+ *  @brief Shrinks a plan, before it is passed to SPA-algorithmus
+ *
+ *  The presolved plan is a copy of the plan, that only contains the part of
+ *  the problem, that is left to solve:
+ *  - Inactive modules are removed
+ *  - Modules with the origin EIT are scheduled externally. They are fixed in
+ *    their timeslots and removed.
+ *  - Modules, that fit into a single timeslot, are fixed there and removed.
+ *    This is repeated, until no module is forced anymore.
+ *  - The groups of a fixed module are not active in its timeslot anymore, so
+ *    no other module of these groups can be scheduled there.
+ *  - Groups without modules are removed. Groups with the same modules and the
+ *    same timeslots are merged.
+ *  - Timeslots at the end of a day, that no module can use, are removed. The
+ *    remaining timeslots keep their numbers, so the schedule of the presolved
+ *    plan can be read into the original plan.
+ *
+ *  After the schedule was read into the original plan, restore adds the fixed
+ *  modules back.
+ */
+class PlanPresolver {
+ public:
+  /**
+   *  @struct Statistics
+   *  @brief What the last presolve removed
+   */
+  struct Statistics {
+    int inactiveModules = 0;
+    int externalModules = 0;
+    int forcedModules = 0;
+    int unusedGroups = 0;
+    int mergedGroups = 0;
+    int deadTimeslots = 0;
+
+    QString toString() const;
+  };
+
+ private:
+  struct FixedAssignment {
+    QString module;
+    int week;
+    int day;
+    int slot;
+  };
+
+  QVector<FixedAssignment> fixedAssignments;
+  Statistics statistics;
+
+ public:
+  /**
+   *  @brief Create a presolved copy of plan
+   *  @param [in] plan is not changed
+   *  @return The presolved plan or nullptr, if plan is nullptr
+   */
+  QSharedPointer<Plan> presolve(Plan* plan);
+
+  /**
+   *  @brief Add the modules, that were fixed by the last presolve, to their timeslots
+   *  @param [in,out] plan is the plan, that was presolved
+   *  @return A boolean indicating if every fixed module was found in plan
+   */
+  bool restore(Plan* plan) const;
+
+  /**
+   *  @brief Get the statistics of the last presolve
+   */
+  const Statistics& getStatistics() const;
+};
+
+#endif  // PLANPRESOLVER_H
@@ -0,0 +1,156 @@
+#include "planreader.h"
+
+PlanReader::PlanReader(qint64 maxPlanSize): maxPlanSize(maxPlanSize), error(NoError) {}
+
+QSharedPointer<Plan> PlanReader::readFile(const QString& path) {
+  QFile file(path);
+  if(!file.open(QFile::ReadOnly)) {
+    error = ReadError;
+    return nullptr;
+  }
+  if(maxPlanSize != 0 && file.size() > maxPlanSize) {
+    error = TooLarge;
+    return nullptr;
+  }
+  if(file.size() == 0) {
+    error = ParseError;
+    return nullptr;
+  }
+
+  uchar* data = file.map(0, file.size());
+  if(data == nullptr) {
+    error = ReadError;
+    return nullptr;
+  }
+  // Parse from the mapping without copying the file into memory
+  QSharedPointer<Plan> plan = readJson(QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size()));
+  file.unmap(data);
+  return plan;
+}
+
+QSharedPointer<Plan> PlanReader::readJson(const QByteArray& json) {
+  if(maxPlanSize != 0 && json.size() > maxPlanSize) {
+    error = TooLarge;
+    return nullptr;
+  }
+  QJsonParseError parseError;
+  QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+  if(parseError.error != QJsonParseError::NoError || !document.isObject()) {
+    error = ParseError;
+    return nullptr;
+  }
+
+  QSharedPointer<Plan> plan(new Plan());
+  plan->fromJsonObject(document.object());
+  error = NoError;
+  return plan;
+}
+
+bool PlanReader::checkSize(const QJsonObject& plan) {
+  if(maxPlanSize != 0 && estimateSize(plan, maxPlanSize) > maxPlanSize) {
+    error = TooLarge;
+    return false;
+  }
+  error = NoError;
+  return true;
+}
+
+qint64 PlanReader::estimateSize(const QJsonValue& value, qint64 stopAt) {
+  qint64 size = 0;
+  addSize(value, stopAt, size);
+  return size;
+}
+
+PlanReader::Error PlanReader::getError() const {
+  return error;
+}
+
+QString PlanReader::getErrorString() const {
+  switch(error) {
+    case NoError:
+      return "";
+    case TooLarge:
+      return "The plan is larger than the maximum plan size of " + QString::number(maxPlanSize) + " bytes";
+    case ReadError:
+      return "The plan could not be read";
+    case ParseError:
+    default:
+      return "The plan is not a valid JSON object";
+  }
+}
+
+void PlanReader::addSize(const QJsonValue& value, qint64 stopAt, qint64& size) {
+  if(stopAt != 0 && size > stopAt) {
+    return;
+  }
+  switch(value.type()) {
+    case QJsonValue::Object: {
+      QJsonObject object = value.toObject();
+      // Braces and a comma per member
+      size += 2 + object.size();
+      for(auto member = object.constBegin(); member != object.constEnd(); member++) {
+        // Quotes and colon
+        size += stringSize(member.key()) + 3;
+        addSize(member.value(), stopAt, size);
+      }
+      break;
+    }
+    case QJsonValue::Array: {
+      QJsonArray array = value.toArray();
+      size += 2 + array.size();
+      for(const QJsonValue& element : array) {
+        addSize(element, stopAt, size);
+      }
+      break;
+    }
+    case QJsonValue::String:
+      size += stringSize(value.toString()) + 2;
+      break;
+    case QJsonValue::Double: {
+      double number = value.toDouble();
+      if(number != std::floor(number) || std::abs(number) >= 1e15) {
+        // The longest representation of a double
+        size += 24;
+        break;
+      }
+      // Integers are written without fraction
+      qint64 integer = std::abs(static_cast<qint64>(number));
+      size += number < 0 ? 2 : 1;
+      while(integer >= 10) {
+        integer /= 10;
+        size++;
+      }
+      break;
+    }
+    case QJsonValue::Bool:
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+    default:
+      size += 5;
+      break;
+  }
+}
+
+qint64 PlanReader::stringSize(const QString& string) {
+  // QString::size counts UTF-16 code units, but the limit is in bytes of UTF-8
+  qint64 size = 0;
+  for(const QChar character : string) {
+    ushort unicode = character.unicode();
+    if(unicode == '"' || unicode == '\\') {
+      size += 2;
+    } else if(unicode < 0x20) {
+      // Control characters are escaped as \uXXXX
+      size += 6;
+    } else if(unicode < 0x80) {
+      size += 1;
+    } else if(unicode < 0x800) {
+      size += 2;
+    } else if(character.isSurrogate()) {
+      // A surrogate pair is one four byte sequence
+      size += 2;
+    } else {
+      size += 3;
+    }
+  }
+  return size;
+}
@@ -0,0 +1,83 @@
+#ifndef PLANREADER_H
+#define PLANREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QSharedPointer>
+#include <QString>
+#include <cmath>
+
+#include "plan.h"
+
+/**
+ *  @class PlanReader
+ *  @brief Reads plans and enforces the maximum plan size
+ *
+ *  Files are checked against the maximum size before they are read and are
+ *  memory mapped instead of copied. The parsed JSON document only lives until
+ *  the plan is built from it.
+ *
+ *  Plans, that arrive as QJsonObject, are already parsed. Their size is
+ *  estimated in bytes of UTF-8 without serializing them. Raw JSON should be
+ *  passed to readJson, so the limit is checked before anything is parsed.
+ */
+class PlanReader {
+ public:
+  enum Error { NoError, TooLarge, ReadError, ParseError };
+
+ private:
+  qint64 maxPlanSize;
+  Error error;
+
+ public:
+  /**
+   *  @brief Creates a new PlanReader
+   *  @param [in] maxPlanSize is the maximum size of a plan in bytes of compact JSON. 0 disables the limit.
+   */
+  explicit PlanReader(qint64 maxPlanSize = 0);
+
+  /**
+   *  @brief Read a plan from a JSON file
+   *  @return The plan or nullptr, if the file could not be read or is too large
+   */
+  QSharedPointer<Plan> readFile(const QString& path);
+
+  /**
+   *  @brief Read a plan from JSON
+   *  @return The plan or nullptr, if json is not an object or too large
+   */
+  QSharedPointer<Plan> readJson(const QByteArray& json);
+
+  /**
+   *  @brief Check if a parsed plan is within the maximum size
+   */
+  bool checkSize(const QJsonObject& plan);
+
+  /**
+   *  @brief Estimate the size of value as compact JSON
+   *  @param [in] value is the value to measure
+   *  @param [in] stopAt stops measuring, when the size exceeds it. 0 measures everything.
+   *  @return The estimated size in bytes. If it exceeds stopAt, it is only guaranteed to be bigger than stopAt.
+   */
+  static qint64 estimateSize(const QJsonValue& value, qint64 stopAt = 0);
+
+  Error getError() const;
+
+  /**
+   *  @brief A message describing the last error
+   */
+  QString getErrorString() const;
+
+ private:
+  static void addSize(const QJsonValue& value, qint64 stopAt, qint64& size);
+  /**
+   *  @brief The size of string as JSON string content in bytes of UTF-8
+   */
+  static qint64 stringSize(const QString& string);
+};
+
+#endif  // PLANREADER_H
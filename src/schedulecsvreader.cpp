@@ -0,0 +1,152 @@
+#include "schedulecsvreader.h"
+
+ScheduleCsvReader::ScheduleCsvReader(const QString& resultDirectory): resultDirectory(resultDirectory) {}
+
+bool ScheduleCsvReader::readSchedule(Plan* plan) {
+  if(plan == nullptr) {
+    return false;
+  }
+
+  QFile scheduleFile(resultDirectory + "/" + scheduleFileName);
+  if(!scheduleFile.open(QFile::ReadOnly)) {
+    return false;
+  }
+
+  buildIndex(plan);
+
+  qint64 size = scheduleFile.size();
+  if(size > 0) {
+    const uchar* data = scheduleFile.map(0, size);
+    if(data == nullptr) {
+      return false;
+    }
+
+    const char* position = reinterpret_cast<const char*>(data);
+    const char* end = position + size;
+    bool success = true;
+    while(position < end) {
+      const char* lineEnd = static_cast<const char*>(memchr(position, '\n', end - position));
+      if(lineEnd == nullptr) {
+        lineEnd = end;
+      }
+      if(!readLine(position, lineEnd)) {
+        success = false;
+        break;
+      }
+      position = lineEnd + 1;
+    }
+
+    scheduleFile.unmap(const_cast<uchar*>(data));
+    if(!success) {
+      return false;
+    }
+  }
+
+  // SPA-algorithmus only writes an empty file, if it had nothing to schedule
+  if(rows.isEmpty()) {
+    for(Module* module : plan->getModules()) {
+      if(module->getActive()) {
+        return false;
+      }
+    }
+  }
+
+  // Remove the old schedule, before the new one gets applied
+  for(const QList<Timeslot*>& day : days) {
+    for(Timeslot* timeslot : day) {
+      timeslot->setModules(QList<Module*>());
+    }
+  }
+  for(const QPair<Timeslot*, Module*>& row : rows) {
+    row.first->addModule(row.second);
+  }
+  return true;
+}
+
+void ScheduleCsvReader::buildIndex(Plan* plan) {
+  moduleNumbers.clear();
+  moduleIndex.clear();
+  days.clear();
+  rows.clear();
+
+  QList<Module*> modules = plan->getModules();
+  moduleNumbers.reserve(modules.size());
+  moduleIndex.reserve(modules.size());
+  for(Module* module : modules) {
+    moduleNumbers.append(module->getNumber().toUtf8());
+    const QByteArray& number = moduleNumbers.last();
+    moduleIndex.insert(QLatin1String(number.constData(), number.size()), module);
+  }
+
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      days.append(day->getTimeslots());
+    }
+  }
+}
+
+bool ScheduleCsvReader::readLine(const char* begin, const char* end) {
+  if(end > begin && *(end - 1) == '\r') {
+    end--;
+  }
+  if(begin == end) {
+    return true;
+  }
+
+  // Find the borders of the required columns without copying the line
+  const char* fieldBegin[requiredColumns];
+  const char* fieldEnd[requiredColumns];
+  const char* position = begin;
+  for(int column = 0; column < requiredColumns; column++) {
+    if(position > end) {
+      return false;
+    }
+    const char* separatorPosition = static_cast<const char*>(memchr(position, separator, end - position));
+    if(separatorPosition == nullptr) {
+      separatorPosition = end;
+    }
+    fieldBegin[column] = position;
+    fieldEnd[column] = separatorPosition;
+    position = separatorPosition + 1;
+  }
+
+  int dayIndex;
+  int slotIndex;
+  if(!parseIndex(fieldBegin[dayColumn], fieldEnd[dayColumn], dayIndex) ||
+     !parseIndex(fieldBegin[slotColumn], fieldEnd[slotColumn], slotIndex)) {
+    return false;
+  }
+  if(dayIndex >= days.size() || slotIndex >= days[dayIndex].size()) {
+    return false;
+  }
+
+  auto module = moduleIndex.constFind(QLatin1String(fieldBegin[moduleNumberColumn], fieldEnd[moduleNumberColumn]));
+  if(module == moduleIndex.constEnd()) {
+    return false;
+  }
+
+  rows.append(qMakePair(days[dayIndex][slotIndex], module.value()));
+  return true;
+}
+
+bool ScheduleCsvReader::parseIndex(const char* begin, const char* end, int& index) {
+  while(begin < end && *begin == ' ') {
+    begin++;
+  }
+  if(begin == end) {
+    return false;
+  }
+  int value = 0;
+  for(; begin < end && *begin != ' '; begin++) {
+    if(*begin < '0' || *begin > '9' || value > 1000000) {
+      return false;
+    }
+    value = value * 10 + (*begin - '0');
+  }
+  if(value < 1) {
+    return false;
+  }
+  // The file counts from 1
+  index = value - 1;
+  return true;
+}
@@ -0,0 +1,67 @@
+#ifndef SCHEDULECSVREADER_H
+#define SCHEDULECSVREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QLatin1String>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <cstring>
+
+#include "plan.h"
+
+/**
+ *  @class ScheduleCsvReader
+ *  @brief Reads the schedule produced by SPA-algorithmus into a plan
+ *
+ *  The result file is memory mapped and scanned line by line. Modules are
+ *  looked up through a hash index, that is built once from the plan, so
+ *  reading the result is a single linear pass over the file.
+ *
+ *  The rows are collected first and only applied to the plan, when the whole
+ *  file was read without errors, so a broken file leaves the plan unchanged.
+ *  A file without rows is an error, unless the plan has no active modules.
+ */
+class ScheduleCsvReader {
+ public:
+  static constexpr auto scheduleFileName = "SPA-planung-pruef.csv";
+
+ private:
+  // Column layout of SPA-planung-pruef.csv. Day and slot are counted from 1, days are counted over all weeks of the plan.
+  static constexpr int dayColumn = 0;
+  static constexpr int slotColumn = 1;
+  static constexpr int moduleNumberColumn = 2;
+  static constexpr int requiredColumns = 3;
+  static constexpr char separator = ';';
+
+  QString resultDirectory;
+  // The keys of moduleIndex point into moduleNumbers, so lookups do not need to allocate
+  QVector<QByteArray> moduleNumbers;
+  QHash<QLatin1String, Module*> moduleIndex;
+  QVector<QList<Timeslot*>> days;
+  // The rows of the file, in the order they were read
+  QVector<QPair<Timeslot*, Module*>> rows;
+
+ public:
+  /**
+   *  @brief Creates a new ScheduleCsvReader
+   *  @param [in] resultDirectory is the SPA-ERGEBNIS-PP directory written by SPA-algorithmus
+   */
+  explicit ScheduleCsvReader(const QString& resultDirectory);
+
+  /**
+   *  @brief Replace the schedule of plan with the schedule from the result directory
+   *  @param [in,out] plan is the plan, that was passed to SPA-algorithmus
+   *  @return A boolean indicating if the schedule was read successfully. If it was not, plan is not changed.
+   */
+  bool readSchedule(Plan* plan);
+
+ private:
+  void buildIndex(Plan* plan);
+  bool readLine(const char* begin, const char* end);
+  static bool parseIndex(const char* begin, const char* end, int& index);
+};
+
+#endif  // SCHEDULECSVREADER_H
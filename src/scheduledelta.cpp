@@ -0,0 +1,73 @@
+#include "scheduledelta.h"
+
+QJsonObject ScheduleDelta::create(Plan* plan) {
+  QJsonObject assignments;
+  if(plan == nullptr) {
+    return QJsonObject{{"assignments", assignments}};
+  }
+
+  // Collect the timeslots per module first, so every module is inserted once
+  QHash<Module*, QJsonArray> timeslotsOfModules;
+  QList<Week*> weeks = plan->getWeeks();
+  for(int week = 0; week < weeks.size(); week++) {
+    QList<Day*> days = weeks[week]->getDays();
+    for(int day = 0; day < days.size(); day++) {
+      QList<Timeslot*> timeslots = days[day]->getTimeslots();
+      for(int slot = 0; slot < timeslots.size(); slot++) {
+        for(Module* module : timeslots[slot]->getModules()) {
+          QJsonArray& timeslotsOfModule = timeslotsOfModules[module];
+          timeslotsOfModule.append(week);
+          timeslotsOfModule.append(day);
+          timeslotsOfModule.append(slot);
+        }
+      }
+    }
+  }
+
+  for(auto timeslotsOfModule = timeslotsOfModules.constBegin(); timeslotsOfModule != timeslotsOfModules.constEnd(); timeslotsOfModule++) {
+    assignments.insert(timeslotsOfModule.key()->getNumber(), timeslotsOfModule.value());
+  }
+  return QJsonObject{{"assignments", assignments}};
+}
+
+bool ScheduleDelta::apply(const QJsonObject& delta, Plan* plan) {
+  if(plan == nullptr || !delta["assignments"].isObject()) {
+    return false;
+  }
+
+  QHash<QString, Module*> modules;
+  for(Module* module : plan->getModules()) {
+    modules.insert(module->getNumber(), module);
+  }
+  QList<QList<QList<Timeslot*>>> weeks;
+  for(Week* week : plan->getWeeks()) {
+    QList<QList<Timeslot*>> days;
+    for(Day* day : week->getDays()) {
+      QList<Timeslot*> timeslots = day->getTimeslots();
+      for(Timeslot* timeslot : timeslots) {
+        timeslot->setModules(QList<Module*>());
+      }
+      days.append(timeslots);
+    }
+    weeks.append(days);
+  }
+
+  QJsonObject assignments = delta["assignments"].toObject();
+  for(auto assignment = assignments.constBegin(); assignment != assignments.constEnd(); assignment++) {
+    Module* module = modules.value(assignment.key(), nullptr);
+    QJsonArray timeslots = assignment.value().toArray();
+    if(module == nullptr || timeslots.isEmpty() || timeslots.size() % 3 != 0) {
+      return false;
+    }
+    for(int position = 0; position < timeslots.size(); position += 3) {
+      int week = timeslots[position].toInt(-1);
+      int day = timeslots[position + 1].toInt(-1);
+      int slot = timeslots[position + 2].toInt(-1);
+      if(week < 0 || week >= weeks.size() || day < 0 || day >= weeks[week].size() || slot < 0 || slot >= weeks[week][day].size()) {
+        return false;
+      }
+      weeks[week][day][slot]->addModule(module);
+    }
+  }
+  return true;
+}
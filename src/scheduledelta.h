@@ -0,0 +1,43 @@
+#ifndef SCHEDULEDELTA_H
+#define SCHEDULEDELTA_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "plan.h"
+
+/**
+ *  @class ScheduleDelta
+ *  @brief The schedule of a plan without the plan
+ *
+ *  Scheduling only changes which modules are in which timeslot. A client, that
+ *  still has the submitted plan, only needs these assignments to get the
+ *  scheduled plan. They are a small fraction of the full plan.
+ *
+ *  The delta is an object with the module numbers as keys. The value is an
+ *  array with the week, the day and the slot of the module, counted from 0 in
+ *  the order of the plan. A module in more than one timeslot gets three more
+ *  numbers per timeslot. Modules, that are not scheduled, are missing.
+ *
+ *  {"assignments": {"B.ET.123": [0, 2, 1], "B.ET.456": [1, 0, 4]}}
+ */
+class ScheduleDelta {
+ public:
+  /**
+   *  @brief Get the assignments of the scheduled plan
+   */
+  static QJsonObject create(Plan* plan);
+
+  /**
+   *  @brief Replace the schedule of plan with the assignments of delta
+   *  @param [in] delta was created with create
+   *  @param [in,out] plan is the submitted plan
+   *  @return A boolean indicating if every assignment refers to a module and a timeslot of plan
+   *
+   *  If it fails, plan keeps the assignments up to the failing one.
+   */
+  static bool apply(const QJsonObject& delta, Plan* plan);
+};
+
+#endif  // SCHEDULEDELTA_H
@@ -0,0 +1,68 @@
+#include "scheduleevaluator.h"
+
+bool ScheduleScore::isFeasible() const {
+  return groupConflicts == 0 && unscheduledModules == 0;
+}
+
+QJsonObject ScheduleScore::toJsonObject() const {
+  QJsonObject score;
+  score["feasible"] = isFeasible();
+  score["groupConflicts"] = groupConflicts;
+  score["unscheduledModules"] = unscheduledModules;
+  score["softPenalty"] = softPenalty;
+  return score;
+}
+
+bool ScheduleScore::operator<(const ScheduleScore& other) const {
+  if(groupConflicts + unscheduledModules != other.groupConflicts + other.unscheduledModules) {
+    return groupConflicts + unscheduledModules < other.groupConflicts + other.unscheduledModules;
+  }
+  return softPenalty < other.softPenalty;
+}
+
+ScheduleScore ScheduleEvaluator::evaluate(Plan* plan) {
+  ScheduleScore score;
+  if(plan == nullptr) {
+    return score;
+  }
+
+  QHash<const Module*, int> scheduledCount;
+  // Exams per group on the previous day
+  QHash<const Group*, int> previousDayExams;
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      QHash<const Group*, int> dayExams;
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        QHash<const Group*, int> timeslotExams;
+        for(Module* module : timeslot->getModules()) {
+          if(!module->getActive()) {
+            continue;
+          }
+          scheduledCount[module]++;
+          for(Group* group : module->getGroups()) {
+            if(timeslotExams[group]++ > 0) {
+              score.groupConflicts++;
+            }
+          }
+        }
+        for(auto exams = timeslotExams.constBegin(); exams != timeslotExams.constEnd(); exams++) {
+          dayExams[exams.key()] += exams.value();
+        }
+      }
+      for(auto exams = dayExams.constBegin(); exams != dayExams.constEnd(); exams++) {
+        int count = exams.value();
+        score.softPenalty += sameDayPenalty * (count * (count - 1) / 2);
+        score.softPenalty += consecutiveDayPenalty * count * previousDayExams.value(exams.key(), 0);
+      }
+      previousDayExams = dayExams;
+    }
+  }
+
+  for(Module* module : plan->getModules()) {
+    if(module->getActive() && module->getOrigin() != "EIT" && scheduledCount.value(module, 0) != 1) {
+      score.unscheduledModules++;
+    }
+  }
+
+  return score;
+}
@@ -0,0 +1,48 @@
+#ifndef SCHEDULEEVALUATOR_H
+#define SCHEDULEEVALUATOR_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+
+#include "plan.h"
+
+/**
+ *  @struct ScheduleScore
+ *  @brief The quality of a schedule. Lower is better.
+ */
+struct ScheduleScore {
+  // Two exams of the same group in the same timeslot
+  int groupConflicts = 0;
+  // Active modules, that are not scheduled exactly once. Modules with the origin EIT are scheduled externally and not counted.
+  int unscheduledModules = 0;
+  // Penalty for exams of the same group on the same or on consecutive days
+  int softPenalty = 0;
+
+  bool isFeasible() const;
+  QJsonObject toJsonObject() const;
+  bool operator<(const ScheduleScore& other) const;
+};
+
+/**
+ *  @class ScheduleEvaluator
+ *  @brief Rates the schedule of a plan
+ *
+ *  Only active modules are rated. The soft penalty counts every pair of exams
+ *  of a group on the same day with sameDayPenalty and every pair on
+ *  consecutive days with consecutiveDayPenalty.
+ */
+class ScheduleEvaluator {
+ public:
+  static constexpr int sameDayPenalty = 10;
+  static constexpr int consecutiveDayPenalty = 1;
+
+  /**
+   *  @brief Rate the schedule of plan
+   *  @param [in] plan is the scheduled plan
+   *  @return The score of the schedule
+   */
+  static ScheduleScore evaluate(Plan* plan);
+};
+
+#endif  // SCHEDULEEVALUATOR_H
@@ -3,19 +3,33 @@
 
 #include <plan.h>
 
+#include <QJsonObject>
 #include <QSharedPointer>
 #include <QString>
 
+#include "jobmemory.h"
+#include "scheduleevaluator.h"
+
 /**
  *  @interface Scheduler
  *  @brief Schedules a plan
  *
- *  A class implementing Scheduler can schedule plans
+ *  A class implementing Scheduler can schedule plans. The heap of a job is
+ *  sampled by its stages in the pool and released, when the job finished or
+ *  failed, as described in JobMemory. Progress updates do not sample it, they
+ *  are emitted on the event loop and reading the heap walks all of its arenas.
  */
 class Scheduler: public QObject {
   Q_OBJECT
  public:
-  explicit Scheduler(QObject* parent = nullptr): QObject(parent) {}
+  explicit Scheduler(QObject* parent = nullptr): QObject(parent) {
+    connect(this, &Scheduler::finishedScheduling, this, [this]() {
+      jobMemory.finish();
+    });
+    connect(this, &Scheduler::failedScheduling, this, [this]() {
+      jobMemory.finish();
+    });
+  }
   /**
    *  @brief Start scheduling the plan passed in the constructor
    *  @return A boolean indicating if scheduling was started
@@ -27,9 +41,54 @@ class Scheduler: public QObject {
    */
   virtual void stopScheduling() = 0;
 
+  /**
+   * @brief Set the job id, under which the Tracer records the events of this scheduler
+   */
+  void setTraceId(const QString& traceId) {
+    this->traceId = traceId;
+  }
+
+  /**
+   * @brief Stop the job with its current schedule, once its optimality gap is smaller than gapThreshold
+   * @param gapThreshold is the relative gap as described in SoftPenaltyBound::gap. 0.0 never stops a job early.
+   */
+  void setGapThreshold(double gapThreshold) {
+    this->gapThreshold = gapThreshold;
+  }
+
+  /**
+   * @brief Get metrics about the current job, like the resources it uses
+   */
+  virtual QJsonObject getMetrics() const {
+    return QJsonObject();
+  }
+
+  /**
+   * @brief Check if the scheduler already rated its last schedule with the ScheduleEvaluator
+   */
+  bool hasScore() const {
+    return scored;
+  }
+
+  /**
+   * @brief Get the rating of the last schedule. Only valid, if hasScore returns true.
+   */
+  ScheduleScore getScore() const {
+    return score;
+  }
+
   // virtual destructor for interface
   virtual ~Scheduler() {}
 
+ protected:
+  QString traceId;
+  double gapThreshold = 0.0;
+  // Set by implementations, that rate their schedule before they emit finishedScheduling
+  ScheduleScore score;
+  bool scored = false;
+  // Destroyed after the members of the implementations, so it releases the memory of their plans, too
+  JobMemory jobMemory;
+
  signals:
 
   /**
@@ -38,6 +97,13 @@ class Scheduler: public QObject {
    */
   void updateProgress(double progress);
 
+  /**
+   *  @brief This signal will be emitted, when a better schedule was found
+   *  @param penalty is the soft penalty of the best schedule so far
+   *  @param lowerBound is a lower bound on the soft penalty of every schedule of the plan
+   */
+  void updateGap(int penalty, int lowerBound);
+
   /**
    *  @brief This signal will be emitted, when something may have went wrong
    *  @param progress is the current progress
@@ -0,0 +1,64 @@
+#include "schedulerfactory.h"
+
+bool SchedulerFactory::isValidAlgorithm(const QString& algorithm) {
+  return algorithm == "legacy-fast" || algorithm == "legacy-good" || algorithm == "exact";
+}
+
+Scheduler* SchedulerFactory::createScheduler(QSharedPointer<Plan> plan,
+                                             const QString& algorithm,
+                                             const Configuration& configuration,
+                                             QObject* parent) {
+  if(algorithm == "legacy-fast" || algorithm == "legacy-good") {
+    LegacyScheduler::SchedulingMode legacySchedulerMode;
+    if(algorithm == "legacy-fast") {
+      legacySchedulerMode = LegacyScheduler::Fast;
+    } else {
+      legacySchedulerMode = LegacyScheduler::Good;
+    }
+    LegacyScheduler* scheduler = new LegacyScheduler(plan,
+                                                     configuration.getLegacySchedulerAlgorithmBinary(),
+                                                     configuration.getLegacySchedulerPrintLog(),
+                                                     legacySchedulerMode,
+                                                     configuration.getLegacySchedulerLocalSearchTime(),
+                                                     parent);
+    scheduler->setPresolve(configuration.getLegacySchedulerPresolve());
+    // Only Good mode reports a gap
+    scheduler->setGapThreshold(configuration.getGapThreshold());
+    if(configuration.getLegacySchedulerPlacement() != CpuPlacement::nonePolicy) {
+      scheduler->setCpuPlacement(&CpuPlacement::global());
+    }
+    return scheduler;
+  }
+  if(algorithm == "exact") {
+    ExactScheduler* scheduler =
+        new ExactScheduler(plan, configuration.getExactSchedulerTimeLimit(), configuration.getExactSchedulerMaxModules(), parent);
+    scheduler->setGapThreshold(configuration.getGapThreshold());
+    if(configuration.getLegacySchedulerPlacement() != CpuPlacement::nonePolicy) {
+      scheduler->setCpuPlacement(&CpuPlacement::global());
+    }
+    return scheduler;
+  }
+  return nullptr;
+}
+
+QString SchedulerFactory::describeSettings(const QString& algorithm, const Configuration& configuration) {
+  // Every algorithm, that auto may select, contributes its settings
+  bool selected = !isValidAlgorithm(algorithm);
+  QStringList settings;
+  if(algorithm == "legacy-fast" || algorithm == "legacy-good" || selected) {
+    settings += "legacyBinary=" + configuration.getLegacySchedulerAlgorithmBinary();
+    settings += "localSearchTime=" + QString::number(configuration.getLegacySchedulerLocalSearchTime());
+    settings += "presolve=" + QString::number(configuration.getLegacySchedulerPresolve());
+  }
+  if(algorithm == "exact" || selected) {
+    settings += "exactTimeLimit=" + QString::number(configuration.getExactSchedulerTimeLimit());
+    settings += "exactMaxModules=" + QString::number(configuration.getExactSchedulerMaxModules());
+  }
+  if(algorithm == "legacy-good" || algorithm == "exact" || selected) {
+    settings += "gapThreshold=" + QString::number(configuration.getGapThreshold());
+  }
+  if(selected) {
+    settings += "autoLatencyTarget=" + QString::number(configuration.getAutoLatencyTarget());
+  }
+  return settings.join(';');
+}
@@ -0,0 +1,49 @@
+#ifndef SCHEDULERFACTORY_H
+#define SCHEDULERFACTORY_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+#include "configuration.h"
+#include "exactscheduler.h"
+#include "legacyscheduler.h"
+#include "plan.h"
+#include "scheduler.h"
+
+/**
+ *  @class SchedulerFactory
+ *  @brief Creates the Scheduler for a scheduling algorithm name
+ */
+class SchedulerFactory {
+ public:
+  /**
+   *  @brief Check if algorithm is the name of a known scheduling algorithm
+   *  @param [in] algorithm is the name of the scheduling algorithm
+   *  @return A boolean indicating if the algorithm is known
+   */
+  static bool isValidAlgorithm(const QString& algorithm);
+
+  /**
+   *  @brief Create a scheduler, that schedules plan with algorithm
+   *  @param [in] plan will be scheduled
+   *  @param [in] algorithm is the name of the scheduling algorithm
+   *  @param [in] configuration is the configuration for the scheduler
+   *  @param [in] parent is the parent of the new scheduler
+   *  @return The new scheduler or nullptr, if the algorithm is unknown
+   */
+  static Scheduler* createScheduler(QSharedPointer<Plan> plan,
+                                    const QString& algorithm,
+                                    const Configuration& configuration,
+                                    QObject* parent = nullptr);
+
+  /**
+   *  @brief Describe the settings of configuration, that change how algorithm schedules a plan
+   *  @param [in] algorithm is the name of the scheduling algorithm or "auto"
+   *  @return A string, that is equal for two configurations, if they schedule every plan the same way
+   */
+  static QString describeSettings(const QString& algorithm, const Configuration& configuration);
+};
+
+#endif  // SCHEDULERFACTORY_H
@@ -1,59 +1,74 @@
 #include "schedulerservice.h"
 
 SchedulerService::SchedulerService(const QSharedPointer<Configuration> configuration, QObject* parent)
-    : QObject(parent), configuration(configuration), scheduler(nullptr), progress(0.0), result(QJsonValue::Undefined) {}
+    : SchedulerService(QSharedPointer<ConfigurationProvider>(new ConfigurationProvider(configuration)), nullptr, nullptr, parent) {}
 
-bool SchedulerService::startScheduling(QJsonObject plan) {
-  if(scheduler != nullptr) {
-    return false;
+SchedulerService::SchedulerService(const QSharedPointer<ConfigurationProvider> configurationProvider,
+                                   const QSharedPointer<JobJournal> journal,
+                                   const QSharedPointer<AlgorithmSelector> algorithmSelector,
+                                   QObject* parent)
+    : QObject(parent),
+      configurationProvider(configurationProvider),
+      journal(journal),
+      algorithmSelector(algorithmSelector),
+      jobRuntime(-1.0),
+      traceStart(0),
+      scheduler(nullptr),
+      jobSubscribed(false),
+      jobCoalesced(false),
+      startStopped(false),
+      progress(0.0),
+      gapPenalty(-1),
+      gapLowerBound(-1),
+      result(QJsonValue::Undefined),
+      retryAfter(0) {
+  if(this->algorithmSelector.isNull()) {
+    this->algorithmSelector.reset(new AlgorithmSelector());
   }
+}
 
-  QSharedPointer<Plan> planPointer(new Plan());
-  planPointer->fromJsonObject(plan);
-
-  QString schedulingAlgorithm = configuration->getDefaultSchedulingAlgorithm();
-  if(!customAlgorithm.isEmpty()) {
-    schedulingAlgorithm = customAlgorithm;
+SchedulerService::~SchedulerService() {
+  if(jobStart.isRunning() && scheduler.isNull()) {
+    // The job holds a slot, but it will never start
+    AdmissionControl::global().finish();
   }
-
-  if(schedulingAlgorithm.startsWith("legacy")) {
-    LegacyScheduler::SchedulingMode legacySchedulerMode;
-    if(schedulingAlgorithm == "legacy-fast") {
-      legacySchedulerMode = LegacyScheduler::Fast;
-    } else {
-      legacySchedulerMode = LegacyScheduler::Good;
+  // Nobody can retrieve the result of the job anymore, so it must not be recovered after a restart
+  if(!journal.isNull() && !jobId.isEmpty() && !scheduler.isNull()) {
+    JobJournal::JobState state = journal->getJob(jobId).state;
+    if(state == JobJournal::Submitted || state == JobJournal::Running) {
+      journal->failJob(jobId, "The client disconnected before the job finished");
     }
-    scheduler.reset(new LegacyScheduler(planPointer,
-                                        configuration->getLegacySchedulerAlgorithmBinary(),
-                                        configuration->getLegacySchedulerPrintLog(),
-                                        legacySchedulerMode));
-  } else {
-    return false;
   }
+  releaseJob();
+}
 
-  QObject::connect(scheduler.data(), &Scheduler::updateProgress, [this](double updatedProgress) {
-    progress = updatedProgress;
-  });
-  QObject::connect(scheduler.data(), &Scheduler::updateProgress, this, &SchedulerService::updateProgress);
-  QObject::connect(scheduler.data(), &Scheduler::failedScheduling, this, &SchedulerService::failedScheduling);
-  QObject::connect(scheduler.data(), &Scheduler::emitWarning, this, &SchedulerService::emitWarning);
-  QObject::connect(scheduler.data(), &Scheduler::failedScheduling, [this](QString errorMessage) {
-    result = errorMessage;
-    progress = 1.0;
-  });
-  QObject::connect(scheduler.data(), &Scheduler::finishedScheduling, [this](QSharedPointer<Plan> scheduledPlan) {
-    result = scheduledPlan->toJsonObject();
-    emit finishedScheduling(result.toObject());
-    progress = 1.0;
-  });
+bool SchedulerService::startScheduling(QJsonObject plan) {
+  if(scheduler != nullptr || jobStart.isRunning()) {
+    return false;
+  }
 
-  scheduler->startScheduling();
+  // The job keeps this snapshot, even if the configuration gets reloaded
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  PlanReader planReader(configuration->getMaxPlanSize());
+  if(!planReader.checkSize(plan)) {
+    emit emitWarning(planReader.getErrorString());
+    return false;
+  }
+  // The slot is given back, if the job turns out to be coalesced. The key is only known after hashing the plan.
+  if(!checkAdmission(AdmissionControl::global().tryStart())) {
+    return false;
+  }
 
+  traceId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+  traceStart = Tracer::global().now();
+  jobConfiguration = configuration;
+  startStopped = false;
+  jobStart = startJob(plan, getSchedulingAlgorithm(*configuration));
   return true;
 }
 
 bool SchedulerService::setSchedulingAlgorithm(QString mode) {
-  if(mode == "legacy-fast" || mode == "legacy-good") {
+  if(SchedulerFactory::isValidAlgorithm(mode) || mode == AlgorithmSelector::autoAlgorithm) {
     customAlgorithm = mode;
     return true;
   }
@@ -62,17 +77,437 @@ bool SchedulerService::setSchedulingAlgorithm(QString mode) {
 }
 
 bool SchedulerService::stopScheduling() {
+  if(jobStart.isRunning() && scheduler.isNull()) {
+    // The job has not started yet
+    startStopped = true;
+    return true;
+  }
   if(scheduler.isNull()) {
     return false;
   }
-  scheduler->stopScheduling();
+  releaseJob();
   return true;
 }
 
 double SchedulerService::getProgress() {
+  // Attached to a job of another service
+  if(scheduler.isNull() && !jobId.isEmpty()) {
+    return journal->getJob(jobId).progress;
+  }
   return progress;
 }
 
+QJsonObject SchedulerService::getOptimalityGap() {
+  if(gapPenalty < 0 || gapLowerBound < 0) {
+    return QJsonObject();
+  }
+  return QJsonObject{{"penalty", gapPenalty},
+                     {"lowerBound", gapLowerBound},
+                     {"gap", SoftPenaltyBound::gap(gapPenalty, gapLowerBound)}};
+}
+
 QJsonValue SchedulerService::getResult() {
+  // Attached to a job of another service
+  if(scheduler.isNull() && !jobId.isEmpty()) {
+    JobJournal::JobRecord job = journal->getJob(jobId);
+    if(job.state == JobJournal::Finished) {
+      return journal->readResult(jobId);
+    } else if(job.state == JobJournal::Failed) {
+      return job.message;
+    }
+    return QJsonValue::Undefined;
+  }
   return result;
 }
+
+QJsonValue SchedulerService::getResultAssignments() {
+  if(!scheduler.isNull() && !resultPlan.isNull()) {
+    return ScheduleDelta::create(resultPlan.get());
+  }
+  QJsonValue currentResult = getResult();
+  if(!currentResult.isObject()) {
+    return currentResult;
+  }
+  // The result was read from the journal
+  Plan plan;
+  plan.fromJsonObject(currentResult.toObject());
+  return ScheduleDelta::create(&plan);
+}
+
+QString SchedulerService::getJobId() {
+  return jobId;
+}
+
+bool SchedulerService::attachJob(QString jobId) {
+  if(scheduler != nullptr || journal.isNull() || !journal->containsJob(jobId)) {
+    return false;
+  }
+  this->jobId = jobId;
+  return true;
+}
+
+bool SchedulerService::startBatch(QJsonObject basePlan, QJsonArray variants) {
+  if(batch != nullptr || variants.isEmpty()) {
+    return false;
+  }
+
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  PlanReader planReader(configuration->getMaxPlanSize());
+  if(!planReader.checkSize(basePlan)) {
+    emit emitWarning(planReader.getErrorString());
+    return false;
+  }
+  for(const QJsonValue& variant : variants) {
+    if(!planReader.checkSize(variant.toObject())) {
+      emit emitWarning(planReader.getErrorString());
+      return false;
+    }
+  }
+  if(!checkAdmission(AdmissionControl::global().tryQueue(variants.size()))) {
+    return false;
+  }
+
+  QString schedulingAlgorithm = getSchedulingAlgorithm(*configuration);
+  if(schedulingAlgorithm == AlgorithmSelector::autoAlgorithm) {
+    // All variants use the algorithm selected for the base plan or the first variant
+    Plan representativePlan;
+    representativePlan.fromJsonObject(basePlan.isEmpty() ? variants.first().toObject() : basePlan);
+    schedulingAlgorithm = algorithmSelector->resolve(
+        schedulingAlgorithm, &representativePlan, configuration->getAutoLatencyTarget(), configuration->getExactSchedulerMaxModules());
+  }
+  batch.reset(new BatchJob(basePlan, variants, schedulingAlgorithm, configuration));
+  // The batch starts the queued variants and gives their slots back
+  batch->setAdmissionControl(&AdmissionControl::global());
+  QObject::connect(batch.data(), &BatchJob::finished, this, &SchedulerService::finishedBatch);
+  if(!batch->start()) {
+    batch.reset();
+    return false;
+  }
+  return true;
+}
+
+bool SchedulerService::stopBatch() {
+  if(batch.isNull()) {
+    return false;
+  }
+  batch->stop();
+  return true;
+}
+
+double SchedulerService::getBatchProgress() {
+  if(batch.isNull()) {
+    return 0.0;
+  }
+  return batch->getProgress();
+}
+
+QJsonValue SchedulerService::getBatchResult() {
+  if(batch.isNull() || !batch->isFinished()) {
+    return QJsonValue::Undefined;
+  }
+  return batch->getResults();
+}
+
+bool SchedulerService::startSemester(QJsonArray plans) {
+  if(semester != nullptr || plans.isEmpty()) {
+    return false;
+  }
+
+  QSharedPointer<const Configuration> configuration = configurationProvider->getConfiguration();
+  PlanReader planReader(configuration->getMaxPlanSize());
+  for(const QJsonValue& plan : plans) {
+    if(!planReader.checkSize(plan.toObject())) {
+      emit emitWarning(planReader.getErrorString());
+      return false;
+    }
+  }
+  if(!checkAdmission(AdmissionControl::global().tryQueue(plans.size()))) {
+    return false;
+  }
+
+  QString schedulingAlgorithm = getSchedulingAlgorithm(*configuration);
+  if(schedulingAlgorithm == AlgorithmSelector::autoAlgorithm) {
+    // All plans use the algorithm selected for the first plan
+    Plan representativePlan;
+    representativePlan.fromJsonObject(plans.first().toObject());
+    schedulingAlgorithm = algorithmSelector->resolve(
+        schedulingAlgorithm, &representativePlan, configuration->getAutoLatencyTarget(), configuration->getExactSchedulerMaxModules());
+  }
+  semester.reset(new SemesterJob(plans, schedulingAlgorithm, configuration));
+  // The semester job starts the queued plans and gives their slots back
+  semester->setAdmissionControl(&AdmissionControl::global());
+  QObject::connect(semester.data(), &SemesterJob::finished, this, &SchedulerService::finishedSemester);
+  if(!semester->start()) {
+    semester.reset();
+    return false;
+  }
+  return true;
+}
+
+bool SchedulerService::stopSemester() {
+  if(semester.isNull()) {
+    return false;
+  }
+  semester->stop();
+  return true;
+}
+
+double SchedulerService::getSemesterProgress() {
+  if(semester.isNull()) {
+    return 0.0;
+  }
+  return semester->getProgress();
+}
+
+QJsonValue SchedulerService::getSemesterResult() {
+  if(semester.isNull() || !semester->isFinished()) {
+    return QJsonValue::Undefined;
+  }
+  return semester->getResult();
+}
+
+QJsonObject SchedulerService::getTrace() {
+  return Tracer::global().toChromeTrace(traceId);
+}
+
+QJsonObject SchedulerService::getJobMetrics() {
+  if(scheduler.isNull()) {
+    return QJsonObject();
+  }
+  QJsonObject metrics = scheduler->getMetrics();
+  metrics["jobId"] = jobId;
+  metrics["algorithm"] = jobAlgorithm;
+  if(jobRuntime >= 0) {
+    metrics["runtime"] = jobRuntime;
+  } else {
+    metrics["runtime"] = jobTimer.isValid() ? jobTimer.elapsed() / 1000.0 : 0.0;
+  }
+  return metrics;
+}
+
+int SchedulerService::getRetryAfter() {
+  return retryAfter;
+}
+
+QString SchedulerService::getSchedulingAlgorithm(const Configuration& configuration) const {
+  if(!customAlgorithm.isEmpty()) {
+    return customAlgorithm;
+  }
+  return configuration.getDefaultSchedulingAlgorithm();
+}
+
+bool SchedulerService::checkAdmission(const AdmissionControl::Decision& decision) {
+  if(!decision.admitted) {
+    retryAfter = decision.retryAfter;
+    emit emitWarning(decision.reason + " Retry after " + QString::number(decision.retryAfter) + " seconds.");
+    return false;
+  }
+  retryAfter = 0;
+  return true;
+}
+
+JobPipeline::Task SchedulerService::startJob(QJsonObject plan, QString requestedAlgorithm) {
+  QString settings = SchedulerFactory::describeSettings(requestedAlgorithm, *jobConfiguration);
+  QString jobTraceId = traceId;
+  // The plan is written in the pool and recorded, when the algorithm is known
+  QString newJobId;
+  QString planPath;
+  if(!journal.isNull()) {
+    newJobId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    planPath = journal->planPath(newJobId);
+  }
+  QSharedPointer<AlgorithmSelector> selector = algorithmSelector;
+  double latencyTarget = jobConfiguration->getAutoLatencyTarget();
+  int exactMaxModules = jobConfiguration->getExactSchedulerMaxModules();
+  PreparedJob prepared = co_await JobPipeline::runInPool(
+      [plan, requestedAlgorithm, settings, jobTraceId, planPath, selector, latencyTarget, exactMaxModules]() {
+        PreparedJob prepared;
+        {
+          Tracer::Span span("hash", jobTraceId);
+          prepared.key = JobCoalescer::createKey(plan, requestedAlgorithm, settings);
+        }
+        if(!planPath.isEmpty()) {
+          Tracer::Span span("store", jobTraceId);
+          prepared.planStored = JobJournal::writeFile(planPath, plan);
+        }
+        // The plan is also parsed for jobs, that turn out to be coalesced. Parsing it after the lookup would let other
+        // clients start the same job, before it is added to the JobCoalescer.
+        prepared.plan.reset(new Plan());
+        {
+          Tracer::Span span("parse", jobTraceId);
+          prepared.plan->fromJsonObject(plan);
+        }
+        prepared.algorithm = selector->resolve(requestedAlgorithm, prepared.plan.get(), latencyTarget, exactMaxModules);
+        prepared.features = PlanFeatures::extract(prepared.plan.get());
+        return prepared;
+      });
+  QByteArray key = prepared.key;
+  if(startStopped) {
+    AdmissionControl::global().finish();
+    result = "Scheduling was stopped";
+    progress = 1.0;
+    if(prepared.planStored) {
+      // Record the stored plan, so it is removed with the expired jobs
+      jobId = newJobId;
+      journal->submitStoredJob(jobId, requestedAlgorithm);
+      journal->failJob(jobId, result.toString());
+    }
+    co_return;
+  }
+
+  JobCoalescer::Job runningJob = JobCoalescer::global().subscribe(key);
+  QString schedulingAlgorithm;
+  if(!runningJob.scheduler.isNull()) {
+    // The job does not start another process, so it needs no slot
+    AdmissionControl::global().finish();
+    scheduler = runningJob.scheduler;
+    schedulingAlgorithm = runningJob.algorithm;
+    // 1.0 is only reported together with the result
+    progress = std::min(runningJob.progress, maxRunningProgress);
+    jobCoalesced = true;
+    Tracer::global().instant("coalesced", traceId);
+  } else {
+    schedulingAlgorithm = prepared.algorithm;
+    scheduler.reset(SchedulerFactory::createScheduler(prepared.plan, schedulingAlgorithm, *jobConfiguration));
+    if(scheduler.isNull()) {
+      AdmissionControl::global().finish();
+      result = "Unknown scheduling algorithm";
+      progress = 1.0;
+      if(prepared.planStored) {
+        jobId = newJobId;
+        journal->submitStoredJob(jobId, requestedAlgorithm);
+        journal->failJob(jobId, result.toString());
+      }
+      emit failedScheduling(result.toString());
+      co_return;
+    }
+    holdAdmission(scheduler.data());
+    jobFeatures = prepared.features;
+    scheduler->setTraceId(traceId);
+    JobCoalescer::global().add(key, scheduler, schedulingAlgorithm);
+  }
+  jobKey = key;
+  jobSubscribed = true;
+  jobAlgorithm = schedulingAlgorithm;
+
+  if(prepared.planStored) {
+    jobId = newJobId;
+    journal->submitStoredJob(jobId, schedulingAlgorithm);
+  } else if(!journal.isNull()) {
+    // The job still runs, but it can not be attached to or recovered
+    emit emitWarning("Failed to record the job in the journal");
+  }
+  if(!jobId.isEmpty()) {
+    Tracer::global().instant("submitted", traceId, jobId);
+    QObject::connect(scheduler.data(), &Scheduler::updateProgress, this, [this](double updatedProgress) {
+      // finishJob and failJob set the progress with the result
+      journal->updateProgress(jobId, std::min(updatedProgress, maxRunningProgress));
+    });
+    QObject::connect(scheduler.data(), &Scheduler::failedScheduling, this, [this](QString errorMessage) {
+      journal->failJob(jobId, errorMessage);
+    });
+  }
+
+  QObject::connect(scheduler.data(), &Scheduler::updateProgress, this, [this](double updatedProgress) {
+    // The result is assigned by the handlers of finishedScheduling and failedScheduling, which also set 1.0
+    progress = std::min(updatedProgress, maxRunningProgress);
+  });
+  QObject::connect(scheduler.data(), &Scheduler::updateProgress, this, &SchedulerService::updateProgress);
+  QObject::connect(scheduler.data(), &Scheduler::updateGap, this, [this](int penalty, int lowerBound) {
+    gapPenalty = penalty;
+    gapLowerBound = lowerBound;
+  });
+  QObject::connect(scheduler.data(), &Scheduler::failedScheduling, this, &SchedulerService::failedScheduling);
+  QObject::connect(scheduler.data(), &Scheduler::emitWarning, this, &SchedulerService::emitWarning);
+  QObject::connect(scheduler.data(), &Scheduler::failedScheduling, this, [this](QString errorMessage) {
+    Tracer::global().complete("job", traceId, traceStart, errorMessage);
+    jobRuntime = jobTimer.elapsed() / 1000.0;
+    result = errorMessage;
+    progress = 1.0;
+  });
+  QObject::connect(scheduler.data(), &Scheduler::finishedScheduling, this, [this](QSharedPointer<Plan> scheduledPlan) {
+    jobRuntime = jobTimer.elapsed() / 1000.0;
+    publication = publishResult(scheduledPlan);
+  });
+
+  if(!jobId.isEmpty()) {
+    journal->startJob(jobId);
+  }
+  jobTimer.start();
+  if(!jobCoalesced) {
+    scheduler->startScheduling();
+  }
+}
+
+JobPipeline::Task SchedulerService::publishResult(QSharedPointer<Plan> scheduledPlan) {
+  QString jobTraceId = traceId;
+  // Only the service, that started the job, knows its runtime
+  if(!jobCoalesced) {
+    ScheduleScore score;
+    if(scheduler->hasScore()) {
+      score = scheduler->getScore();
+    } else {
+      score = co_await JobPipeline::runInPool([scheduledPlan]() {
+        return ScheduleEvaluator::evaluate(scheduledPlan.get());
+      });
+    }
+    algorithmSelector->record(jobFeatures, jobAlgorithm, jobRuntime, score);
+  }
+  // Other connections and restarts read the result from the journal, so it needs the whole plan. It is written in the
+  // pool and recorded afterwards.
+  QString resultPath = jobId.isEmpty() ? QString() : journal->resultPath(jobId);
+  StoredResult stored = co_await JobPipeline::runInPool([scheduledPlan, jobTraceId, resultPath]() {
+    StoredResult stored;
+    {
+      Tracer::Span span("serialize", jobTraceId);
+      stored.plan = scheduledPlan->toJsonObject();
+    }
+    if(!resultPath.isEmpty()) {
+      Tracer::Span span("store", jobTraceId);
+      stored.written = JobJournal::writeFile(resultPath, stored.plan);
+    }
+    return stored;
+  });
+  if(!jobId.isEmpty()) {
+    if(stored.written) {
+      journal->finishStoredJob(jobId);
+    } else {
+      journal->failJob(jobId, "Failed to store the result");
+    }
+  }
+  result = stored.plan;
+  resultPlan = scheduledPlan;
+  Tracer::global().complete("job", traceId, traceStart, jobAlgorithm);
+  progress = 1.0;
+  emit finishedScheduling(stored.plan);
+}
+
+void SchedulerService::holdAdmission(Scheduler* scheduler) {
+  QSharedPointer<bool> held(new bool(true));
+  QElapsedTimer timer;
+  timer.start();
+  auto release = [held, timer](bool finished) {
+    if(*held) {
+      *held = false;
+      AdmissionControl::global().finish(finished ? timer.elapsed() / 1000.0 : -1.0);
+    }
+  };
+  QObject::connect(scheduler, &Scheduler::finishedScheduling, [release]() {
+    release(true);
+  });
+  QObject::connect(scheduler, &Scheduler::failedScheduling, [release]() {
+    release(true);
+  });
+  QObject::connect(scheduler, &QObject::destroyed, [release]() {
+    release(false);
+  });
+}
+
+void SchedulerService::releaseJob() {
+  if(jobSubscribed) {
+    jobSubscribed = false;
+    if(JobCoalescer::global().unsubscribe(jobKey, scheduler.data())) {
+      scheduler->stopScheduling();
+    }
+  }
+}
@@ -1,13 +1,31 @@
 #ifndef SCHEDULERSERVICE_H
 #define SCHEDULERSERVICE_H
 
+#include <QElapsedTimer>
+#include <QJsonArray>
 #include <QJsonValue>
 #include <QObject>
+#include <QUuid>
+#include <algorithm>
 
+#include "admissioncontrol.h"
+#include "algorithmselector.h"
+#include "batchjob.h"
 #include "configuration.h"
+#include "configurationprovider.h"
+#include "jobcoalescer.h"
+#include "jobjournal.h"
+#include "jobpipeline.h"
 #include "legacyscheduler.h"
 #include "plan.h"
+#include "planfeatures.h"
+#include "planreader.h"
+#include "scheduledelta.h"
 #include "scheduler.h"
+#include "schedulerfactory.h"
+#include "semesterjob.h"
+#include "softpenaltybound.h"
+#include "tracer.h"
 
 /**
  *  @class SchedulerService
@@ -22,11 +40,68 @@ class SchedulerService: public QObject {
   Q_OBJECT
 
  private:
-  QSharedPointer<Configuration> configuration;
-  QScopedPointer<Scheduler> scheduler;
+  // The highest progress of a running job. 1.0 is only reported, once the result is assigned.
+  static constexpr double maxRunningProgress = 0.99;
+
+  /**
+   *  @brief The result of the first stage of a job, that runs in the pool
+   */
+  struct PreparedJob {
+    QByteArray key;
+    // The plan was written to the journal, but the job is not recorded yet
+    bool planStored = false;
+    QSharedPointer<Plan> plan;
+    // The requested algorithm with "auto" resolved
+    QString algorithm;
+    PlanFeatures features;
+  };
+
+  /**
+   *  @brief The serialized result of a job and if it was written to the journal in the pool
+   */
+  struct StoredResult {
+    QJsonObject plan;
+    bool written = false;
+  };
+
+  QSharedPointer<ConfigurationProvider> configurationProvider;
+  QSharedPointer<JobJournal> journal;
+  QSharedPointer<AlgorithmSelector> algorithmSelector;
+  QSharedPointer<const Configuration> jobConfiguration;
+  QString jobId;
+  QString jobAlgorithm;
+  PlanFeatures jobFeatures;
+  QElapsedTimer jobTimer;
+  // The runtime of the job in seconds, after it finished or failed
+  double jobRuntime;
+  QString traceId;
+  qint64 traceStart;
+  // Shared with the services of other clients, that submitted the same plan
+  QSharedPointer<Scheduler> scheduler;
+  QByteArray jobKey;
+  // The service has not let go of the job yet
+  bool jobSubscribed;
+  // The job was started by another service
+  bool jobCoalesced;
+  // The client stopped the job, before it started
+  bool startStopped;
   double progress;
+  // The soft penalty of the best schedule of the job and its lower bound or -1, while they are unknown
+  int gapPenalty;
+  int gapLowerBound;
+  // The serialized result or the error message
   QJsonValue result;
+  // The scheduled plan, once it is published
+  QSharedPointer<Plan> resultPlan;
   QString customAlgorithm;
+  QScopedPointer<BatchJob> batch;
+  QScopedPointer<SemesterJob> semester;
+  int retryAfter;
+  // The tasks are destroyed first, because they use the other members
+  // Publishes the result in the pool
+  JobPipeline::Task publication;
+  // Hashes the plan in the pool and starts or joins the job
+  JobPipeline::Task jobStart;
 
  public:
   /**
@@ -36,6 +111,23 @@ class SchedulerService: public QObject {
    */
   explicit SchedulerService(const QSharedPointer<Configuration> configuration, QObject* parent = nullptr);
 
+  /**
+   *  @brief Creates a new SchedulerService
+   *  @param [in] configurationProvider provides the Configuration for this service
+   *  @param [in] journal records the jobs of this service. If it is nullptr, jobs are not recorded.
+   *  @param [in] algorithmSelector selects the algorithm for "auto" and learns from finished jobs. If it is nullptr,
+   * the service uses its own selector without history.
+   *  @param parent is the parent of this QObject
+   *
+   *  Every job uses the configuration, that was published when the job was started
+   */
+  explicit SchedulerService(const QSharedPointer<ConfigurationProvider> configurationProvider,
+                            const QSharedPointer<JobJournal> journal = nullptr,
+                            const QSharedPointer<AlgorithmSelector> algorithmSelector = nullptr,
+                            QObject* parent = nullptr);
+
+  ~SchedulerService();
+
  public slots:
 
   /**
@@ -45,7 +137,12 @@ class SchedulerService: public QObject {
    *  @param [in] parent is the pare
    *  @return A boolean indicating if scheduling was started
    *
-   *  Returns false if a plan is already being scheduled
+   *  Returns false if a plan is already being scheduled, if the plan is larger than the maximum plan size or if the
+   * server is overloaded. In the last case getRetryAfter returns, when the client should try again.
+   *
+   *  If another client is scheduling the same plan with the same algorithm and settings, this service subscribes to
+   * that job instead of starting a new one, as described in JobCoalescer. The plan is hashed and parsed in the pool, so
+   * the job starts after this call returned. Until then getJobId and getJobMetrics are empty.
    */
   bool startScheduling(QJsonObject plan);
 
@@ -54,7 +151,8 @@ class SchedulerService: public QObject {
    *  @param [in] mode is the scheduling mode
    *  @return A boolean indicating, if setting the mode was successfull
    *
-   *  mode has to be "legacy-good" or "legacy-fast"
+   *  mode has to be "legacy-good", "legacy-fast", "exact" or "auto". "auto" selects exact for small plans and legacy-good
+   * or legacy-fast for the others, depending on the expected runtime.
    */
   bool setSchedulingAlgorithm(QString mode);
 
@@ -62,7 +160,8 @@ class SchedulerService: public QObject {
    *  @brief Try to stop the current scheduling
    *  @return A boolean indicating if scheduler was asked to stop
    *
-   *  Try to stop the current scheduling. Will emit finishedScheduling or failedScheduling, when it stopped
+   *  Try to stop the current scheduling. Will emit finishedScheduling or failedScheduling, when it stopped. If the job
+   * is shared with other clients, it is only stopped, after every client stopped it.
    */
   bool stopScheduling();
 
@@ -76,6 +175,17 @@ class SchedulerService: public QObject {
    */
   double getProgress();
 
+  /**
+   *  @brief Get the optimality gap of the best schedule of the job
+   *  @return A QJsonObject with the soft penalty of the best schedule "penalty", a lower bound on the soft penalty
+   * "lowerBound" and the relative gap between them "gap"
+   *
+   *  The gap is between 0.0 and 1.0, 0.0 means, that the schedule is optimal. Returns an empty object, while the
+   * scheduler has not reported a schedule yet. legacy-fast reports no gap, because SPA-algorithmus lists no interim
+   * schedules in fast mode.
+   */
+  QJsonObject getOptimalityGap();
+
   /**
    *  @brief Get the scheduled plan
    *  @return A QJsonValue containing the scheduled plan, an errormessage or
@@ -87,6 +197,161 @@ class SchedulerService: public QObject {
    */
   QJsonValue getResult();
 
+  /**
+   *  @brief Get only the assignments of the scheduled plan
+   *  @return A QJsonValue containing the assignments, an errormessage or nothing
+   *
+   *  Like getResult, but instead of the whole plan, only the timeslot of every module is returned, as described in
+   * ScheduleDelta. The client has to apply them to the plan it submitted. The plan is not serialized for this.
+   */
+  QJsonValue getResultAssignments();
+
+  /**
+   *  @brief Get the id of the current job
+   *  @return The id of the current job or an empty string, if there is no job or jobs are not recorded
+   *
+   *  The id can be used with attachJob by other connections and after the server was restarted. Unfinished jobs only
+   * survive restarts of the server: if this connection closes before the job finished, the job is stopped and
+   * recorded as failed, so attaching to it later only returns that failure.
+   */
+  QString getJobId();
+
+  /**
+   *  @brief Attach to a recorded job
+   *  @param [in] jobId is the id of the job
+   *  @return A boolean indicating if the job was found
+   *
+   *  After attaching, getProgress and getResult return the progress and the result of that job. Returns false, if
+   * this service is already scheduling a plan.
+   */
+  bool attachJob(QString jobId);
+
+  /**
+   *  @brief Start scheduling a batch of plan variants
+   *  @param [in] basePlan is the plan, that every variant is applied to. If it is empty, every variant is a complete plan.
+   *  @param [in] variants is an array of JSON merge patches for basePlan or of complete plans
+   *  @return A boolean indicating if the batch was started
+   *
+   *  Returns false if a batch is already being scheduled, if a plan is larger than the maximum plan size or if the server
+   * is overloaded. The variants are scheduled in parallel, with the current scheduling algorithm.
+   */
+  bool startBatch(QJsonObject basePlan, QJsonArray variants);
+
+  /**
+   *  @brief Try to stop the current batch
+   *  @return A boolean indicating if the batch was asked to stop
+   */
+  bool stopBatch();
+
+  /**
+   *  @brief Get the progress of the batch
+   *  @return A double between 0.0 and 1.0, that is the mean progress of all variants
+   */
+  double getBatchProgress();
+
+  /**
+   *  @brief Get the ranked results of the batch
+   *  @return A QJsonValue containing an array of results or nothing
+   *
+   *  If the batch is not finished, a QJsonValue with type QJsonValue::Undefined is returned. Otherwise an array with
+   * one object per variant is returned, ordered from the best to the worst score. Each object contains the index of
+   * the variant as "variant" and either "score" and "plan" or "error".
+   */
+  QJsonValue getBatchResult();
+
+  /**
+   *  @brief Start scheduling the plans of a semester into one consistent schedule
+   *  @param [in] plans is an array with the plans of every faculty. They have to use the same weeks, days and timeslots.
+   *  @return A boolean indicating if the semester job was started
+   *
+   *  Returns false if a semester is already being scheduled, if a plan is larger than the maximum plan size or if the
+   * server is overloaded. Plans without shared groups or modules are scheduled in parallel, plans that share them are
+   * coordinated as described in SemesterJob.
+   */
+  bool startSemester(QJsonArray plans);
+
+  /**
+   *  @brief Try to stop the current semester job
+   *  @return A boolean indicating if the semester job was asked to stop
+   */
+  bool stopSemester();
+
+  /**
+   *  @brief Get the progress of the semester job
+   *  @return A double between 0.0 and 1.0, that is the mean progress of all plans
+   */
+  double getSemesterProgress();
+
+  /**
+   *  @brief Get the semester schedule
+   *  @return A QJsonValue containing the result of the semester job or nothing
+   *
+   *  If the semester job is not finished, a QJsonValue with type QJsonValue::Undefined is returned. Otherwise an object
+   * with the scheduled plans in their submitted order as "plans", the coupled plans as "components", the shared groups
+   * and modules as "sharedGroups" and "sharedModules" and the number of group conflicts between the plans as
+   * "conflicts" is returned.
+   */
+  QJsonValue getSemesterResult();
+
+  /**
+   *  @brief Get the recorded trace of the job of this client
+   *  @return A Chrome trace-event JSON object. It contains no events, if tracing is disabled or no job was started.
+   *
+   *  The trace can be opened in chrome://tracing or Perfetto.
+   */
+  QJsonObject getTrace();
+
+  /**
+   *  @brief Get metrics about the current job
+   *  @return A QJsonObject with the job id, the algorithm, the runtime in seconds and the metrics of the scheduler, like
+   * the cores of the SPA-algorithmus process. It is empty, if no job was started.
+   */
+  QJsonObject getJobMetrics();
+
+  /**
+   *  @brief Get the time after which a rejected request should be retried
+   *  @return The number of seconds, after which the last startScheduling or startBatch call, that was rejected because
+   * the server is overloaded, should be retried. 0, if the last call was not rejected for this reason.
+   */
+  int getRetryAfter();
+
+ private:
+  QString getSchedulingAlgorithm(const Configuration& configuration) const;
+
+  /**
+   *  @brief Remember the retry hint of a rejected request and emit a warning
+   *  @return A boolean indicating if the request was admitted
+   */
+  bool checkAdmission(const AdmissionControl::Decision& decision);
+
+  /**
+   *  @brief Give the slot of the AdmissionControl back, when scheduler finishes or is deleted
+   *
+   *  The slot belongs to the scheduler and not to the service, because the scheduler keeps running after the service
+   * is deleted, if other services subscribed to it.
+   */
+  static void holdAdmission(Scheduler* scheduler);
+
+  /**
+   *  @brief Let go of the job and stop it, if no other service is subscribed to it
+   */
+  void releaseJob();
+
+  /**
+   *  @brief Hash the plan in the pool, then join the running job with the same key or start a new one
+   *
+   *  The plan is written to the journal, parsed and its algorithm is resolved in the same stage, so the event loop
+   * neither waits for the disk nor parses the plan.
+   */
+  JobPipeline::Task startJob(QJsonObject plan, QString requestedAlgorithm);
+
+  /**
+   *  @brief Record the runtime of the finished job and publish the result
+   *
+   *  The plan is serialized and written to the journal in the pool, so getResult only returns it.
+   */
+  JobPipeline::Task publishResult(QSharedPointer<Plan> scheduledPlan);
+
  signals:
   /**
    *  @brief This signal will be emitted, when progress is made
@@ -102,7 +367,9 @@ class SchedulerService: public QObject {
 
   /**
    *  @brief This signal will be emitted if the scheduling finished successfully
-   *  @param plan is a pointer to the scheduled plan
+   *  @param plan is the scheduled plan
+   *
+   *  The result is also available with getResult and getResultAssignments.
    */
   void finishedScheduling(QJsonObject plan);
 
@@ -111,6 +378,18 @@ class SchedulerService: public QObject {
    *  @param message contains a message with information about the failure
    */
   void failedScheduling(QString message);
+
+  /**
+   *  @brief This signal will be emitted, when every variant of the batch is finished
+   *  @param results are the ranked results
+   */
+  void finishedBatch(QJsonArray results);
+
+  /**
+   *  @brief This signal will be emitted, when every plan of the semester job is finished
+   *  @param result is the semester schedule
+   */
+  void finishedSemester(QJsonObject result);
 };
 
 #endif  // SCHEDULERSERVICE_H
@@ -0,0 +1,420 @@
+#include "semesterjob.h"
+
+SemesterJob::SemesterJob(const QJsonArray& plans,
+                         const QString& algorithm,
+                         const QSharedPointer<const Configuration>& configuration,
+                         QObject* parent)
+    : QObject(parent),
+      algorithm(algorithm),
+      configuration(configuration),
+      runningPlans(0),
+      finishedPlans(0),
+      conflicts(0),
+      stopped(false),
+      admissionControl(nullptr) {
+  for(const QJsonValue& plan : plans) {
+    SemesterPlan newPlan;
+    newPlan.jsonPlan = plan.toObject();
+    if(!plan.isObject()) {
+      newPlan.error = "Plan is not an object";
+    }
+    this->plans.append(newPlan);
+  }
+  publications.resize(this->plans.size());
+}
+
+SemesterJob::~SemesterJob() {
+  if(admissionControl != nullptr) {
+    for(const SemesterPlan& plan : plans) {
+      if(plan.running) {
+        admissionControl->finish();
+      } else if(!plan.finished) {
+        admissionControl->dequeue();
+      }
+    }
+  }
+}
+
+void SemesterJob::setAdmissionControl(AdmissionControl* admissionControl) {
+  this->admissionControl = admissionControl;
+  // Plans, that waited for a slot, start once another job finished
+  connect(admissionControl, &AdmissionControl::slotFreed, this, &SemesterJob::startNextPlans, Qt::QueuedConnection);
+}
+
+bool SemesterJob::start() {
+  if(plans.isEmpty() || !SchedulerFactory::isValidAlgorithm(algorithm) || configuration.isNull()) {
+    return false;
+  }
+  for(const SemesterPlan& plan : plans) {
+    if(!plan.error.isEmpty()) {
+      return false;
+    }
+  }
+  findSharedResources();
+  startNextPlans();
+  return true;
+}
+
+void SemesterJob::stop() {
+  stopped = true;
+  for(const SemesterPlan& plan : plans) {
+    if(plan.running) {
+      plan.scheduler->stopScheduling();
+    }
+  }
+  // Plans, that never started, are finished now
+  for(int component = 0; component < components.size(); component++) {
+    int firstNotStarted = nextPlans[component];
+    nextPlans[component] = components[component].size();
+    for(int position = firstNotStarted; position < components[component].size(); position++) {
+      finishPlan(components[component][position], "Semester job was stopped");
+    }
+  }
+}
+
+double SemesterJob::getProgress() const {
+  if(plans.isEmpty()) {
+    return 0.0;
+  }
+  double progress = 0.0;
+  for(const SemesterPlan& plan : plans) {
+    progress += plan.finished ? 1.0 : plan.progress;
+  }
+  return progress / plans.size();
+}
+
+bool SemesterJob::isFinished() const {
+  return !plans.isEmpty() && finishedPlans == plans.size();
+}
+
+QList<QList<int>> SemesterJob::getComponents() const {
+  return components;
+}
+
+QJsonObject SemesterJob::getResult() const {
+  QJsonArray resultPlans;
+  for(int index = 0; index < plans.size(); index++) {
+    const SemesterPlan& plan = plans[index];
+    QJsonObject result;
+    result["index"] = index;
+    if(!plan.finished) {
+      result["error"] = "Plan is not finished";
+    } else if(!plan.error.isEmpty()) {
+      result["error"] = plan.error;
+    } else {
+      result["score"] = plan.score.toJsonObject();
+      result["plan"] = plan.result;
+    }
+    resultPlans.append(result);
+  }
+
+  QJsonArray resultComponents;
+  for(const QList<int>& component : components) {
+    QJsonArray resultComponent;
+    for(int index : component) {
+      resultComponent.append(index);
+    }
+    resultComponents.append(resultComponent);
+  }
+
+  return QJsonObject{{"plans", resultPlans},
+                     {"components", resultComponents},
+                     {"sharedGroups", QJsonArray::fromStringList(sharedGroups)},
+                     {"sharedModules", QJsonArray::fromStringList(sharedModules)},
+                     {"conflicts", conflicts}};
+}
+
+void SemesterJob::findSharedResources() {
+  QHash<QString, QList<int>> plansOfGroups;
+  QHash<QString, QList<int>> plansOfModules;
+  for(int index = 0; index < plans.size(); index++) {
+    SemesterPlan& semesterPlan = plans[index];
+    semesterPlan.plan.reset(new Plan());
+    semesterPlan.plan->fromJsonObject(semesterPlan.jsonPlan);
+    for(Module* module : semesterPlan.plan->getModules()) {
+      if(!module->getActive()) {
+        continue;
+      }
+      QStringList groupNames;
+      for(Group* group : module->getGroups()) {
+        groupNames.append(group->getName());
+        QList<int>& plansOfGroup = plansOfGroups[group->getName()];
+        if(plansOfGroup.isEmpty() || plansOfGroup.last() != index) {
+          plansOfGroup.append(index);
+        }
+      }
+      semesterPlan.moduleGroups.insert(module->getNumber(), groupNames);
+      QList<int>& plansOfModule = plansOfModules[module->getNumber()];
+      if(plansOfModule.isEmpty() || plansOfModule.last() != index) {
+        plansOfModule.append(index);
+      }
+    }
+  }
+
+  // Plans, that share a resource, are merged into one component
+  QVector<int> parents(plans.size());
+  for(int index = 0; index < plans.size(); index++) {
+    parents[index] = index;
+  }
+  auto findRoot = [&parents](int index) {
+    while(parents[index] != index) {
+      parents[index] = parents[parents[index]];
+      index = parents[index];
+    }
+    return index;
+  };
+  auto couplePlans = [&findRoot, &parents](const QHash<QString, QList<int>>& plansOfResources, QStringList& sharedResources) {
+    for(auto plansOfResource = plansOfResources.constBegin(); plansOfResource != plansOfResources.constEnd(); plansOfResource++) {
+      if(plansOfResource.value().size() < 2) {
+        continue;
+      }
+      sharedResources.append(plansOfResource.key());
+      for(int index : plansOfResource.value()) {
+        parents[findRoot(index)] = findRoot(plansOfResource.value().first());
+      }
+    }
+    sharedResources.sort();
+  };
+  couplePlans(plansOfGroups, sharedGroups);
+  couplePlans(plansOfModules, sharedModules);
+
+  QHash<int, int> componentsOfRoots;
+  for(int index = 0; index < plans.size(); index++) {
+    int root = findRoot(index);
+    if(!componentsOfRoots.contains(root)) {
+      componentsOfRoots.insert(root, components.size());
+      components.append(QList<int>());
+    }
+    components[componentsOfRoots.value(root)].append(index);
+  }
+  // The plans of a component run one after another, so the largest components are started first
+  std::stable_sort(components.begin(), components.end(), [](const QList<int>& first, const QList<int>& second) {
+    return first.size() > second.size();
+  });
+  for(int component = 0; component < components.size(); component++) {
+    for(int index : components[component]) {
+      plans[index].component = component;
+    }
+  }
+  nextPlans = QVector<int>(components.size(), 0);
+}
+
+void SemesterJob::startNextPlans() {
+  int maxParallelJobs = configuration->getMaxParallelJobs();
+  // A plan, that fails to start, finishes immediately and lets the next plan of its component start
+  bool startedPlan = true;
+  while(startedPlan) {
+    startedPlan = false;
+    for(int component = 0; component < components.size() && !stopped && runningPlans < maxParallelJobs; component++) {
+      int position = nextPlans[component];
+      if(position >= components[component].size() || (position > 0 && !plans[components[component][position - 1]].finished)) {
+        continue;
+      }
+      if(admissionControl != nullptr && !admissionControl->startQueued()) {
+        return;
+      }
+      nextPlans[component]++;
+      startPlan(components[component][position]);
+      startedPlan = true;
+    }
+  }
+}
+
+bool SemesterJob::startPlan(int index) {
+  SemesterPlan& semesterPlan = plans[index];
+  // The plan counts as running from here on, so a failed start gives its slot back
+  semesterPlan.running = true;
+  semesterPlan.timer.start();
+  runningPlans++;
+  coordinatePlan(index);
+
+  semesterPlan.scheduler = SchedulerFactory::createScheduler(semesterPlan.plan, algorithm, *configuration, this);
+  if(semesterPlan.scheduler == nullptr) {
+    finishPlan(index, "Unknown scheduling algorithm");
+    return false;
+  }
+
+  connect(semesterPlan.scheduler, &Scheduler::updateProgress, this, [this, index](double progress) {
+    plans[index].progress = progress;
+    emit updateProgress(getProgress());
+  });
+  connect(semesterPlan.scheduler, &Scheduler::failedScheduling, this, [this, index](QString message) {
+    finishPlan(index, message);
+    startNextPlans();
+  });
+  connect(semesterPlan.scheduler, &Scheduler::finishedScheduling, this, [this, index](QSharedPointer<Plan> scheduledPlan) {
+    publications[index] = publishPlan(index, scheduledPlan);
+  });
+
+  if(!semesterPlan.scheduler->startScheduling()) {
+    finishPlan(index, "Failed to start scheduling");
+    return false;
+  }
+  return true;
+}
+
+JobPipeline::Task SemesterJob::publishPlan(int index, QSharedPointer<Plan> scheduledPlan) {
+  QJsonObject jsonPlan = plans[index].jsonPlan;
+  QJsonObject fixedAssignments = plans[index].fixedAssignments;
+  AppliedSchedule schedule = co_await JobPipeline::runInPool([scheduledPlan, jsonPlan, fixedAssignments]() {
+    AppliedSchedule schedule;
+    schedule.assignments = ScheduleDelta::create(scheduledPlan.get())["assignments"].toObject();
+    for(auto fixedAssignment = fixedAssignments.constBegin(); fixedAssignment != fixedAssignments.constEnd(); fixedAssignment++) {
+      schedule.assignments.insert(fixedAssignment.key(), fixedAssignment.value());
+    }
+
+    // The groups and modules were only changed for scheduling, so the schedule is applied to the submitted plan
+    Plan resultPlan;
+    resultPlan.fromJsonObject(jsonPlan);
+    schedule.applied = ScheduleDelta::apply(QJsonObject{{"assignments", schedule.assignments}}, &resultPlan);
+    if(schedule.applied) {
+      schedule.score = ScheduleEvaluator::evaluate(&resultPlan);
+      schedule.result = resultPlan.toJsonObject();
+    }
+    return schedule;
+  });
+
+  SemesterPlan& semesterPlan = plans[index];
+  semesterPlan.assignments = schedule.assignments;
+  if(!schedule.applied) {
+    finishPlan(index, "Failed to apply the schedule to the submitted plan");
+    startNextPlans();
+    co_return;
+  }
+  semesterPlan.score = schedule.score;
+  semesterPlan.result = schedule.result;
+  finishPlan(index, "");
+  startNextPlans();
+}
+
+void SemesterJob::coordinatePlan(int index) {
+  SemesterPlan& semesterPlan = plans[index];
+  QHash<QString, Group*> groups;
+  for(Group* group : semesterPlan.plan->getGroups()) {
+    groups.insert(group->getName(), group);
+  }
+  QHash<QString, Module*> modules;
+  for(Module* module : semesterPlan.plan->getModules()) {
+    if(module->getActive()) {
+      modules.insert(module->getNumber(), module);
+    }
+  }
+  QList<QList<QList<Timeslot*>>> weeks;
+  for(Week* week : semesterPlan.plan->getWeeks()) {
+    QList<QList<Timeslot*>> days;
+    for(Day* day : week->getDays()) {
+      days.append(day->getTimeslots());
+    }
+    weeks.append(days);
+  }
+
+  QHash<Timeslot*, QSet<Group*>> blockedGroups;
+  for(int earlier : components[semesterPlan.component]) {
+    if(earlier == index) {
+      break;
+    }
+    const SemesterPlan& earlierPlan = plans[earlier];
+    for(auto assignment = earlierPlan.assignments.constBegin(); assignment != earlierPlan.assignments.constEnd(); assignment++) {
+      if(!earlierPlan.moduleGroups.contains(assignment.key())) {
+        continue;
+      }
+      QStringList groupNames = earlierPlan.moduleGroups.value(assignment.key());
+      Module* sharedModule = modules.value(assignment.key(), nullptr);
+      if(sharedModule != nullptr && !semesterPlan.fixedAssignments.contains(assignment.key())) {
+        // The module keeps the timeslot of the earlier plan and is not scheduled again
+        sharedModule->setActive(false);
+        semesterPlan.fixedAssignments.insert(assignment.key(), assignment.value());
+        groupNames += semesterPlan.moduleGroups.value(assignment.key());
+      }
+
+      QJsonArray timeslots = assignment.value().toArray();
+      for(int position = 0; position + 2 < timeslots.size(); position += 3) {
+        int week = timeslots[position].toInt(-1);
+        int day = timeslots[position + 1].toInt(-1);
+        int slot = timeslots[position + 2].toInt(-1);
+        if(week < 0 || week >= weeks.size() || day < 0 || day >= weeks[week].size() || slot < 0 || slot >= weeks[week][day].size()) {
+          continue;
+        }
+        QSet<Group*>& blockedGroupsOfTimeslot = blockedGroups[weeks[week][day][slot]];
+        for(const QString& groupName : groupNames) {
+          Group* group = groups.value(groupName, nullptr);
+          if(group != nullptr) {
+            blockedGroupsOfTimeslot.insert(group);
+          }
+        }
+      }
+    }
+  }
+
+  for(auto blocked = blockedGroups.constBegin(); blocked != blockedGroups.constEnd(); blocked++) {
+    QList<Group*> activeGroups;
+    for(Group* group : blocked.key()->getActiveGroups()) {
+      if(!blocked.value().contains(group)) {
+        activeGroups.append(group);
+      }
+    }
+    blocked.key()->setActiveGroups(activeGroups);
+  }
+}
+
+void SemesterJob::finishPlan(int index, const QString& error) {
+  SemesterPlan& plan = plans[index];
+  if(plan.finished) {
+    return;
+  }
+  plan.finished = true;
+  plan.progress = 1.0;
+  if(plan.running) {
+    plan.running = false;
+    runningPlans--;
+    if(admissionControl != nullptr) {
+      admissionControl->finish(plan.timer.elapsed() / 1000.0);
+    }
+  } else if(admissionControl != nullptr) {
+    admissionControl->dequeue();
+  }
+  if(plan.error.isEmpty()) {
+    plan.error = error;
+  }
+  // Only the assignments are needed by the later plans, the result is kept as JSON
+  plan.plan.reset();
+  plan.jsonPlan = QJsonObject();
+  if(plan.scheduler != nullptr) {
+    plan.scheduler->deleteLater();
+    plan.scheduler = nullptr;
+  }
+  finishedPlans++;
+  emit updateProgress(getProgress());
+  if(isFinished()) {
+    conflicts = countConflicts();
+    emit finished(getResult());
+  }
+}
+
+int SemesterJob::countConflicts() const {
+  // The modules of every group in every timeslot over all plans. A shared module is only counted once.
+  QHash<QString, QSet<QString>> modulesOfGroups;
+  for(const SemesterPlan& plan : plans) {
+    if(!plan.error.isEmpty()) {
+      continue;
+    }
+    for(auto assignment = plan.assignments.constBegin(); assignment != plan.assignments.constEnd(); assignment++) {
+      QJsonArray timeslots = assignment.value().toArray();
+      for(int position = 0; position + 2 < timeslots.size(); position += 3) {
+        QString timeslot =
+            QString("%1/%2/%3/").arg(timeslots[position].toInt()).arg(timeslots[position + 1].toInt()).arg(timeslots[position + 2].toInt());
+        for(const QString& groupName : plan.moduleGroups.value(assignment.key())) {
+          modulesOfGroups[timeslot + groupName].insert(assignment.key());
+        }
+      }
+    }
+  }
+
+  int conflictCount = 0;
+  for(const QSet<QString>& modules : modulesOfGroups) {
+    if(modules.size() > 1) {
+      conflictCount++;
+    }
+  }
+  return conflictCount;
+}
@@ -0,0 +1,181 @@
+#ifndef SEMESTERJOB_H
+#define SEMESTERJOB_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+#include <vector>
+
+#include "admissioncontrol.h"
+#include "configuration.h"
+#include "jobpipeline.h"
+#include "plan.h"
+#include "scheduledelta.h"
+#include "scheduleevaluator.h"
+#include "scheduler.h"
+#include "schedulerfactory.h"
+
+/**
+ *  @class SemesterJob
+ *  @brief Schedules the plans of all faculties of a semester into one consistent schedule
+ *
+ *  The plans of a semester share cross-listed groups and modules. Groups are
+ *  identified by their name and modules by their number. All plans have to use
+ *  the same weeks, days and timeslots, a timeslot is identified by its
+ *  position.
+ *
+ *  Plans, that share a group or a module, are coupled. Every set of coupled
+ *  plans is a component. The components are scheduled in parallel, but at most
+ *  Configuration::getMaxParallelJobs plans at once. The plans of a component
+ *  are scheduled one after another. Before a plan is scheduled, the shared
+ *  groups are deactivated in every timeslot, in which an earlier plan of the
+ *  component has an exam of that group. A shared module keeps the timeslot of
+ *  the earlier plan.
+ *
+ *  The result contains every scheduled plan, the shared groups and modules,
+ *  the components and the number of conflicts left between the plans.
+ */
+class SemesterJob: public QObject {
+  Q_OBJECT
+
+ private:
+  struct SemesterPlan {
+    QJsonObject jsonPlan;
+    QSharedPointer<Plan> plan;
+    // The group names of every active module by its number
+    QHash<QString, QStringList> moduleGroups;
+    int component = -1;
+    // The assignments of shared modules, that were scheduled by an earlier plan of the component
+    QJsonObject fixedAssignments;
+    Scheduler* scheduler = nullptr;
+    double progress = 0.0;
+    bool running = false;
+    QElapsedTimer timer;
+    bool finished = false;
+    QString error;
+    ScheduleScore score;
+    QJsonObject assignments;
+    QJsonObject result;
+  };
+
+  // The schedule of a plan applied to the submitted plan
+  struct AppliedSchedule {
+    bool applied = false;
+    QJsonObject assignments;
+    ScheduleScore score;
+    QJsonObject result;
+  };
+
+  QList<SemesterPlan> plans;
+  // The plans of every component in the order, in which they are scheduled
+  QList<QList<int>> components;
+  // The next plan of every component, that is not started yet
+  QVector<int> nextPlans;
+  QStringList sharedGroups;
+  QStringList sharedModules;
+  QString algorithm;
+  QSharedPointer<const Configuration> configuration;
+  int runningPlans;
+  int finishedPlans;
+  int conflicts;
+  bool stopped;
+  AdmissionControl* admissionControl;
+  // Applies the schedule of every finished plan. Destroyed first, because its stages use the other members.
+  std::vector<JobPipeline::Task> publications;
+
+ public:
+  /**
+   *  @brief Creates a new SemesterJob
+   *  @param [in] plans is an array with the plans of the semester
+   *  @param [in] algorithm is the scheduling algorithm for every plan
+   *  @param [in] configuration is the configuration for the schedulers
+   *  @param [in] parent is the parent of this QObject
+   */
+  explicit SemesterJob(const QJsonArray& plans,
+                       const QString& algorithm,
+                       const QSharedPointer<const Configuration>& configuration,
+                       QObject* parent = nullptr);
+
+  ~SemesterJob();
+
+  /**
+   *  @brief Account the plans in admissionControl
+   *  @param [in] admissionControl has to outlive the job. Every plan has to be queued in it already. A plan moves to
+   * the running jobs, when it starts, and is removed, when it finishes. While the server runs its maximum number of
+   * jobs, the plans wait.
+   */
+  void setAdmissionControl(AdmissionControl* admissionControl);
+
+  /**
+   *  @brief Find the shared resources and start scheduling the plans
+   *  @return A boolean indicating if the job was started
+   *
+   *  Returns false, if there are no plans, a plan is not an object or the algorithm is unknown
+   */
+  bool start();
+
+  /**
+   *  @brief Stop every running plan and do not start the remaining ones
+   */
+  void stop();
+
+  /**
+   *  @brief Get the mean progress of all plans
+   *  @return A double between 0.0 and 1.0
+   */
+  double getProgress() const;
+
+  /**
+   *  @brief Check if every plan is finished
+   */
+  bool isFinished() const;
+
+  /**
+   *  @brief Get the indices of the coupled plans
+   *  @return A list with the plans of every component. It is empty, before the job was started.
+   */
+  QList<QList<int>> getComponents() const;
+
+  /**
+   *  @brief Get the semester schedule
+   *  @return An object with the plans, the shared groups and modules, the components and the conflicts
+   *
+   *  "plans" contains one object per plan with its index and either the score and the scheduled plan or an error
+   * message. "conflicts" is the number of timeslots, in which a group has more than one exam over all plans.
+   */
+  QJsonObject getResult() const;
+
+ private:
+  void findSharedResources();
+  void startNextPlans();
+  bool startPlan(int index);
+  void coordinatePlan(int index);
+  JobPipeline::Task publishPlan(int index, QSharedPointer<Plan> scheduledPlan);
+  void finishPlan(int index, const QString& error);
+  int countConflicts() const;
+
+ signals:
+  /**
+   *  @brief This signal will be emitted, when progress is made
+   *  @param progress is the mean progress of all plans
+   */
+  void updateProgress(double progress);
+
+  /**
+   *  @brief This signal will be emitted, when every plan is finished
+   *  @param result is the semester schedule
+   */
+  void finished(QJsonObject result);
+};
+
+#endif  // SEMESTERJOB_H
@@ -0,0 +1,59 @@
+#include "softpenaltybound.h"
+
+int SoftPenaltyBound::compute(const PlanIndex& index) {
+  QVector<int> groupExams(index.getGroupCount(), 0);
+  QVector<QBitArray> groupDays(index.getGroupCount(), QBitArray(index.getDayCount()));
+  QVector<int> assignment = index.readAssignment();
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    // Modules, that are not movable, only count, if they are scheduled
+    if(!index.isMovable(module) && assignment[module] == -1) {
+      continue;
+    }
+    QBitArray days(index.getDayCount());
+    if(index.isMovable(module)) {
+      const QBitArray& admissible = index.getAdmissibleTimeslots(module);
+      for(int timeslot = 0; timeslot < index.getTimeslotCount(); timeslot++) {
+        if(admissible.testBit(timeslot)) {
+          days.setBit(index.getDay(timeslot));
+        }
+      }
+    } else {
+      days.setBit(index.getDay(assignment[module]));
+    }
+    for(int group : index.getGroups(module)) {
+      groupExams[group]++;
+      groupDays[group] |= days;
+    }
+  }
+
+  int bound = 0;
+  for(int group = 0; group < index.getGroupCount(); group++) {
+    int days = groupDays[group].count(true);
+    if(days == 0) {
+      continue;
+    }
+    // r days get q + 1 exams, the other days get q exams
+    int q = groupExams[group] / days;
+    int r = groupExams[group] % days;
+    int pairs = r * (q + 1) * q / 2 + (days - r) * q * (q - 1) / 2;
+    bound += ScheduleEvaluator::sameDayPenalty * pairs;
+  }
+  return bound;
+}
+
+double SoftPenaltyBound::gap(int penalty, int lowerBound) {
+  if(penalty <= lowerBound || penalty <= 0) {
+    return 0.0;
+  }
+  return std::clamp(double(penalty - std::max(lowerBound, 0)) / penalty, 0.0, 1.0);
+}
+
+double SoftPenaltyBound::closedGap(int initialPenalty, int penalty, int lowerBound) {
+  if(penalty <= lowerBound) {
+    return 1.0;
+  }
+  if(initialPenalty <= lowerBound) {
+    return 0.0;
+  }
+  return std::clamp(double(initialPenalty - penalty) / (initialPenalty - lowerBound), 0.0, 1.0);
+}
@@ -0,0 +1,49 @@
+#ifndef SOFTPENALTYBOUND_H
+#define SOFTPENALTYBOUND_H
+
+#include <QBitArray>
+#include <QVector>
+#include <algorithm>
+
+#include "planindex.h"
+#include "scheduleevaluator.h"
+
+/**
+ *  @class SoftPenaltyBound
+ *  @brief A lower bound on the soft penalty of every schedule of a plan
+ *
+ *  The exams of a group can only be written on the days, on which at least
+ *  one of its modules may be scheduled. The fewest exams on the same day are
+ *  achieved by spreading them evenly over these days. The bound is the sum of
+ *  the same day penalties of this distribution over all groups. Exams on
+ *  consecutive days are not bounded.
+ *
+ *  The bound only needs the PlanIndex, so it is cheap compared to scheduling.
+ *  The soft penalty is the same as the one of the ScheduleEvaluator.
+ */
+class SoftPenaltyBound {
+ public:
+  /**
+   *  @brief Calculate the lower bound for the scheduled and the movable modules of index
+   */
+  static int compute(const PlanIndex& index);
+
+  /**
+   *  @brief The relative optimality gap of a schedule
+   *  @param [in] penalty is the soft penalty of the schedule
+   *  @param [in] lowerBound is a lower bound on the soft penalty
+   *  @return A value between 0.0 and 1.0. 0.0 means, that the schedule is optimal.
+   */
+  static double gap(int penalty, int lowerBound);
+
+  /**
+   *  @brief The share of the initial gap, that was closed
+   *  @param [in] initialPenalty is the penalty of the first schedule of a job
+   *  @param [in] penalty is the penalty of the current schedule
+   *  @param [in] lowerBound is a lower bound on the soft penalty
+   *  @return A value between 0.0 and 1.0. 1.0 means, that the schedule is optimal.
+   */
+  static double closedGap(int initialPenalty, int penalty, int lowerBound);
+};
+
+#endif  // SOFTPENALTYBOUND_H
@@ -0,0 +1,36 @@
+#include "spalogparser.h"
+
+SpaLogParser::Line SpaLogParser::parse(const QString& line) {
+  static const QRegularExpression schedulerStuckExpression("hängt \\([0-9][0-9]+\\)");
+  static const QRegularExpression resultFolderExpression("Details in: (.*)/[^/]*");
+  static const QRegularExpression currentBestExpression("ESoftBest: ([0-9]+)");
+
+  Line result;
+  if(line.contains("FEHLER") || (line.contains("WARNUNG") && !line.contains("WARNUNGEN")) || line.contains("kann nicht zugeteilt werden")) {
+    result.type = Warning;
+    return result;
+  }
+
+  if(schedulerStuckExpression.match(line).hasMatch()) {
+    result.type = Stuck;
+    return result;
+  }
+
+  auto resultFolderMatch = resultFolderExpression.match(line);
+  if(resultFolderMatch.hasMatch()) {
+    result.type = ResultDirectory;
+    result.resultDirectory = resultFolderMatch.captured(1);
+    return result;
+  }
+
+  auto currentBestMatch = currentBestExpression.match(line);
+  if(currentBestMatch.hasMatch()) {
+    bool ok;
+    int currentBest = currentBestMatch.captured(1).toInt(&ok);
+    if(ok) {
+      result.type = SoftBest;
+      result.softBest = currentBest;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,44 @@
+#ifndef SPALOGPARSER_H
+#define SPALOGPARSER_H
+
+#include <QRegularExpression>
+#include <QString>
+
+/**
+ *  @class SpaLogParser
+ *  @brief Classifies the lines SPA-algorithmus prints while scheduling
+ *
+ *  The output of SPA-algorithmus is untrusted, so parse accepts any string.
+ *  The regular expressions are compiled once and shared by all schedulers.
+ */
+class SpaLogParser {
+ public:
+  enum LineType {
+    // A line without meaning for the scheduler
+    Other,
+    // An error or a warning, that should be passed to the user
+    Warning,
+    // The algorithm is stuck and should be stopped
+    Stuck,
+    // The location of the result directory in Good mode
+    ResultDirectory,
+    // The soft penalty of the best schedule found so far
+    SoftBest
+  };
+
+  struct Line {
+    LineType type = Other;
+    // The result directory for ResultDirectory lines
+    QString resultDirectory;
+    // The soft penalty for SoftBest lines
+    int softBest = 0;
+  };
+
+  /**
+   *  @brief Classify a line of output
+   *  @param [in] line is a single line of output. It may end with a line break.
+   */
+  static Line parse(const QString& line);
+};
+
+#endif  // SPALOGPARSER_H
@@ -0,0 +1,87 @@
+# The scheduler sources without main.cpp. Used by the application, the tests and the benchmarks.
+QT += concurrent
+
+ROOT_DIR = $$PWD/..
+
+include($$ROOT_DIR/libs/pruefungsplaner-datamodel/pruefungsplaner-datamodel.pri)
+include($$ROOT_DIR/libs/pruefungsplaner-auth/client/client.pri)
+include($$ROOT_DIR/libs/qt-jsonrpc-server/qt-jsonrpc-server.pri)
+INCLUDEPATH += $$ROOT_DIR/libs/jwt-cpp/include
+# jwt-cpp checks the signatures with OpenSSL
+LIBS += -lcrypto
+INCLUDEPATH += $$ROOT_DIR/libs/cpptoml/include
+INCLUDEPATH += $$PWD
+
+# The JobPipeline uses C++20 coroutines, which GCC 10 only enables with -fcoroutines
+linux-g++*: QMAKE_CXXFLAGS += -fcoroutines
+
+SOURCES += \
+        $$PWD/admissioncontrol.cpp \
+        $$PWD/algorithmselector.cpp \
+        $$PWD/authsettings.cpp \
+        $$PWD/authsettingsrevalidator.cpp \
+        $$PWD/batchjob.cpp \
+        $$PWD/branchandbound.cpp \
+        $$PWD/configuration.cpp \
+        $$PWD/configurationprovider.cpp \
+        $$PWD/cpuplacement.cpp \
+        $$PWD/exactscheduler.cpp \
+        $$PWD/feasibilitycheck.cpp \
+        $$PWD/jobcoalescer.cpp \
+        $$PWD/jobjournal.cpp \
+        $$PWD/jobmemory.cpp \
+        $$PWD/jobpipeline.cpp \
+        $$PWD/jobrecovery.cpp \
+        $$PWD/legacyscheduler.cpp \
+        $$PWD/localsearch.cpp \
+        $$PWD/planfeatures.cpp \
+        $$PWD/placedprocess.cpp \
+        $$PWD/planindex.cpp \
+        $$PWD/planpresolver.cpp \
+        $$PWD/planreader.cpp \
+        $$PWD/schedulecsvreader.cpp \
+        $$PWD/scheduledelta.cpp \
+        $$PWD/scheduleevaluator.cpp \
+        $$PWD/schedulerfactory.cpp \
+        $$PWD/schedulerservice.cpp \
+        $$PWD/semesterjob.cpp \
+        $$PWD/softpenaltybound.cpp \
+        $$PWD/spalogparser.cpp \
+        $$PWD/tokenverifier.cpp \
+        $$PWD/tracer.cpp
+
+HEADERS += \
+    $$PWD/admissioncontrol.h \
+    $$PWD/algorithmselector.h \
+    $$PWD/authsettings.h \
+    $$PWD/authsettingsrevalidator.h \
+    $$PWD/batchjob.h \
+    $$PWD/branchandbound.h \
+    $$PWD/configuration.h \
+    $$PWD/configurationprovider.h \
+    $$PWD/cpuplacement.h \
+    $$PWD/exactscheduler.h \
+    $$PWD/feasibilitycheck.h \
+    $$PWD/jobcoalescer.h \
+    $$PWD/jobjournal.h \
+    $$PWD/jobmemory.h \
+    $$PWD/jobpipeline.h \
+    $$PWD/jobrecovery.h \
+    $$PWD/legacyscheduler.h \
+    $$PWD/localsearch.h \
+    $$PWD/planfeatures.h \
+    $$PWD/placedprocess.h \
+    $$PWD/planindex.h \
+    $$PWD/planpresolver.h \
+    $$PWD/planreader.h \
+    $$PWD/schedulecsvreader.h \
+    $$PWD/scheduledelta.h \
+    $$PWD/scheduleevaluator.h \
+    $$PWD/scheduler.h \
+    $$PWD/schedulerfactory.h \
+    $$PWD/schedulerservice.h \
+    $$PWD/semesterjob.h \
+    $$PWD/softpenaltybound.h \
+    $$PWD/spalogparser.h \
+    $$PWD/tokenverifier.h \
+    $$PWD/tracer.h
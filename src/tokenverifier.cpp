@@ -0,0 +1,96 @@
+#include "tokenverifier.h"
+
+TokenVerifier::TokenVerifier()
+    : TokenVerifier([]() {
+        return QDateTime::currentSecsSinceEpoch();
+      }) {}
+
+TokenVerifier::TokenVerifier(const std::function<qint64()>& currentTime)
+    : cache(defaultCacheSize), cacheHits(0), cacheMisses(0), currentTime(currentTime) {}
+
+TokenVerifier& TokenVerifier::global() {
+  static TokenVerifier verifier;
+  return verifier;
+}
+
+void TokenVerifier::configure(const QString& publicKey, const QString& issuer, const QList<QString>& requiredClaims, int cacheSize) {
+  QMutexLocker locker(&mutex);
+  if(publicKey != this->publicKey || issuer != this->issuer || requiredClaims != this->requiredClaims) {
+    cache.clear();
+  }
+  this->publicKey = publicKey;
+  this->issuer = issuer;
+  this->requiredClaims = requiredClaims;
+  cache.setMaxCost(std::max(cacheSize, 0));
+}
+
+bool TokenVerifier::verify(const QString& token) {
+  std::string encodedToken = token.toStdString();
+  QByteArray digest = QCryptographicHash::hash(QByteArray::fromStdString(encodedToken), QCryptographicHash::Sha256);
+
+  QMutexLocker locker(&mutex);
+  Expiration* remembered = cache.object(digest);
+  if(remembered != nullptr) {
+    if(currentTime() < *remembered) {
+      cacheHits++;
+      return true;
+    }
+    // The token may still be valid, if only maxCacheAge passed
+    cache.remove(digest);
+  }
+  cacheMisses++;
+
+  Expiration expiration = 0;
+  if(!verifySignature(encodedToken, expiration)) {
+    return false;
+  }
+  Expiration maxExpiration = currentTime() + maxCacheAge;
+  if(expiration == 0 || expiration > maxExpiration) {
+    expiration = maxExpiration;
+  }
+  cache.insert(digest, new Expiration(expiration));
+  return true;
+}
+
+int TokenVerifier::getCachedTokens() const {
+  QMutexLocker locker(&mutex);
+  return cache.size();
+}
+
+quint64 TokenVerifier::getCacheHits() const {
+  QMutexLocker locker(&mutex);
+  return cacheHits;
+}
+
+quint64 TokenVerifier::getCacheMisses() const {
+  QMutexLocker locker(&mutex);
+  return cacheMisses;
+}
+
+bool TokenVerifier::verifySignature(const std::string& token, Expiration& expiration) const {
+  if(publicKey == "") {
+    return false;
+  }
+  try {
+    auto decodedToken = jwt::decode(token);
+    auto verifier =
+        jwt::verify().allow_algorithm(jwt::algorithm::rs256(publicKey.toStdString(), "", "", "")).with_issuer(issuer.toStdString());
+    verifier.verify(decodedToken);
+    for(const QString& claim : requiredClaims) {
+      if(!decodedToken.has_payload_claim(claim.toStdString()) || !decodedToken.get_payload_claim(claim.toStdString()).as_bool()) {
+        return false;
+      }
+    }
+    if(decodedToken.has_expires_at()) {
+      expiration = std::chrono::duration_cast<std::chrono::seconds>(decodedToken.get_expires_at().time_since_epoch()).count();
+      if(expiration <= currentTime()) {
+        return false;
+      }
+    } else {
+      expiration = 0;
+    }
+    return true;
+  } catch(const std::exception&) {
+    return false;
+  }
+}
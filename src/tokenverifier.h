@@ -0,0 +1,112 @@
+#ifndef TOKENVERIFIER_H
+#define TOKENVERIFIER_H
+
+#include <jwt-cpp/jwt.h>
+
+#include <QByteArray>
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <chrono>
+#include <functional>
+#include <string>
+
+/**
+ *  @class TokenVerifier
+ *  @brief Verifies the jwts of the clients and remembers the verified ones
+ *
+ *  A token is valid, if it is signed with the private key matching publicKey
+ *  (RS256), has the configured issuer, is not expired and has every required
+ *  claim set to true.
+ *
+ *  Checking the signature is expensive compared to the calls of a client,
+ *  that polls the progress of a job. So valid tokens are remembered by their
+ *  SHA-256 in a cache with at most cacheSize entries, that drops the least
+ *  recently used token first. A token is remembered until its exp claim and
+ *  for at most maxCacheAge seconds. After that its signature is checked
+ *  again, so tokens without exp are still valid, but checked from time to
+ *  time. Invalid tokens are not remembered, so they can not push valid ones
+ *  out of the cache.
+ *
+ *  The cache is dropped, when the public key, the issuer or the required
+ *  claims change.
+ */
+class TokenVerifier {
+ public:
+  static constexpr int defaultCacheSize = 1024;
+  // Maximum time in seconds, that a valid token is remembered
+  static constexpr qint64 maxCacheAge = 300;
+
+ private:
+  // Time in seconds since epoch, until which the token is remembered
+  using Expiration = qint64;
+
+  mutable QMutex mutex;
+  QString publicKey;
+  QString issuer;
+  QList<QString> requiredClaims;
+  QCache<QByteArray, Expiration> cache;
+  quint64 cacheHits;
+  quint64 cacheMisses;
+  std::function<qint64()> currentTime;
+
+ public:
+  /**
+   *  @brief Creates a new TokenVerifier, that accepts no token until it is configured
+   */
+  TokenVerifier();
+
+  /**
+   *  @brief Creates a new TokenVerifier, that accepts no token until it is configured
+   *  @param [in] currentTime returns the current time in seconds since epoch. It is used to expire remembered tokens.
+   */
+  explicit TokenVerifier(const std::function<qint64()>& currentTime);
+
+  /**
+   *  @brief The verifier of the server, that is configured from the Configuration
+   */
+  static TokenVerifier& global();
+
+  /**
+   *  @brief Set the requirements for valid tokens
+   *  @param [in] publicKey is the public key of the auth server in .pem format
+   *  @param [in] issuer is the required issuer
+   *  @param [in] requiredClaims are the claims, that need to be true
+   *  @param [in] cacheSize is the maximum number of remembered tokens. 0 disables the cache.
+   *
+   *  If any of the requirements changed, every remembered token is forgotten.
+   */
+  void configure(const QString& publicKey, const QString& issuer, const QList<QString>& requiredClaims, int cacheSize = defaultCacheSize);
+
+  /**
+   *  @brief Check, if token is valid
+   */
+  bool verify(const QString& token);
+
+  /**
+   *  @brief Get the number of remembered tokens
+   */
+  int getCachedTokens() const;
+
+  /**
+   *  @brief Get the number of verifications, that were answered from the cache
+   */
+  quint64 getCacheHits() const;
+
+  /**
+   *  @brief Get the number of verifications, that needed a signature check
+   */
+  quint64 getCacheMisses() const;
+
+ private:
+  /**
+   *  @brief Check the signature and the claims of token
+   *  @param [out] expiration is set to the exp claim of a valid token, or 0 if it has none
+   */
+  bool verifySignature(const std::string& token, Expiration& expiration) const;
+};
+
+#endif  // TOKENVERIFIER_H
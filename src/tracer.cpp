@@ -0,0 +1,146 @@
+#include "tracer.h"
+
+Tracer::Span::Span(const char* name, const QString& job, Tracer& tracer)
+    : tracer(tracer), name(name), start(tracer.isEnabled() ? tracer.now() : -1) {
+  if(start != -1) {
+    this->job = job;
+  }
+}
+
+Tracer::Span::~Span() {
+  if(start != -1) {
+    tracer.complete(name, job, start);
+  }
+}
+
+Tracer::Tracer(): enabled(false), nextEvent(0), eventCount(0) {
+  clock.start();
+}
+
+Tracer& Tracer::global() {
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::setEnabled(bool enabled, int capacity) {
+  QMutexLocker locker(&mutex);
+  capacity = std::max(capacity, 1);
+  if(!enabled) {
+    // Free the buffer
+    events = QVector<Event>();
+    nextEvent = 0;
+    eventCount = 0;
+  } else if(capacity != events.size()) {
+    events = QVector<Event>(capacity);
+    nextEvent = 0;
+    eventCount = 0;
+  }
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+qint64 Tracer::now() const {
+  return clock.nsecsElapsed();
+}
+
+void Tracer::complete(const char* name, const QString& job, qint64 start, const QString& detail) {
+  if(!isEnabled()) {
+    return;
+  }
+  Event event;
+  event.name = name;
+  event.job = job;
+  event.detail = detail;
+  event.phase = 'X';
+  event.start = start;
+  event.duration = now() - start;
+  record(std::move(event));
+}
+
+void Tracer::instant(const char* name, const QString& job, const QString& detail) {
+  if(!isEnabled()) {
+    return;
+  }
+  Event event;
+  event.name = name;
+  event.job = job;
+  event.detail = detail;
+  event.phase = 'i';
+  event.start = now();
+  record(std::move(event));
+}
+
+void Tracer::clear() {
+  QMutexLocker locker(&mutex);
+  for(Event& event : events) {
+    event = Event();
+  }
+  nextEvent = 0;
+  eventCount = 0;
+}
+
+QJsonObject Tracer::toChromeTrace() const {
+  return exportEvents(nullptr);
+}
+
+QJsonObject Tracer::toChromeTrace(const QString& job) const {
+  return exportEvents(&job);
+}
+
+QJsonObject Tracer::exportEvents(const QString* job) const {
+  QMutexLocker locker(&mutex);
+  QJsonArray traceEvents;
+  QHash<QString, int> threads;
+  int firstEvent = (nextEvent - eventCount + events.size()) % std::max(events.size(), 1);
+  for(int i = 0; i < eventCount; i++) {
+    const Event& event = events[(firstEvent + i) % events.size()];
+    if(job != nullptr && (job->isEmpty() || event.job != *job)) {
+      continue;
+    }
+
+    auto thread = threads.constFind(event.job);
+    if(thread == threads.constEnd()) {
+      thread = threads.insert(event.job, threads.size() + 1);
+      QJsonObject threadName;
+      threadName["name"] = "thread_name";
+      threadName["ph"] = "M";
+      threadName["pid"] = 1;
+      threadName["tid"] = thread.value();
+      threadName["args"] = QJsonObject{{"name", event.job.isEmpty() ? QStringLiteral("scheduler") : event.job}};
+      traceEvents.append(threadName);
+    }
+
+    // Chrome traces use microseconds
+    QJsonObject traceEvent;
+    traceEvent["name"] = event.name;
+    traceEvent["cat"] = "job";
+    traceEvent["ph"] = QString(event.phase);
+    traceEvent["ts"] = event.start / 1000.0;
+    traceEvent["pid"] = 1;
+    traceEvent["tid"] = thread.value();
+    if(event.phase == 'X') {
+      traceEvent["dur"] = event.duration / 1000.0;
+    } else {
+      traceEvent["s"] = "t";
+    }
+    if(!event.detail.isEmpty()) {
+      traceEvent["args"] = QJsonObject{{"detail", event.detail}};
+    }
+    traceEvents.append(traceEvent);
+  }
+
+  QJsonObject trace;
+  trace["traceEvents"] = traceEvents;
+  trace["displayTimeUnit"] = "ms";
+  return trace;
+}
+
+void Tracer::record(Event&& event) {
+  QMutexLocker locker(&mutex);
+  // The buffer may have been freed after the enabled check
+  if(events.isEmpty()) {
+    return;
+  }
+  events[nextEvent] = std::move(event);
+  nextEvent = (nextEvent + 1) % events.size();
+  eventCount = std::min(eventCount + 1, events.size());
+}
@@ -0,0 +1,129 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+
+/**
+ *  @class Tracer
+ *  @brief Records timestamped events of the jobs in a ring buffer
+ *
+ *  The buffer has a fixed size. When it is full, the oldest events are
+ *  overwritten. The recorded events can be exported as Chrome trace-event
+ *  JSON, which can be opened in chrome://tracing or Perfetto. Every job is
+ *  shown as its own thread.
+ *
+ *  The tracer is disabled by default. A disabled tracer only checks an atomic
+ *  flag for every event. Callers check isEnabled, before they build the
+ *  detail of an event.
+ */
+class Tracer {
+ public:
+  static constexpr int defaultCapacity = 65536;
+
+ private:
+  struct Event {
+    const char* name = nullptr;
+    QString job;
+    QString detail;
+    char phase = 'X';
+    // Nanoseconds since the tracer was created
+    qint64 start = 0;
+    qint64 duration = 0;
+  };
+
+  std::atomic<bool> enabled;
+  QElapsedTimer clock;
+  mutable QMutex mutex;
+  QVector<Event> events;
+  int nextEvent;
+  int eventCount;
+
+ public:
+  /**
+   *  @brief The Span class records the duration of its own lifetime as a single event
+   */
+  class Span {
+   private:
+    Tracer& tracer;
+    const char* name;
+    QString job;
+    qint64 start;
+
+   public:
+    Span(const char* name, const QString& job, Tracer& tracer = Tracer::global());
+    ~Span();
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+  };
+
+  /**
+   *  @brief Creates a new, disabled Tracer
+   */
+  Tracer();
+
+  /**
+   *  @brief The tracer used by the scheduler
+   */
+  static Tracer& global();
+
+  /**
+   *  @brief Enable or disable recording. Resizing the buffer drops the recorded events.
+   *  @param [in] enabled enables recording
+   *  @param [in] capacity is the maximum number of events in the buffer
+   */
+  void setEnabled(bool enabled, int capacity = defaultCapacity);
+
+  inline bool isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   *  @brief The current time of the tracer in nanoseconds. Pass it to complete as start.
+   */
+  qint64 now() const;
+
+  /**
+   *  @brief Record an event, that started at start and ends now
+   *  @param [in] name has to be a string literal
+   */
+  void complete(const char* name, const QString& job, qint64 start, const QString& detail = QString());
+
+  /**
+   *  @brief Record an event without duration
+   *  @param [in] name has to be a string literal
+   */
+  void instant(const char* name, const QString& job, const QString& detail = QString());
+
+  /**
+   *  @brief Drop all recorded events
+   */
+  void clear();
+
+  /**
+   *  @brief Export the recorded events, from the oldest to the newest
+   *  @return A Chrome trace-event JSON object
+   */
+  QJsonObject toChromeTrace() const;
+
+  /**
+   *  @brief Export the recorded events of a single job, from the oldest to the newest
+   *  @param [in] job is the job of the events. An empty job matches no events.
+   *  @return A Chrome trace-event JSON object
+   */
+  QJsonObject toChromeTrace(const QString& job) const;
+
+ private:
+  void record(Event&& event);
+  // Exports every event, if job is nullptr
+  QJsonObject exportEvents(const QString* job) const;
+};
+
+#endif  // TRACER_H
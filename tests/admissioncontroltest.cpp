@@ -0,0 +1,110 @@
+#ifndef ADMISSIONCONTROL_TEST_CPP
+#define ADMISSIONCONTROL_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+
+#include "admissioncontrol.h"
+
+using namespace testing;
+
+AdmissionControl::Resources idleResources() {
+  AdmissionControl::Resources resources;
+  resources.load = 0.1;
+  resources.availableMemory = 8192;
+  return resources;
+}
+
+TEST(admissionControlTests, admitsEveryJobWithoutLimits) {
+  AdmissionControl admissionControl(idleResources);
+  for(int i = 0; i < 100; i++) {
+    ASSERT_TRUE(admissionControl.tryStart().admitted);
+  }
+  ASSERT_EQ(admissionControl.getRunningJobs(), 100);
+}
+
+TEST(admissionControlTests, rejectsJobsAboveMaxRunningJobs) {
+  AdmissionControl admissionControl(idleResources);
+  admissionControl.configure(2, 0, 0.0, 0);
+  ASSERT_TRUE(admissionControl.tryStart().admitted);
+  ASSERT_TRUE(admissionControl.tryStart().admitted);
+  AdmissionControl::Decision decision = admissionControl.tryStart();
+  ASSERT_FALSE(decision.admitted);
+  ASSERT_GT(decision.retryAfter, 0);
+  ASSERT_FALSE(decision.reason.isEmpty());
+
+  admissionControl.finish();
+  ASSERT_TRUE(admissionControl.tryStart().admitted);
+}
+
+TEST(admissionControlTests, retryAfterFollowsRuntimeOfJobs) {
+  AdmissionControl admissionControl(idleResources);
+  admissionControl.configure(2, 0, 0.0, 0);
+  admissionControl.tryStart();
+  admissionControl.finish(40.0);
+  admissionControl.tryStart();
+  admissionControl.tryStart();
+  // Two jobs with a mean runtime of 40 seconds are running, one of them finishes in about 20 seconds
+  ASSERT_EQ(admissionControl.tryStart().retryAfter, 20);
+}
+
+TEST(admissionControlTests, rejectsBatchesAboveMaxQueuedJobs) {
+  AdmissionControl admissionControl(idleResources);
+  admissionControl.configure(0, 10, 0.0, 0);
+  ASSERT_TRUE(admissionControl.tryQueue(8).admitted);
+  ASSERT_FALSE(admissionControl.tryQueue(3).admitted);
+  admissionControl.startQueued();
+  admissionControl.dequeue();
+  ASSERT_EQ(admissionControl.getQueuedJobs(), 6);
+  ASSERT_EQ(admissionControl.getRunningJobs(), 1);
+  ASSERT_TRUE(admissionControl.tryQueue(4).admitted);
+}
+
+TEST(admissionControlTests, queuedJobsWaitForFreeSlot) {
+  AdmissionControl admissionControl(idleResources);
+  admissionControl.configure(1, 0, 0.0, 0);
+  QSignalSpy slotFreedSpy(&admissionControl, &AdmissionControl::slotFreed);
+  ASSERT_TRUE(admissionControl.tryQueue(2).admitted);
+  ASSERT_TRUE(admissionControl.startQueued());
+  ASSERT_FALSE(admissionControl.startQueued());
+  ASSERT_EQ(admissionControl.getQueuedJobs(), 1);
+
+  admissionControl.finish();
+  ASSERT_EQ(slotFreedSpy.count(), 1);
+  ASSERT_TRUE(admissionControl.startQueued());
+  ASSERT_EQ(admissionControl.getQueuedJobs(), 0);
+}
+
+TEST(admissionControlTests, rejectsJobsUnderHighLoad) {
+  AdmissionControl admissionControl([]() {
+    AdmissionControl::Resources resources = idleResources();
+    resources.load = 3.0;
+    return resources;
+  });
+  admissionControl.configure(0, 0, 2.0, 0);
+  AdmissionControl::Decision decision = admissionControl.tryStart();
+  ASSERT_FALSE(decision.admitted);
+  ASSERT_EQ(decision.retryAfter, AdmissionControl::resourceRetryAfter);
+  ASSERT_EQ(admissionControl.getRunningJobs(), 0);
+}
+
+TEST(admissionControlTests, rejectsJobsWithoutAvailableMemory) {
+  AdmissionControl admissionControl([]() {
+    AdmissionControl::Resources resources = idleResources();
+    resources.availableMemory = 100;
+    return resources;
+  });
+  admissionControl.configure(0, 0, 0.0, 256);
+  ASSERT_FALSE(admissionControl.tryStart().admitted);
+  ASSERT_FALSE(admissionControl.tryQueue(1).admitted);
+  admissionControl.configure(0, 0, 0.0, 64);
+  ASSERT_TRUE(admissionControl.tryStart().admitted);
+}
+
+TEST(admissionControlTests, readSystemResourcesReadsMemory) {
+  ASSERT_GT(AdmissionControl::readSystemResources().availableMemory, 0);
+}
+
+#endif
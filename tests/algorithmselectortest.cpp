@@ -0,0 +1,82 @@
+#ifndef ALGORITHMSELECTOR_TEST_CPP
+#define ALGORITHMSELECTOR_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QSharedPointer>
+
+#include "algorithmselector.h"
+#include "planfeatures.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+PlanFeatures getFeatures(int moduleCount) {
+  PlanFeatures features;
+  features.moduleCount = moduleCount;
+  features.groupCount = moduleCount / 4;
+  features.conflictDensity = 0.1;
+  features.weekCount = 3;
+  features.dayCount = 18;
+  features.slotsPerDay = 6;
+  return features;
+}
+
+TEST(algorithmSelectorTests, extractCountsActiveModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  int activeModules = 0;
+  for(Module* module : plan->getModules()) {
+    activeModules += module->getActive() ? 1 : 0;
+  }
+  PlanFeatures features = PlanFeatures::extract(plan.get());
+  EXPECT_EQ(features.moduleCount, activeModules);
+  EXPECT_EQ(features.weekCount, plan->getWeeks().size());
+  EXPECT_GE(features.conflictDensity, 0.0);
+  EXPECT_LE(features.conflictDensity, 1.0);
+}
+
+TEST(algorithmSelectorTests, predictWithoutHistoryHasNoSamples) {
+  AlgorithmSelector selector;
+  ASSERT_EQ(selector.predict(getFeatures(100), "legacy-good").samples, 0);
+}
+
+TEST(algorithmSelectorTests, selectUsesPriorWithoutHistory) {
+  AlgorithmSelector selector;
+  EXPECT_EQ(selector.select(getFeatures(10), 60.0), "legacy-good");
+  EXPECT_EQ(selector.select(getFeatures(1000), 60.0), "legacy-fast");
+}
+
+TEST(algorithmSelectorTests, selectAvoidsGoodModeWhenHistoryIsSlow) {
+  AlgorithmSelector selector;
+  ScheduleScore score;
+  for(int i = 0; i < 5; i++) {
+    selector.record(getFeatures(10), "legacy-good", 500.0, score);
+  }
+  EXPECT_EQ(selector.select(getFeatures(10), 60.0), "legacy-fast");
+  EXPECT_EQ(selector.select(getFeatures(10), 1000.0), "legacy-good");
+}
+
+TEST(algorithmSelectorTests, predictScalesRuntimeWithModules) {
+  AlgorithmSelector selector;
+  selector.record(getFeatures(100), "legacy-fast", 10.0, ScheduleScore());
+  AlgorithmSelector::Prediction prediction = selector.predict(getFeatures(200), "legacy-fast");
+  EXPECT_EQ(prediction.samples, 1);
+  EXPECT_GT(prediction.runtime, 10.0);
+}
+
+TEST(algorithmSelectorTests, selectUsesExactForSmallPlans) {
+  AlgorithmSelector selector;
+  EXPECT_EQ(selector.select(getFeatures(20), 60.0, 30), "exact");
+  EXPECT_NE(selector.select(getFeatures(40), 60.0, 30), "exact");
+  EXPECT_NE(selector.select(getFeatures(20), 60.0, 0), "exact");
+}
+
+TEST(algorithmSelectorTests, resolveKeepsConcreteAlgorithms) {
+  AlgorithmSelector selector;
+  QSharedPointer<Plan> plan = getValidPlan();
+  EXPECT_EQ(selector.resolve("legacy-fast", plan.get(), 60.0), "legacy-fast");
+  EXPECT_NE(selector.resolve("auto", plan.get(), 60.0), "auto");
+}
+
+#endif
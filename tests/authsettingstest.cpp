@@ -0,0 +1,186 @@
+#ifndef AUTHSETTINGS_TEST_CPP
+#define AUTHSETTINGS_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QSignalSpy>
+#include <QString>
+#include <QTemporaryDir>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+#include "authsettings.h"
+#include "authsettingsrevalidator.h"
+#include "configuration.h"
+#include "configurationprovider.h"
+
+using namespace testing;
+
+const QString authTestPublicKey =
+    "-----BEGIN PUBLIC KEY-----\n"
+    "MIGfMA0GCSqGSIb3DQEBAQUAA4GNADCBiQKBgQCnpD8A1hQLmvkG0ey1h71GG+eX\n"
+    "9QYFMBIYZj3uhSQOJ9EfnfOGS7CeT1fCBietJ9KWSJ6/39yOBMC2W9vlBdJLVzuO\n"
+    "wJDny2CmyU96UA94otBJ5H2FIGZjEFJMzX3NN+VgIZuaudQfRyMj82nHgqLTEgwY\n"
+    "SiqZqvuSbZYYPbkPQQIDAQAB\n"
+    "-----END PUBLIC KEY-----\n";
+
+QList<QString> getRetrieveArguments(const QTemporaryDir& storage, const QString& authUrl) {
+  return QList<QString>{"pruefungsplaner-scheduler-tests",
+                        "--storage",
+                        storage.path(),
+                        "--legacy-scheduler-binary",
+                        "./SPA-algorithmus",
+                        "--retrieve",
+                        "--auth-server",
+                        authUrl};
+}
+
+AuthSettings getTestAuthSettings(const QString& authUrl) {
+  AuthSettings settings;
+  settings.authUrl = authUrl;
+  settings.publicKey = authTestPublicKey;
+  settings.issuer = "test-issuer";
+  return settings;
+}
+
+// Answers getPublicKey and getIssuer like the auth server
+void answerLikeAuthServer(QWebSocketServer& server) {
+  QObject::connect(&server, &QWebSocketServer::newConnection, [&server]() {
+    QWebSocket* socket = server.nextPendingConnection();
+    QObject::connect(socket, &QWebSocket::textMessageReceived, [socket](const QString& message) {
+      QJsonObject request = QJsonDocument::fromJson(message.toUtf8()).object();
+      QJsonObject response{{"jsonrpc", "2.0"}, {"id", request["id"]}};
+      response["result"] = request["method"].toString() == "getPublicKey" ? authTestPublicKey : QString("test-issuer");
+      socket->sendTextMessage(QJsonDocument(response).toJson(QJsonDocument::Compact));
+    });
+    QObject::connect(socket, &QWebSocket::disconnected, socket, &QObject::deleteLater);
+  });
+}
+
+TEST(authSettingsTests, settingsWithValidKeyAreValid) {
+  ASSERT_TRUE(getTestAuthSettings("ws://localhost:1").isValid());
+}
+
+TEST(authSettingsTests, settingsWithInvalidKeyAreInvalid) {
+  AuthSettings settings = getTestAuthSettings("ws://localhost:1");
+  settings.publicKey = "not a key";
+  ASSERT_FALSE(settings.isValid());
+  ASSERT_FALSE(AuthSettings().isValid());
+}
+
+TEST(authSettingsTests, cachedSettingsCanBeRead) {
+  QTemporaryDir storage;
+  AuthSettings settings = getTestAuthSettings("ws://localhost:1");
+  settings.retrievedAt = 1234;
+  ASSERT_TRUE(settings.writeCache(storage.path()));
+
+  AuthSettings cachedSettings = AuthSettings::readCache(storage.path());
+  ASSERT_EQ(cachedSettings.authUrl, settings.authUrl);
+  ASSERT_TRUE(cachedSettings.matches(settings));
+  ASSERT_EQ(cachedSettings.retrievedAt, 1234);
+}
+
+TEST(authSettingsTests, missingCacheIsInvalid) {
+  QTemporaryDir storage;
+  ASSERT_FALSE(AuthSettings::readCache(storage.path()).isValid());
+}
+
+TEST(authSettingsTests, configurationStartsWithCachedSettings) {
+  QTemporaryDir storage;
+  // Nothing listens on the auth url, the configuration must not wait for it
+  getTestAuthSettings("ws://127.0.0.1:1").writeCache(storage.path());
+  Configuration configuration(getRetrieveArguments(storage, "ws://127.0.0.1:1"));
+  ASSERT_EQ(configuration.getPublicKey(), authTestPublicKey);
+  ASSERT_EQ(configuration.getIssuer(), "test-issuer");
+}
+
+TEST(authSettingsTests, configurationIgnoresCacheOfOtherAuthServer) {
+  QTemporaryDir storage;
+  getTestAuthSettings("ws://127.0.0.1:2").writeCache(storage.path());
+  Configuration configuration(getRetrieveArguments(storage, "ws://127.0.0.1:1"));
+  ASSERT_EQ(configuration.getPublicKey(), "");
+}
+
+TEST(authSettingsTests, revalidatorCachesRetrievedSettings) {
+  QWebSocketServer authServer("auth", QWebSocketServer::NonSecureMode);
+  ASSERT_TRUE(authServer.listen(QHostAddress::LocalHost));
+  answerLikeAuthServer(authServer);
+  QString authUrl = "ws://127.0.0.1:" + QString::number(authServer.serverPort());
+
+  QTemporaryDir storage;
+  QSharedPointer<ConfigurationProvider> provider(new ConfigurationProvider(getRetrieveArguments(storage, authUrl)));
+  ASSERT_EQ(provider->getConfiguration()->getPublicKey(), "");
+
+  AuthSettingsRevalidator revalidator(provider);
+  QSignalSpy revalidatedSpy(&revalidator, &AuthSettingsRevalidator::revalidated);
+  ASSERT_TRUE(revalidator.start());
+  ASSERT_TRUE(revalidatedSpy.wait(5000));
+
+  ASSERT_TRUE(revalidatedSpy.first().first().toBool());
+  ASSERT_EQ(provider->getConfiguration()->getPublicKey(), authTestPublicKey);
+  ASSERT_EQ(provider->getConfiguration()->getIssuer(), "test-issuer");
+  ASSERT_TRUE(AuthSettings::readCache(storage.path()).isValid());
+}
+
+TEST(authSettingsTests, revalidatorKeepsUnchangedSettings) {
+  QWebSocketServer authServer("auth", QWebSocketServer::NonSecureMode);
+  ASSERT_TRUE(authServer.listen(QHostAddress::LocalHost));
+  answerLikeAuthServer(authServer);
+  QString authUrl = "ws://127.0.0.1:" + QString::number(authServer.serverPort());
+
+  QTemporaryDir storage;
+  getTestAuthSettings(authUrl).writeCache(storage.path());
+  QSharedPointer<ConfigurationProvider> provider(new ConfigurationProvider(getRetrieveArguments(storage, authUrl)));
+  QSharedPointer<const Configuration> configuration = provider->getConfiguration();
+
+  AuthSettingsRevalidator revalidator(provider);
+  QSignalSpy revalidatedSpy(&revalidator, &AuthSettingsRevalidator::revalidated);
+  ASSERT_TRUE(revalidator.start());
+  ASSERT_TRUE(revalidatedSpy.wait(5000));
+
+  ASSERT_FALSE(revalidatedSpy.first().first().toBool());
+  ASSERT_EQ(provider->getConfiguration(), configuration);
+}
+
+TEST(authSettingsTests, revalidatorKeepsCheckingAfterSuccess) {
+  QWebSocketServer authServer("auth", QWebSocketServer::NonSecureMode);
+  ASSERT_TRUE(authServer.listen(QHostAddress::LocalHost));
+  answerLikeAuthServer(authServer);
+  QString authUrl = "ws://127.0.0.1:" + QString::number(authServer.serverPort());
+
+  QTemporaryDir storage;
+  QSharedPointer<ConfigurationProvider> provider(new ConfigurationProvider(getRetrieveArguments(storage, authUrl)));
+  AuthSettingsRevalidator revalidator(provider, 50);
+  QSignalSpy revalidatedSpy(&revalidator, &AuthSettingsRevalidator::revalidated);
+  ASSERT_TRUE(revalidator.start());
+  ASSERT_TRUE(revalidatedSpy.wait(5000));
+  ASSERT_TRUE(revalidatedSpy.wait(5000));
+
+  // Only the first answer changed the settings
+  ASSERT_TRUE(revalidatedSpy.at(0).first().toBool());
+  ASSERT_FALSE(revalidatedSpy.at(1).first().toBool());
+  ASSERT_FALSE(revalidator.start());
+}
+
+TEST(authSettingsTests, revalidatorReportsUnreachableAuthServer) {
+  QTemporaryDir storage;
+  QSharedPointer<ConfigurationProvider> provider(new ConfigurationProvider(getRetrieveArguments(storage, "ws://127.0.0.1:1")));
+  AuthSettingsRevalidator revalidator(provider);
+  QSignalSpy failedSpy(&revalidator, &AuthSettingsRevalidator::revalidationFailed);
+  ASSERT_TRUE(revalidator.start());
+  ASSERT_TRUE(failedSpy.wait(5000));
+}
+
+TEST(authSettingsTests, revalidatorDoesNothingWithoutRetrieveOrCheck) {
+  QTemporaryDir storage;
+  QList<QString> arguments{"pruefungsplaner-scheduler-tests", "--storage", storage.path(), "--legacy-scheduler-binary", "./SPA-algorithmus"};
+  QSharedPointer<ConfigurationProvider> provider(new ConfigurationProvider(arguments));
+  AuthSettingsRevalidator revalidator(provider);
+  ASSERT_FALSE(revalidator.start());
+}
+
+#endif
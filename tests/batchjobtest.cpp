@@ -0,0 +1,111 @@
+#ifndef BATCHJOB_TEST_CPP
+#define BATCHJOB_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QString>
+
+#include "admissioncontrol.h"
+#include "batchjob.h"
+#include "configuration.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+QSharedPointer<const Configuration> getBatchConfiguration() {
+  QList<QString> arguments{"pruefungsplaner-scheduler-tests",
+                           "--storage",
+                           "/tmp",
+                           "--legacy-scheduler-binary",
+                           "./SPA-algorithmus",
+                           "--max-parallel-jobs",
+                           "2"};
+  return QSharedPointer<const Configuration>(new Configuration(arguments));
+}
+
+TEST(batchJobTests, applyPatchReplacesAndRemovesValues) {
+  QJsonObject target{{"name", "old"}, {"removed", 1}, {"nested", QJsonObject{{"a", 1}, {"b", 2}}}};
+  QJsonObject patch{{"name", "new"}, {"removed", QJsonValue::Null}, {"nested", QJsonObject{{"b", 3}}}};
+
+  QJsonObject patched = BatchJob::applyPatch(target, patch);
+
+  EXPECT_EQ(patched["name"].toString(), "new");
+  EXPECT_FALSE(patched.contains("removed"));
+  EXPECT_EQ(patched["nested"].toObject()["a"].toInt(), 1);
+  EXPECT_EQ(patched["nested"].toObject()["b"].toInt(), 3);
+}
+
+TEST(batchJobTests, startFailsWithoutVariants) {
+  BatchJob batch(getValidJsonPlan(), QJsonArray(), "legacy-fast", getBatchConfiguration());
+  ASSERT_FALSE(batch.start());
+}
+
+TEST(batchJobTests, startFailsWithUnknownAlgorithm) {
+  BatchJob batch(getValidJsonPlan(), QJsonArray{QJsonObject()}, "unknown", getBatchConfiguration());
+  ASSERT_FALSE(batch.start());
+}
+
+TEST(batchJobTests, resultsAreRankedWithFailuresLast) {
+  QJsonArray variants{getInvalidJsonPlan(), getValidJsonPlan(), getValidJsonPlan()};
+  BatchJob batch(QJsonObject(), variants, "legacy-fast", getBatchConfiguration());
+  ASSERT_TRUE(batch.start());
+
+  QTime limit = QTime::currentTime().addMSecs(1500);
+  while(QTime::currentTime() < limit && !batch.isFinished()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_TRUE(batch.isFinished());
+  ASSERT_EQ(batch.getProgress(), 1.0);
+  QJsonArray results = batch.getResults();
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_TRUE(results[0].toObject().contains("score"));
+  EXPECT_TRUE(results[1].toObject().contains("score"));
+  EXPECT_EQ(results[2].toObject()["variant"].toInt(), 0);
+  EXPECT_TRUE(results[2].toObject().contains("error"));
+}
+
+TEST(batchJobTests, variantsWaitForFreeSlot) {
+  AdmissionControl admissionControl;
+  admissionControl.configure(1, 0, 0.0, 0);
+  // Another job holds the only slot
+  ASSERT_TRUE(admissionControl.tryStart().admitted);
+  ASSERT_TRUE(admissionControl.tryQueue(1).admitted);
+  BatchJob batch(QJsonObject(), QJsonArray{getValidJsonPlan()}, "legacy-fast", getBatchConfiguration());
+  batch.setAdmissionControl(&admissionControl);
+  ASSERT_TRUE(batch.start());
+  ASSERT_EQ(admissionControl.getQueuedJobs(), 1);
+
+  admissionControl.finish();
+  QTime limit = QTime::currentTime().addMSecs(1500);
+  while(QTime::currentTime() < limit && !batch.isFinished()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  ASSERT_TRUE(batch.isFinished());
+  ASSERT_EQ(admissionControl.getQueuedJobs(), 0);
+  ASSERT_EQ(admissionControl.getRunningJobs(), 0);
+  EXPECT_TRUE(batch.getResults()[0].toObject().contains("score"));
+}
+
+TEST(batchJobTests, stopWhileVariantsAreParsedFinishesThem) {
+  QJsonArray variants{getValidJsonPlan(), getValidJsonPlan(), getValidJsonPlan()};
+  BatchJob batch(QJsonObject(), variants, "legacy-fast", getBatchConfiguration());
+  ASSERT_TRUE(batch.start());
+  // The running variants are parsed in the pool, so they have no scheduler yet
+  batch.stop();
+
+  QTime limit = QTime::currentTime().addMSecs(1500);
+  while(QTime::currentTime() < limit && !batch.isFinished()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  ASSERT_TRUE(batch.isFinished());
+  for(const QJsonValue& result : batch.getResults()) {
+    EXPECT_EQ(result.toObject()["error"].toString(), "Batch was stopped");
+  }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef BRANCHANDBOUND_TEST_CPP
+#define BRANCHANDBOUND_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QSharedPointer>
+#include <QVector>
+#include <atomic>
+
+#include "branchandbound.h"
+#include "plan.h"
+#include "planhelper.h"
+#include "planindex.h"
+#include "scheduleevaluator.h"
+
+using namespace testing;
+
+TEST(branchAndBoundTests, scheduleKeepsHardConstraints) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  BranchAndBound::Result result = BranchAndBound(index, index.readAssignment()).run(10000, 2);
+  ASSERT_TRUE(result.feasible);
+
+  index.writeAssignment(result.assignment);
+  ScheduleScore score = ScheduleEvaluator::evaluate(plan.get());
+  ASSERT_TRUE(score.isFeasible());
+  ASSERT_EQ(score.softPenalty, result.penalty);
+}
+
+TEST(branchAndBoundTests, smallPlanIsSolvedOptimally) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  BranchAndBound::Result result = BranchAndBound(index, index.readAssignment()).run(10000, 2);
+  ASSERT_TRUE(result.optimal);
+  ASSERT_GT(result.nodes, 0);
+}
+
+TEST(branchAndBoundTests, threadsFindTheSamePenalty) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  BranchAndBound::Result single = BranchAndBound(index, index.readAssignment()).run(10000, 1);
+  BranchAndBound::Result parallel = BranchAndBound(index, index.readAssignment()).run(10000, 4);
+  ASSERT_TRUE(single.optimal);
+  ASSERT_TRUE(parallel.optimal);
+  ASSERT_EQ(single.penalty, parallel.penalty);
+}
+
+TEST(branchAndBoundTests, stoppedSearchReturnsInitialSchedule) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  BranchAndBound::Result optimal = BranchAndBound(index, index.readAssignment()).run(10000, 1);
+  ASSERT_TRUE(optimal.feasible);
+
+  std::atomic<bool> stop(true);
+  BranchAndBound::Result stopped = BranchAndBound(index, optimal.assignment).run(10000, 2, &stop);
+  // A schedule at the lower bound is optimal, even if the search was stopped
+  ASSERT_EQ(stopped.optimal, stopped.penalty <= stopped.lowerBound);
+  ASSERT_TRUE(stopped.feasible);
+  ASSERT_EQ(stopped.penalty, optimal.penalty);
+}
+
+TEST(branchAndBoundTests, moduleWithoutTimeslotIsInfeasible) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  ASSERT_TRUE(index.isMovable(0));
+  for(int timeslot = 0; timeslot < index.getTimeslotCount(); timeslot++) {
+    QList<Group*> activeGroups = index.getTimeslot(timeslot)->getActiveGroups();
+    for(Group* group : index.getModule(0)->getGroups()) {
+      activeGroups.removeAll(group);
+    }
+    index.getTimeslot(timeslot)->setActiveGroups(activeGroups);
+  }
+
+  PlanIndex restrictedIndex(plan.get());
+  BranchAndBound::Result result = BranchAndBound(restrictedIndex, restrictedIndex.readAssignment()).run(10000, 2);
+  ASSERT_FALSE(result.feasible);
+  ASSERT_TRUE(result.optimal);
+}
+
+#endif
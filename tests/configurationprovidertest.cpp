@@ -0,0 +1,59 @@
+#ifndef CONFIGURATIONPROVIDER_TEST_CPP
+#define CONFIGURATIONPROVIDER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QSharedPointer>
+#include <QSignalSpy>
+#include <QString>
+
+#include "configuration.h"
+#include "configurationprovider.h"
+
+using namespace testing;
+
+QList<QString> getDefaultArguments() {
+  return QList<QString>{"pruefungsplaner-scheduler-tests", "--storage", "/tmp", "--legacy-scheduler-binary", "./SPA-algorithmus"};
+}
+
+TEST(configurationProviderTests, reloadPublishesNewConfiguration) {
+  ConfigurationProvider provider(getDefaultArguments());
+  QSharedPointer<const Configuration> oldConfiguration = provider.getConfiguration();
+  QSignalSpy reloadedSpy(&provider, &ConfigurationProvider::configurationReloaded);
+
+  ASSERT_TRUE(provider.reload());
+
+  ASSERT_NE(provider.getConfiguration(), oldConfiguration);
+  ASSERT_EQ(reloadedSpy.count(), 1);
+}
+
+TEST(configurationProviderTests, reloadKeepsOldSnapshotIntact) {
+  ConfigurationProvider provider(getDefaultArguments());
+  QSharedPointer<const Configuration> snapshot = provider.getConfiguration();
+  QString binary = snapshot->getLegacySchedulerAlgorithmBinary();
+
+  ASSERT_TRUE(provider.reload());
+
+  ASSERT_EQ(snapshot->getLegacySchedulerAlgorithmBinary(), binary);
+}
+
+TEST(configurationProviderTests, reloadFailsForFixedConfiguration) {
+  QSharedPointer<const Configuration> configuration(new Configuration(getDefaultArguments()));
+  ConfigurationProvider provider(configuration);
+  QSignalSpy failedSpy(&provider, &ConfigurationProvider::reloadFailed);
+
+  ASSERT_FALSE(provider.reload());
+
+  ASSERT_EQ(provider.getConfiguration(), configuration);
+  ASSERT_EQ(failedSpy.count(), 1);
+}
+
+TEST(configurationProviderTests, invalidConfigurationThrowsInsteadOfExiting) {
+  QList<QString> arguments = getDefaultArguments();
+  arguments << "--default-scheduler"
+            << "does-not-exist";
+  ASSERT_THROW(Configuration(arguments, false), ConfigurationException);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef CPUPLACEMENT_TEST_CPP
+#define CPUPLACEMENT_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QRegularExpression>
+#include <QVector>
+
+#include "cpuplacement.h"
+#include "placedprocess.h"
+
+using namespace testing;
+
+TEST(cpuPlacementTests, parseCpuListParsesRanges) {
+  ASSERT_EQ(CpuPlacement::parseCpuList("0-3,8,10-11\n"), QVector<int>({0, 1, 2, 3, 8, 10, 11}));
+}
+
+TEST(cpuPlacementTests, parseCpuListRejectsInvalidLists) {
+  ASSERT_TRUE(CpuPlacement::parseCpuList("3-1").isEmpty());
+  ASSERT_TRUE(CpuPlacement::parseCpuList("a-b").isEmpty());
+  ASSERT_TRUE(CpuPlacement::parseCpuList("1-2-3").isEmpty());
+}
+
+TEST(cpuPlacementTests, disabledPlacementDoesNotPlace) {
+  CpuPlacement placement({{0, 1, 2, 3}});
+  ASSERT_FALSE(placement.acquire().isPlaced());
+}
+
+TEST(cpuPlacementTests, acquireLeavesReservedCoresFree) {
+  CpuPlacement placement({{0, 1, 2, 3}});
+  placement.configure(CpuPlacement::spreadPolicy, 1, 2);
+  ASSERT_EQ(placement.acquire().cpus, QVector<int>({2}));
+  ASSERT_EQ(placement.acquire().cpus, QVector<int>({3}));
+  ASSERT_FALSE(placement.acquire().isPlaced());
+}
+
+TEST(cpuPlacementTests, unplacedJobKeepsOffReservedCores) {
+  CpuPlacement placement({{0, 1, 2}, {3, 4}});
+  placement.configure(CpuPlacement::spreadPolicy, 3, 1);
+  CpuPlacement::Placement job = placement.acquire();
+  ASSERT_FALSE(job.isPlaced());
+  ASSERT_EQ(job.cpus, QVector<int>({1, 2, 3, 4}));
+}
+
+TEST(cpuPlacementTests, disabledPlacementAllowsEveryCore) {
+  CpuPlacement placement({{0, 1, 2, 3}});
+  placement.configure(CpuPlacement::nonePolicy, 1, 1);
+  ASSERT_TRUE(placement.acquire().cpus.isEmpty());
+}
+
+TEST(cpuPlacementTests, acquireSpreadsJobsOverNodes) {
+  CpuPlacement placement({{0, 1, 2, 3}, {4, 5, 6, 7}});
+  placement.configure(CpuPlacement::spreadPolicy, 2, 0);
+  CpuPlacement::Placement first = placement.acquire();
+  CpuPlacement::Placement second = placement.acquire();
+  ASSERT_TRUE(first.isPlaced());
+  ASSERT_TRUE(second.isPlaced());
+  ASSERT_NE(first.node, second.node);
+}
+
+TEST(cpuPlacementTests, acquireKeepsJobOnSingleNode) {
+  CpuPlacement placement({{0, 1}, {2, 3}});
+  placement.configure(CpuPlacement::spreadPolicy, 3, 0);
+  ASSERT_FALSE(placement.acquire().isPlaced());
+}
+
+TEST(cpuPlacementTests, releaseReturnsCores) {
+  CpuPlacement placement({{0, 1}});
+  placement.configure(CpuPlacement::spreadPolicy, 2, 0);
+  CpuPlacement::Placement job = placement.acquire();
+  ASSERT_TRUE(job.isPlaced());
+  ASSERT_FALSE(placement.acquire().isPlaced());
+  placement.release(job);
+  ASSERT_EQ(placement.acquire().cpus, QVector<int>({0, 1}));
+}
+
+TEST(cpuPlacementTests, reconfigureKeepsHeldCores) {
+  CpuPlacement placement({{0, 1}});
+  placement.configure(CpuPlacement::spreadPolicy, 1, 0);
+  CpuPlacement::Placement job = placement.acquire();
+  placement.configure(CpuPlacement::nonePolicy, 1, 0);
+  placement.configure(CpuPlacement::spreadPolicy, 1, 0);
+  CpuPlacement::Placement secondJob = placement.acquire();
+  ASSERT_TRUE(secondJob.isPlaced());
+  ASSERT_NE(secondJob.cpus, job.cpus);
+  ASSERT_FALSE(placement.acquire().isPlaced());
+  placement.release(job);
+  ASSERT_EQ(placement.acquire().cpus, job.cpus);
+}
+
+TEST(cpuPlacementTests, placementIsReportedAsJson) {
+  CpuPlacement placement({{4, 5}});
+  placement.configure(CpuPlacement::spreadPolicy, 1, 0);
+  QJsonObject json = placement.acquire().toJsonObject();
+  ASSERT_EQ(json["node"].toInt(), 0);
+  ASSERT_EQ(json["cpus"].toArray().size(), 1);
+  ASSERT_EQ(json["cpus"].toArray()[0].toInt(), 4);
+}
+
+TEST(cpuPlacementTests, placedProcessRunsOnItsCores) {
+  CpuPlacement placement;
+  placement.configure(CpuPlacement::spreadPolicy, 1, 0);
+  CpuPlacement::Placement job = placement.acquire();
+  ASSERT_TRUE(job.isPlaced());
+
+  PlacedProcess process;
+  process.setPlacement(job);
+  process.start("cat", QStringList{"/proc/self/status"});
+  ASSERT_TRUE(process.waitForFinished());
+  QRegularExpressionMatch match = QRegularExpression("Cpus_allowed_list:\\s*(\\S+)").match(QString::fromLatin1(process.readAll()));
+  ASSERT_TRUE(match.hasMatch());
+  ASSERT_EQ(CpuPlacement::parseCpuList(match.captured(1)), job.cpus);
+}
+
+#endif
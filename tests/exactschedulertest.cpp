@@ -0,0 +1,128 @@
+#ifndef EXACTSCHEDULER_TEST_CPP
+#define EXACTSCHEDULER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QTime>
+
+#include "cpuplacement.h"
+#include "exactscheduler.h"
+#include "plan.h"
+#include "planhelper.h"
+#include "scheduleevaluator.h"
+#include "schedulerfactory.h"
+
+using namespace testing;
+
+TEST(exactSchedulerTests, startSchedulingReturnsFalseWithoutPlan) {
+  ExactScheduler scheduler(nullptr);
+  ASSERT_FALSE(scheduler.startScheduling());
+}
+
+TEST(exactSchedulerTests, smallPlanIsScheduledOptimally) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  ExactScheduler scheduler(plan);
+
+  bool emittedFinished = false;
+  QObject::connect(&scheduler, &Scheduler::finishedScheduling, [&emittedFinished](auto) {
+    emittedFinished = true;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(5000);
+  while(QTime::currentTime() < limit && !emittedFinished) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_TRUE(emittedFinished);
+  ASSERT_TRUE(ScheduleEvaluator::evaluate(plan.get()).isFeasible());
+  ASSERT_TRUE(scheduler.getMetrics()["optimal"].toBool());
+  ASSERT_GE(scheduler.getMetrics()["peakProcessHeapGrowth"].toDouble(), 0.0);
+}
+
+TEST(exactSchedulerTests, searchUsesTheCoresOfItsPlacement) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  CpuPlacement placement({{0, 1, 2}});
+  placement.configure(CpuPlacement::spreadPolicy, 2, 0);
+  ExactScheduler scheduler(plan);
+  scheduler.setCpuPlacement(&placement);
+
+  bool emittedFinished = false;
+  QObject::connect(&scheduler, &Scheduler::finishedScheduling, [&emittedFinished](auto) {
+    emittedFinished = true;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(5000);
+  while(QTime::currentTime() < limit && !emittedFinished) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_TRUE(emittedFinished);
+  ASSERT_EQ(scheduler.getMetrics()["threads"].toInt(), 2);
+  ASSERT_EQ(scheduler.getMetrics()["placement"].toObject()["cpus"].toArray().size(), 2);
+  // The cores are free again
+  ASSERT_TRUE(placement.acquire().isPlaced());
+}
+
+TEST(exactSchedulerTests, unplacedSearchUsesASingleThread) {
+  ExactScheduler scheduler(getSmallValidPlan(8));
+  ASSERT_EQ(scheduler.getMetrics()["threads"].toInt(), 1);
+  ASSERT_TRUE(scheduler.getMetrics()["placement"].isNull());
+}
+
+TEST(exactSchedulerTests, largePlanIsRejected) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  ExactScheduler scheduler(plan, 10000, 4);
+
+  QString failure;
+  QObject::connect(&scheduler, &Scheduler::failedScheduling, [&failure](QString message) {
+    failure = message;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(1000);
+  while(QTime::currentTime() < limit && failure.isEmpty()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_THAT(failure.toStdString(), HasSubstr("up to 4 modules"));
+}
+
+TEST(exactSchedulerTests, maxModulesZeroDisablesTheScheduler) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(1);
+  ExactScheduler scheduler(plan, 10000, 0);
+
+  QString failure;
+  QObject::connect(&scheduler, &Scheduler::failedScheduling, [&failure](QString message) {
+    failure = message;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(1000);
+  while(QTime::currentTime() < limit && failure.isEmpty()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_THAT(failure.toStdString(), HasSubstr("disabled"));
+}
+
+TEST(exactSchedulerTests, secondStartWhileRunningFails) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  ExactScheduler scheduler(plan);
+  ASSERT_TRUE(scheduler.startScheduling());
+  ASSERT_FALSE(scheduler.startScheduling());
+}
+
+TEST(exactSchedulerTests, factoryCreatesExactScheduler) {
+  ASSERT_TRUE(SchedulerFactory::isValidAlgorithm("exact"));
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef FEASIBILITYCHECK_TEST_CPP
+#define FEASIBILITYCHECK_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QSharedPointer>
+
+#include "feasibilitycheck.h"
+#include "plan.h"
+#include "planindex.h"
+
+using namespace testing;
+
+// Activate groups only in the first timeslot, or in no timeslot at all
+void restrictGroups(Plan* plan, const QList<Group*>& groups, bool keepFirstTimeslot) {
+  bool firstTimeslot = true;
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        QList<Group*> activeGroups = timeslot->getActiveGroups();
+        for(Group* group : groups) {
+          activeGroups.removeAll(group);
+          if(firstTimeslot && keepFirstTimeslot) {
+            activeGroups.append(group);
+          }
+        }
+        timeslot->setActiveGroups(activeGroups);
+        firstTimeslot = false;
+      }
+    }
+  }
+}
+
+// Find two movable modules, that share a group
+bool findConflictingModules(const PlanIndex& index, int& first, int& second) {
+  for(first = 0; first < index.getModuleCount(); first++) {
+    if(!index.isMovable(first)) {
+      continue;
+    }
+    for(int other : index.getConflicts(first)) {
+      if(index.isMovable(other)) {
+        second = other;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TEST(feasibilityCheckTests, validPlanIsFeasible) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  FeasibilityCheck::Result result = FeasibilityCheck::check(plan.get());
+  ASSERT_TRUE(result.feasible) << result.reason.toStdString();
+}
+
+TEST(feasibilityCheckTests, nullptrIsNotRejected) {
+  ASSERT_TRUE(FeasibilityCheck::check(nullptr).feasible);
+}
+
+TEST(feasibilityCheckTests, moduleWithoutGroupsIsFeasible) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  ASSERT_GT(index.getModuleCount(), 0);
+  ASSERT_TRUE(index.isMovable(0));
+  index.getModule(0)->setGroups(QList<Group*>());
+
+  FeasibilityCheck::Result result = FeasibilityCheck::check(plan.get());
+  ASSERT_TRUE(result.feasible) << result.reason.toStdString();
+}
+
+TEST(feasibilityCheckTests, moduleWithoutTimeslotIsInfeasible) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  ASSERT_GT(index.getModuleCount(), 0);
+  ASSERT_TRUE(index.isMovable(0));
+  restrictGroups(plan.get(), index.getModule(0)->getGroups(), false);
+
+  FeasibilityCheck::Result result = FeasibilityCheck::check(plan.get());
+  ASSERT_FALSE(result.feasible);
+  ASSERT_TRUE(result.reason.contains(index.getModule(0)->getNumber()));
+}
+
+TEST(feasibilityCheckTests, groupWithMoreModulesThanTimeslotsIsInfeasible) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  int first;
+  int second;
+  ASSERT_TRUE(findConflictingModules(index, first, second));
+  QList<Group*> groups = index.getModule(first)->getGroups() + index.getModule(second)->getGroups();
+  restrictGroups(plan.get(), groups, true);
+
+  FeasibilityCheck::Result result = FeasibilityCheck::check(plan.get());
+  ASSERT_FALSE(result.feasible);
+  ASSERT_THAT(result.reason.toStdString(), HasSubstr("only 1 timeslots"));
+}
+
+#endif
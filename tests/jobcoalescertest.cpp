@@ -0,0 +1,83 @@
+#ifndef JOBCOALESCER_TEST_CPP
+#define JOBCOALESCER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QJsonObject>
+#include <QSharedPointer>
+
+#include "jobcoalescer.h"
+#include "scheduler.h"
+
+using namespace testing;
+
+class CoalescedTestScheduler: public Scheduler {
+ public:
+  bool stopped = false;
+
+  bool startScheduling() override {
+    return true;
+  }
+
+  void stopScheduling() override {
+    stopped = true;
+  }
+};
+
+TEST(jobCoalescerTests, keyDependsOnPlanAlgorithmAndSettings) {
+  QJsonObject plan{{"modules", 1}};
+  QJsonObject otherPlan{{"modules", 2}};
+  ASSERT_EQ(JobCoalescer::createKey(plan, "legacy-fast", "a=1"), JobCoalescer::createKey(plan, "legacy-fast", "a=1"));
+  ASSERT_NE(JobCoalescer::createKey(plan, "legacy-fast", "a=1"), JobCoalescer::createKey(plan, "legacy-good", "a=1"));
+  ASSERT_NE(JobCoalescer::createKey(plan, "legacy-fast", "a=1"), JobCoalescer::createKey(otherPlan, "legacy-fast", "a=1"));
+  ASSERT_NE(JobCoalescer::createKey(plan, "legacy-fast", "a=1"), JobCoalescer::createKey(plan, "legacy-fast", "a=2"));
+}
+
+TEST(jobCoalescerTests, subscribeReturnsRunningJob) {
+  JobCoalescer coalescer;
+  QSharedPointer<Scheduler> scheduler(new CoalescedTestScheduler());
+  coalescer.add("key", scheduler, "legacy-fast");
+  emit scheduler->updateProgress(0.5);
+
+  JobCoalescer::Job job = coalescer.subscribe("key");
+  ASSERT_EQ(job.scheduler, scheduler);
+  ASSERT_EQ(job.algorithm, "legacy-fast");
+  ASSERT_EQ(job.progress, 0.5);
+  ASSERT_EQ(coalescer.getSubscriberCount("key"), 2);
+  ASSERT_TRUE(coalescer.subscribe("other key").scheduler.isNull());
+}
+
+TEST(jobCoalescerTests, onlyLastSubscriberStopsJob) {
+  JobCoalescer coalescer;
+  QSharedPointer<Scheduler> scheduler(new CoalescedTestScheduler());
+  coalescer.add("key", scheduler, "legacy-fast");
+  coalescer.subscribe("key");
+
+  ASSERT_FALSE(coalescer.unsubscribe("key", scheduler.data()));
+  ASSERT_TRUE(coalescer.unsubscribe("key", scheduler.data()));
+  // A stopped job is not shared anymore
+  ASSERT_TRUE(coalescer.subscribe("key").scheduler.isNull());
+}
+
+TEST(jobCoalescerTests, finishedJobIsNotShared) {
+  JobCoalescer coalescer;
+  QSharedPointer<Scheduler> scheduler(new CoalescedTestScheduler());
+  coalescer.add("key", scheduler, "legacy-fast");
+  emit scheduler->finishedScheduling(QSharedPointer<Plan>());
+
+  ASSERT_TRUE(coalescer.subscribe("key").scheduler.isNull());
+  ASSERT_FALSE(coalescer.unsubscribe("key", scheduler.data()));
+}
+
+TEST(jobCoalescerTests, deletedJobIsNotShared) {
+  JobCoalescer coalescer;
+  QSharedPointer<Scheduler> scheduler(new CoalescedTestScheduler());
+  coalescer.add("key", scheduler, "legacy-fast");
+  scheduler.reset();
+
+  ASSERT_TRUE(coalescer.subscribe("key").scheduler.isNull());
+  ASSERT_EQ(coalescer.getSubscriberCount("key"), 0);
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef JOBJOURNAL_TEST_CPP
+#define JOBJOURNAL_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "jobjournal.h"
+
+using namespace testing;
+
+TEST(jobJournalTests, submittedJobIsUnfinishedAfterRestart) {
+  QTemporaryDir directory;
+  QString id;
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    id = journal.submitJob(QJsonObject{{"name", "plan"}}, "legacy-good");
+    journal.startJob(id);
+  }
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open());
+  QList<JobJournal::JobRecord> unfinishedJobs = journal.getUnfinishedJobs();
+  ASSERT_EQ(unfinishedJobs.size(), 1);
+  EXPECT_EQ(unfinishedJobs[0].id, id);
+  EXPECT_EQ(unfinishedJobs[0].algorithm, "legacy-good");
+  EXPECT_EQ(journal.readPlan(id)["name"].toString(), "plan");
+}
+
+TEST(jobJournalTests, finishedJobIsNotUnfinishedAfterRestart) {
+  QTemporaryDir directory;
+  QString id;
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    id = journal.submitJob(QJsonObject(), "legacy-fast");
+    journal.startJob(id);
+    journal.finishJob(id, QJsonObject{{"name", "result"}});
+  }
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open());
+  EXPECT_TRUE(journal.getUnfinishedJobs().isEmpty());
+  EXPECT_EQ(journal.getJob(id).state, JobJournal::Finished);
+  EXPECT_EQ(journal.readResult(id)["name"].toString(), "result");
+}
+
+TEST(jobJournalTests, failedJobKeepsMessageAfterRestart) {
+  QTemporaryDir directory;
+  QString id;
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    id = journal.submitJob(QJsonObject(), "legacy-fast");
+    journal.failJob(id, "message");
+  }
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open());
+  EXPECT_EQ(journal.getJob(id).state, JobJournal::Failed);
+  EXPECT_EQ(journal.getJob(id).message, "message");
+}
+
+TEST(jobJournalTests, incompleteLastRecordIsIgnored) {
+  QTemporaryDir directory;
+  QString id;
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    id = journal.submitJob(QJsonObject(), "legacy-fast");
+  }
+  QFile journalFile(QDir(directory.path()).filePath(JobJournal::journalFileName));
+  ASSERT_TRUE(journalFile.open(QFile::WriteOnly | QFile::Append));
+  journalFile.write("{\"type\":\"finished\",\"id\":\"" + id.toUtf8());
+  journalFile.close();
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open());
+  ASSERT_EQ(journal.getUnfinishedJobs().size(), 1);
+}
+
+TEST(jobJournalTests, expiredJobsAreRemoved) {
+  QTemporaryDir directory;
+  QString id;
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    id = journal.submitJob(QJsonObject(), "legacy-fast");
+    journal.finishJob(id, QJsonObject());
+  }
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open(-1));
+  ASSERT_TRUE(journal.containsJob(id));
+
+  JobJournal expiringJournal(QDir(directory.path()));
+  QTest::qWait(10);
+  ASSERT_TRUE(expiringJournal.open(0));
+  ASSERT_FALSE(expiringJournal.containsJob(id));
+}
+
+TEST(jobJournalTests, removeExpiredJobsKeepsJournalOpen) {
+  QTemporaryDir directory;
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open(0));
+  QString expiredId = journal.submitJob(QJsonObject(), "legacy-fast");
+  journal.finishJob(expiredId, QJsonObject());
+  QTest::qWait(10);
+
+  ASSERT_TRUE(journal.removeExpiredJobs());
+  ASSERT_FALSE(journal.containsJob(expiredId));
+
+  // Records after the compaction are appended to the compacted journal
+  QString id = journal.submitJob(QJsonObject(), "legacy-fast");
+  journal.sync();
+  JobJournal replayedJournal(QDir(directory.path()));
+  ASSERT_TRUE(replayedJournal.open());
+  ASSERT_TRUE(replayedJournal.containsJob(id));
+  ASSERT_FALSE(replayedJournal.containsJob(expiredId));
+}
+
+TEST(jobJournalTests, storedJobIsRecordedAfterItsFilesWereWritten) {
+  QTemporaryDir directory;
+  QString id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+  {
+    JobJournal journal(QDir(directory.path()));
+    ASSERT_TRUE(journal.open());
+    ASSERT_TRUE(JobJournal::writeFile(journal.planPath(id), QJsonObject{{"name", "plan"}}));
+    journal.submitStoredJob(id, "legacy-good");
+    ASSERT_TRUE(JobJournal::writeFile(journal.resultPath(id), QJsonObject{{"name", "result"}}));
+    journal.finishStoredJob(id);
+  }
+
+  JobJournal journal(QDir(directory.path()));
+  ASSERT_TRUE(journal.open());
+  EXPECT_EQ(journal.getJob(id).state, JobJournal::Finished);
+  EXPECT_EQ(journal.readPlan(id)["name"].toString(), "plan");
+  EXPECT_EQ(journal.readResult(id)["name"].toString(), "result");
+}
+
+#endif
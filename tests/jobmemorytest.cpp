@@ -0,0 +1,59 @@
+#ifndef JOBMEMORY_TEST_CPP
+#define JOBMEMORY_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "jobmemory.h"
+
+using namespace testing;
+
+TEST(jobMemoryTests, peakIsZeroBeforeStart) {
+  JobMemory memory;
+  memory.sample();
+  ASSERT_EQ(memory.getPeakProcessHeapGrowth(), 0);
+}
+
+TEST(jobMemoryTests, peakContainsAllocationsOfTheJob) {
+  JobMemory memory;
+  memory.start();
+  {
+    std::vector<char> buffer(16 * 1024 * 1024, 1);
+    memory.sample();
+    ASSERT_EQ(buffer[buffer.size() - 1], 1);
+  }
+  memory.sample();
+  ASSERT_GE(memory.getPeakProcessHeapGrowth(), 16 * 1024 * 1024);
+}
+
+TEST(jobMemoryTests, finishedJobIsNotSampledAnymore) {
+  JobMemory memory;
+  memory.start();
+  memory.finish();
+  qint64 peak = memory.getPeakProcessHeapGrowth();
+  std::vector<char> buffer(16 * 1024 * 1024, 1);
+  memory.sample();
+  ASSERT_EQ(memory.getPeakProcessHeapGrowth(), peak);
+  ASSERT_EQ(buffer[0], 1);
+}
+
+TEST(jobMemoryTests, startResetsThePeak) {
+  JobMemory memory;
+  memory.start();
+  {
+    std::vector<char> buffer(16 * 1024 * 1024, 1);
+    memory.sample();
+    ASSERT_EQ(buffer[0], 1);
+  }
+  memory.finish();
+  memory.start();
+  ASSERT_EQ(memory.getPeakProcessHeapGrowth(), 0);
+}
+
+TEST(jobMemoryTests, residentBytesArePositive) {
+  ASSERT_GT(JobMemory::getResidentBytes(), 0);
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef JOBPIPELINE_TEST_CPP
+#define JOBPIPELINE_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QTime>
+#include <QTimer>
+#include <functional>
+
+#include "jobpipeline.h"
+
+using namespace testing;
+
+JobPipeline::Task addInPool(int a, int b, int& result, QThread*& stageThread) {
+  result = co_await JobPipeline::runInPool([a, b, &stageThread]() {
+    stageThread = QThread::currentThread();
+    return a + b;
+  });
+}
+
+JobPipeline::Task countTimeouts(QTimer* timer, int& timeouts) {
+  co_await JobPipeline::waitFor(timer, &QTimer::timeout);
+  timeouts++;
+  co_await JobPipeline::waitFor(timer, &QTimer::timeout);
+  timeouts++;
+}
+
+void processEventsUntil(const std::function<bool()>& done) {
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && !done()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+}
+
+TEST(jobPipelineTests, runInPoolResumesWithResult) {
+  int result = 0;
+  QThread* stageThread = nullptr;
+  JobPipeline::Task task = addInPool(2, 3, result, stageThread);
+  ASSERT_TRUE(task.isRunning());
+
+  processEventsUntil([&task]() {
+    return !task.isRunning();
+  });
+
+  ASSERT_FALSE(task.isRunning());
+  ASSERT_EQ(result, 5);
+  ASSERT_NE(stageThread, QThread::currentThread());
+}
+
+TEST(jobPipelineTests, waitForResumesOnEverySignal) {
+  QTimer timer;
+  timer.setInterval(1);
+  int timeouts = 0;
+  JobPipeline::Task task = countTimeouts(&timer, timeouts);
+  ASSERT_EQ(timeouts, 0);
+  timer.start();
+
+  processEventsUntil([&task]() {
+    return !task.isRunning();
+  });
+
+  ASSERT_EQ(timeouts, 2);
+}
+
+TEST(jobPipelineTests, destroyedTaskIsNotResumed) {
+  QTimer timer;
+  timer.setInterval(1);
+  int timeouts = 0;
+  {
+    JobPipeline::Task task = countTimeouts(&timer, timeouts);
+  }
+  timer.start();
+
+  QTime limit = QTime::currentTime().addMSecs(50);
+  while(QTime::currentTime() < limit) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+
+  ASSERT_EQ(timeouts, 0);
+}
+
+TEST(jobPipelineTests, destroyingTaskWaitsForRunningStage) {
+  int result = 0;
+  QThread* stageThread = nullptr;
+  {
+    JobPipeline::Task task = addInPool(2, 3, result, stageThread);
+  }
+  // The stage finished, but the task was not resumed
+  ASSERT_NE(stageThread, nullptr);
+  ASSERT_EQ(result, 0);
+}
+
+#endif
@@ -6,15 +6,21 @@
 #include <testdatahelper.h>
 
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
 #include <QSharedPointer>
 #include <QSignalSpy>
 #include <QString>
+#include <QTemporaryDir>
 
+#include "branchandbound.h"
 #include "legacyscheduler.h"
 #include "plan.h"
+#include "planhelper.h"
+#include "planindex.h"
+#include "scheduleevaluator.h"
 
 using namespace testing;
 
@@ -87,6 +93,33 @@ TEST(legacySchedulerTests, startSchedulingAddsScheduleToPlanOnSuccess) {
   ASSERT_FALSE(unscheduledModule);
 }
 
+TEST(legacySchedulerTests, startSchedulingWithPresolveSchedulesEveryModule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  LegacyScheduler scheduler(plan);
+  scheduler.setPresolve(true);
+
+  bool finished = false;
+  bool failed = false;
+  QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&finished]() {
+    finished = true;
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::failedScheduling, [&failed]() {
+    failed = true;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && !finished && !failed) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_TRUE(finished);
+  ASSERT_FALSE(failed);
+  ScheduleScore score = ScheduleEvaluator::evaluate(plan.get());
+  ASSERT_EQ(score.unscheduledModules, 0);
+  ASSERT_EQ(score.groupConflicts, 0);
+}
+
 TEST(legacySchedulerTests, startSchedulingEmitsPointerFromConstructorOnSuccess) {
   QSharedPointer<Plan> plan = getValidPlan();
   LegacyScheduler scheduler(plan);
@@ -235,6 +268,21 @@ TEST(legacySchedulerTests, startSchedulingEmitsFullProgressAfterSuccess) {
   ASSERT_EQ(lastProgressUpdate, 1.0) << "Expected the last updateProgress signal to emit 1.0, but got " << lastProgressUpdate;
 }
 
+TEST(legacySchedulerTests, finishedSchedulerHasTheScoreOfItsSchedule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  LegacyScheduler scheduler(plan);
+  QSignalSpy finishedSpy(&scheduler, &Scheduler::finishedScheduling);
+  ASSERT_FALSE(scheduler.hasScore());
+
+  scheduler.startScheduling();
+  ASSERT_TRUE(finishedSpy.wait(500));
+
+  ASSERT_TRUE(scheduler.hasScore());
+  ScheduleScore score = ScheduleEvaluator::evaluate(plan.get());
+  ASSERT_EQ(scheduler.getScore().softPenalty, score.softPenalty);
+  ASSERT_EQ(scheduler.getScore().unscheduledModules, score.unscheduledModules);
+}
+
 TEST(legacySchedulerTests, startSchedulingRemovesOldScheduledModulesFromPlan) {
   QSharedPointer<Plan> plan = getValidPlan();
   // Preschedule a module twice, so at least one of them gets removed
@@ -261,4 +309,281 @@ TEST(legacySchedulerTests, startSchedulingRemovesOldScheduledModulesFromPlan) {
   EXPECT_FALSE(plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->getModules().contains(plan->getModules()[0]) &&
                plan->getWeeks()[0]->getDays()[0]->getTimeslots()[1]->getModules().contains(plan->getModules()[0]));
 }
+
+// Runs the SPA-algorithmus stub with script and waits until the scheduler is done
+bool runStubScheduler(
+    const QByteArray& script, LegacyScheduler::SchedulingMode mode, bool& finished, bool& failed, int* gapUpdates = nullptr) {
+  QTemporaryDir scriptDirectory;
+  QFile scriptFile(scriptDirectory.filePath("script"));
+  if(!scriptFile.open(QFile::WriteOnly)) {
+    return false;
+  }
+  QSharedPointer<Plan> plan = getValidPlan();
+  // Every active module is in the first timeslot, independent of the files the stub gets
+  QFile scheduleFile(scriptDirectory.filePath("schedule.csv"));
+  if(!scheduleFile.open(QFile::WriteOnly)) {
+    return false;
+  }
+  for(Module* module : plan->getModules()) {
+    if(module->getActive()) {
+      scheduleFile.write("1;1;" + module->getNumber().toUtf8() + "\n");
+    }
+  }
+  scheduleFile.close();
+  scriptFile.write(QByteArray(script).replace("schedule\n", "schedule " + scheduleFile.fileName().toUtf8() + "\n"));
+  scriptFile.close();
+  qputenv("SPA_STUB_SCRIPT", scriptFile.fileName().toUtf8());
+
+  LegacyScheduler scheduler(plan, "./SPA-algorithmus-stub", false, mode);
+  QCoreApplication::connect(&scheduler, &Scheduler::updateGap, [gapUpdates]() {
+    if(gapUpdates != nullptr) {
+      (*gapUpdates)++;
+    }
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&finished]() {
+    finished = true;
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::failedScheduling, [&failed]() {
+    failed = true;
+  });
+  bool started = scheduler.startScheduling();
+
+  QTime limit = QTime::currentTime().addMSecs(2000);
+  while(started && QTime::currentTime() < limit && !finished && !failed) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  qunsetenv("SPA_STUB_SCRIPT");
+  return started;
+}
+
+TEST(legacySchedulerTests, goodModeReadsReportedResultDirectory) {
+  bool finished = false;
+  bool failed = false;
+  ASSERT_TRUE(runStubScheduler("softbest 20\nschedule\nexit 0\n", LegacyScheduler::Good, finished, failed));
+  ASSERT_TRUE(finished);
+  ASSERT_FALSE(failed);
+}
+
+TEST(legacySchedulerTests, reportedDirectoryOutsideOfWorkingDirectoryIsKept) {
+  QTemporaryDir resultDirectory;
+  QFile scheduleFile(resultDirectory.filePath("SPA-planung-pruef.csv"));
+  ASSERT_TRUE(scheduleFile.open(QFile::WriteOnly));
+  for(Module* module : getValidPlan()->getModules()) {
+    if(module->getActive()) {
+      scheduleFile.write("1;1;" + module->getNumber().toUtf8() + "\n");
+    }
+  }
+  scheduleFile.close();
+
+  bool finished = false;
+  bool failed = false;
+  QByteArray script = "print Details in: " + scheduleFile.fileName().toUtf8() + "\nexit 0\n";
+  ASSERT_TRUE(runStubScheduler(script, LegacyScheduler::Good, finished, failed));
+  ASSERT_TRUE(finished);
+  ASSERT_TRUE(QFileInfo(scheduleFile.fileName()).exists());
+}
+
+TEST(legacySchedulerTests, stuckAlgorithmGetsStopped) {
+  bool finished = false;
+  bool failed = false;
+  ASSERT_TRUE(runStubScheduler("stuck 12\n", LegacyScheduler::Good, finished, failed));
+  ASSERT_FALSE(finished);
+  ASSERT_TRUE(failed);
+}
+
+TEST(legacySchedulerTests, fastModeReportsNoGap) {
+  bool finished = false;
+  bool failed = false;
+  int gapUpdates = 0;
+  ASSERT_TRUE(runStubScheduler("softbest 20\nsoftbest 0\nschedule\nexit 0\n", LegacyScheduler::Fast, finished, failed, &gapUpdates));
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(gapUpdates, 0);
+}
+
+// Runs the stub in good mode with a feasible schedule of a small plan, that every schedule command of script writes
+bool runInterimScheduleStub(const QByteArray& script, double gapThreshold, bool& finished, int& gapUpdates) {
+  QSharedPointer<Plan> plan = getSmallValidPlan(8);
+  PlanIndex index(plan.get());
+  index.writeAssignment(BranchAndBound(index, index.readAssignment()).run(5000, 1).assignment);
+
+  QTemporaryDir scriptDirectory;
+  QFile scheduleFile(scriptDirectory.filePath("schedule.csv"));
+  if(!scheduleFile.open(QFile::WriteOnly)) {
+    return false;
+  }
+  int dayNumber = 0;
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      dayNumber++;
+      int slotNumber = 0;
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        slotNumber++;
+        for(Module* module : timeslot->getModules()) {
+          if(module->getActive()) {
+            scheduleFile.write(QByteArray::number(dayNumber) + ";" + QByteArray::number(slotNumber) + ";" + module->getNumber().toUtf8() +
+                               "\n");
+          }
+        }
+      }
+    }
+  }
+  scheduleFile.close();
+  QFile scriptFile(scriptDirectory.filePath("script"));
+  if(!scriptFile.open(QFile::WriteOnly)) {
+    return false;
+  }
+  scriptFile.write(QByteArray(script).replace("schedule\n", "schedule " + scheduleFile.fileName().toUtf8() + "\n"));
+  scriptFile.close();
+  qputenv("SPA_STUB_SCRIPT", scriptFile.fileName().toUtf8());
+
+  LegacyScheduler scheduler(plan, "./SPA-algorithmus-stub", false, LegacyScheduler::Good);
+  scheduler.setGapThreshold(gapThreshold);
+  QCoreApplication::connect(&scheduler, &Scheduler::updateGap, [&gapUpdates]() {
+    gapUpdates++;
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&finished]() {
+    finished = true;
+  });
+  bool started = scheduler.startScheduling();
+
+  QTime limit = QTime::currentTime().addMSecs(3000);
+  while(started && QTime::currentTime() < limit && !finished) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  qunsetenv("SPA_STUB_SCRIPT");
+  return started;
+}
+
+TEST(legacySchedulerTests, goodModeReportsGapOfInterimSchedule) {
+  bool finished = false;
+  int gapUpdates = 0;
+  ASSERT_TRUE(runInterimScheduleStub("schedule\nsoftbest 20\nsleep 500\nschedule\nexit 0\n", 0.0, finished, gapUpdates));
+  ASSERT_TRUE(finished);
+  ASSERT_GE(gapUpdates, 1);
+}
+
+TEST(legacySchedulerTests, smallGapInterruptsAlgorithm) {
+  bool finished = false;
+  int gapUpdates = 0;
+  // Every gap is smaller than this threshold, so the first interim schedule ends the job instead of the long sleep
+  ASSERT_TRUE(runInterimScheduleStub("schedule\nsoftbest 20\nsleep 10000\nschedule\nexit 0\n", 1.5, finished, gapUpdates));
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(gapUpdates, 1);
+}
+
+TEST(legacySchedulerTests, defaultScriptOfTheStubSchedulesEveryModule) {
+  qunsetenv("SPA_STUB_SCRIPT");
+  QSharedPointer<Plan> plan = getValidPlan();
+  LegacyScheduler scheduler(plan, "./SPA-algorithmus-stub", false, LegacyScheduler::Fast);
+  bool finished = false;
+  bool failed = false;
+  QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&finished]() {
+    finished = true;
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::failedScheduling, [&failed]() {
+    failed = true;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(2000);
+  while(QTime::currentTime() < limit && !finished && !failed) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  ASSERT_TRUE(finished);
+  ASSERT_FALSE(failed);
+}
+
+TEST(legacySchedulerTests, missingScheduleFailsScheduling) {
+  bool finished = false;
+  bool failed = false;
+  ASSERT_TRUE(runStubScheduler("exit 0\n", LegacyScheduler::Fast, finished, failed));
+  ASSERT_FALSE(finished);
+  ASSERT_TRUE(failed);
+}
+
+TEST(legacySchedulerTests, secondStartWhileRunningFails) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  LegacyScheduler scheduler(plan);
+  ASSERT_TRUE(scheduler.startScheduling());
+  ASSERT_FALSE(scheduler.startScheduling());
+}
+
+TEST(legacySchedulerTests, stopBeforeProcessStartFailsScheduling) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  LegacyScheduler scheduler(plan);
+  bool finished = false;
+  bool failed = false;
+  QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&finished]() {
+    finished = true;
+  });
+  QCoreApplication::connect(&scheduler, &Scheduler::failedScheduling, [&failed]() {
+    failed = true;
+  });
+  // The plan is checked and written in the pool, so the process has not started yet
+  ASSERT_TRUE(scheduler.startScheduling());
+  scheduler.stopScheduling();
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && !finished && !failed) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_FALSE(finished);
+  ASSERT_TRUE(failed);
+}
+
+TEST(legacySchedulerTests, deletingRunningSchedulerDoesNotEmitSignals) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  bool emitted = false;
+  {
+    LegacyScheduler scheduler(plan);
+    QCoreApplication::connect(&scheduler, &Scheduler::finishedScheduling, [&emitted]() {
+      emitted = true;
+    });
+    QCoreApplication::connect(&scheduler, &Scheduler::failedScheduling, [&emitted]() {
+      emitted = true;
+    });
+    ASSERT_TRUE(scheduler.startScheduling());
+  }
+
+  QTime limit = QTime::currentTime().addMSecs(100);
+  while(QTime::currentTime() < limit) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+
+  ASSERT_FALSE(emitted);
+}
+
+TEST(legacySchedulerTests, startSchedulingFailsFastOnInfeasiblePlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  module->setActive(true);
+  ASSERT_FALSE(module->getGroups().isEmpty());
+  // No timeslot has all groups of the module active
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        QList<Group*> activeGroups = timeslot->getActiveGroups();
+        activeGroups.removeAll(module->getGroups().first());
+        timeslot->setActiveGroups(activeGroups);
+      }
+    }
+  }
+  // The binary does not exist, so the failure can not come from SPA-algorithmus
+  LegacyScheduler scheduler(plan, "./does-not-exist");
+
+  QString failReason;
+  QObject::connect(&scheduler, &Scheduler::failedScheduling, [&failReason](QString message) {
+    failReason = message;
+  });
+  ASSERT_TRUE(scheduler.startScheduling());
+
+  QTime limit = QTime::currentTime().addMSecs(100);
+  while(QTime::currentTime() < limit && failReason.isEmpty()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+
+  ASSERT_THAT(failReason.toStdString(), HasSubstr("has no timeslot"));
+}
+
 #endif
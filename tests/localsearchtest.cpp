@@ -0,0 +1,107 @@
+#ifndef LOCALSEARCH_TEST_CPP
+#define LOCALSEARCH_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include "localsearch.h"
+#include "plan.h"
+#include "planindex.h"
+#include "scheduleevaluator.h"
+
+using namespace testing;
+
+// Schedule every module in the first timeslot, that keeps the hard constraints
+QVector<int> greedyAssignment(const PlanIndex& index) {
+  QVector<int> assignment(index.getModuleCount(), -1);
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    for(int timeslot = 0; timeslot < index.getTimeslotCount() && assignment[module] == -1; timeslot++) {
+      bool free = index.isAdmissible(module, timeslot);
+      for(int other : index.getConflicts(module)) {
+        free &= assignment[other] != timeslot;
+      }
+      if(free) {
+        assignment[module] = timeslot;
+      }
+    }
+  }
+  return assignment;
+}
+
+bool keepsHardConstraints(const PlanIndex& index, const QVector<int>& assignment) {
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(assignment[module] == -1) {
+      continue;
+    }
+    if(!index.isAdmissible(module, assignment[module])) {
+      return false;
+    }
+    for(int other : index.getConflicts(module)) {
+      if(assignment[other] == assignment[module]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST(localSearchTests, penaltyMatchesScheduleEvaluator) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  QVector<int> assignment = greedyAssignment(index);
+  index.writeAssignment(assignment);
+
+  LocalSearch search(index, index.readAssignment());
+  ASSERT_EQ(search.penalty(index.readAssignment()), ScheduleEvaluator::evaluate(plan.get()).softPenalty);
+}
+
+TEST(localSearchTests, runDoesNotIncreasePenalty) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  QVector<int> assignment = greedyAssignment(index);
+
+  LocalSearch::Result result = LocalSearch(index, assignment).run(100, 2);
+  ASSERT_EQ(result.initialPenalty, LocalSearch(index, assignment).penalty(assignment));
+  ASSERT_LE(result.finalPenalty, result.initialPenalty);
+}
+
+TEST(localSearchTests, runKeepsHardConstraints) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  QVector<int> assignment = greedyAssignment(index);
+  ASSERT_TRUE(keepsHardConstraints(index, assignment));
+
+  LocalSearch::Result result = LocalSearch(index, assignment).run(100, 2);
+  ASSERT_TRUE(keepsHardConstraints(index, result.assignment));
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    ASSERT_EQ(result.assignment[module] == -1, assignment[module] == -1);
+  }
+}
+
+TEST(localSearchTests, writeAssignmentUpdatesPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  LocalSearch::Result result = LocalSearch(index, greedyAssignment(index)).run(50, 1);
+
+  index.writeAssignment(result.assignment);
+  ASSERT_EQ(ScheduleEvaluator::evaluate(plan.get()).softPenalty, result.finalPenalty);
+}
+
+TEST(localSearchTests, stopEndsTheSearchBeforeItsTimeLimit) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanIndex index(plan.get());
+  QVector<int> assignment = greedyAssignment(index);
+  std::atomic<bool> stop(true);
+
+  QElapsedTimer timer;
+  timer.start();
+  LocalSearch::Result result = LocalSearch(index, assignment).run(10000, 2, &stop);
+  ASSERT_LT(timer.elapsed(), 1000);
+  ASSERT_TRUE(keepsHardConstraints(index, result.assignment));
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef PLAN_HELPER_H
+#define PLAN_HELPER_H
+
+/**
+ * This file contains plans for the tests of the exact scheduler and its bounds
+ */
+
+#include <testdatahelper.h>
+
+#include <QSharedPointer>
+
+#include "plan.h"
+
+// The valid plan with only the first count active modules, so it is small enough to be solved optimally
+inline QSharedPointer<Plan> getSmallValidPlan(int count) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  int active = 0;
+  for(Module* module : plan->getModules()) {
+    if(module->getActive() && active < count) {
+      active++;
+    } else {
+      module->setActive(false);
+    }
+  }
+  return plan;
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef PLANPRESOLVER_TEST_CPP
+#define PLANPRESOLVER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QJsonObject>
+#include <QSharedPointer>
+
+#include "plan.h"
+#include "planpresolver.h"
+
+using namespace testing;
+
+bool containsModule(Plan* plan, const QString& number) {
+  for(Module* module : plan->getModules()) {
+    if(module->getNumber() == number) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Module* getMovableModule(Plan* plan) {
+  for(Module* module : plan->getModules()) {
+    if(module->getActive() && module->getOrigin() != "EIT" && !module->getGroups().isEmpty()) {
+      return module;
+    }
+  }
+  return nullptr;
+}
+
+TEST(planPresolverTests, presolveOfNullptrReturnsNullptr) {
+  PlanPresolver presolver;
+  ASSERT_TRUE(presolver.presolve(nullptr).isNull());
+}
+
+TEST(planPresolverTests, presolveDoesNotChangePlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QJsonObject jsonPlan = plan->toJsonObject();
+  PlanPresolver presolver;
+  presolver.presolve(plan.get());
+  ASSERT_EQ(plan->toJsonObject(), jsonPlan);
+}
+
+TEST(planPresolverTests, presolveRemovesInactiveModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ASSERT_GE(plan->getModules().size(), 1);
+  plan->getModules()[0]->setActive(false);
+  QString number = plan->getModules()[0]->getNumber();
+
+  PlanPresolver presolver;
+  QSharedPointer<Plan> presolvedPlan = presolver.presolve(plan.get());
+  ASSERT_FALSE(containsModule(presolvedPlan.get(), number));
+  ASSERT_GE(presolver.getStatistics().inactiveModules, 1);
+}
+
+TEST(planPresolverTests, presolveFixesModuleWithSingleTimeslot) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = getMovableModule(plan.get());
+  ASSERT_NE(module, nullptr);
+  // The groups of the module are only active in the first timeslot
+  bool firstTimeslot = true;
+  for(Week* week : plan->getWeeks()) {
+    for(Day* day : week->getDays()) {
+      for(Timeslot* timeslot : day->getTimeslots()) {
+        QList<Group*> activeGroups = timeslot->getActiveGroups();
+        for(Group* group : module->getGroups()) {
+          if(firstTimeslot && !activeGroups.contains(group)) {
+            activeGroups.append(group);
+          } else if(!firstTimeslot) {
+            activeGroups.removeAll(group);
+          }
+        }
+        timeslot->setActiveGroups(activeGroups);
+        firstTimeslot = false;
+      }
+    }
+  }
+
+  PlanPresolver presolver;
+  QSharedPointer<Plan> presolvedPlan = presolver.presolve(plan.get());
+  ASSERT_FALSE(containsModule(presolvedPlan.get(), module->getNumber()));
+  ASSERT_GE(presolver.getStatistics().forcedModules, 1);
+
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0];
+  timeslot->setModules(QList<Module*>());
+  ASSERT_TRUE(presolver.restore(plan.get()));
+  ASSERT_TRUE(timeslot->getModules().contains(module));
+}
+
+TEST(planPresolverTests, presolveKeepsTimeslotNumbers) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanPresolver presolver;
+  QSharedPointer<Plan> presolvedPlan = presolver.presolve(plan.get());
+
+  ASSERT_EQ(presolvedPlan->getWeeks().size(), plan->getWeeks().size());
+  int removedTimeslots = 0;
+  for(int week = 0; week < plan->getWeeks().size(); week++) {
+    QList<Day*> days = plan->getWeeks()[week]->getDays();
+    QList<Day*> presolvedDays = presolvedPlan->getWeeks()[week]->getDays();
+    ASSERT_EQ(presolvedDays.size(), days.size());
+    for(int day = 0; day < days.size(); day++) {
+      int timeslots = days[day]->getTimeslots().size();
+      int presolvedTimeslots = presolvedDays[day]->getTimeslots().size();
+      ASSERT_LE(presolvedTimeslots, timeslots);
+      ASSERT_GE(presolvedTimeslots, std::min(timeslots, 1));
+      removedTimeslots += timeslots - presolvedTimeslots;
+    }
+  }
+  ASSERT_EQ(removedTimeslots, presolver.getStatistics().deadTimeslots);
+}
+
+TEST(planPresolverTests, presolveAccountsForEveryGroup) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanPresolver presolver;
+  QSharedPointer<Plan> presolvedPlan = presolver.presolve(plan.get());
+  const PlanPresolver::Statistics& statistics = presolver.getStatistics();
+  ASSERT_EQ(presolvedPlan->getGroups().size() + statistics.unusedGroups + statistics.mergedGroups, plan->getGroups().size());
+}
+
+TEST(planPresolverTests, presolvedModulesOnlyUseRemainingGroups) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanPresolver presolver;
+  QSharedPointer<Plan> presolvedPlan = presolver.presolve(plan.get());
+  QList<Group*> groups = presolvedPlan->getGroups();
+  for(Module* module : presolvedPlan->getModules()) {
+    for(Group* group : module->getGroups()) {
+      ASSERT_TRUE(groups.contains(group));
+    }
+  }
+}
+
+TEST(planPresolverTests, restoreWithoutPresolveSucceeds) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  PlanPresolver presolver;
+  ASSERT_TRUE(presolver.restore(plan.get()));
+}
+
+#endif
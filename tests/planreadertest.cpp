@@ -0,0 +1,94 @@
+#ifndef PLANREADER_TEST_CPP
+#define PLANREADER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "planreader.h"
+
+using namespace testing;
+
+TEST(planReaderTests, estimateSizeIsCloseToCompactJson) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  qint64 size = QJsonDocument(jsonPlan).toJson(QJsonDocument::Compact).size();
+  qint64 estimate = PlanReader::estimateSize(jsonPlan);
+  ASSERT_GE(estimate, size * 0.8);
+  ASSERT_LE(estimate, size * 2.0);
+}
+
+TEST(planReaderTests, estimateSizeStopsEarly) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  qint64 estimate = PlanReader::estimateSize(jsonPlan, 10);
+  ASSERT_GT(estimate, 10);
+  ASSERT_LT(estimate, PlanReader::estimateSize(jsonPlan));
+}
+
+TEST(planReaderTests, estimateSizeCountsUtf8Bytes) {
+  QJsonObject jsonPlan{{"name", QString::fromUtf8("Prüfung \xE2\x82\xAC \xF0\x9F\x93\x9D \"\\")}};
+  qint64 size = QJsonDocument(jsonPlan).toJson(QJsonDocument::Compact).size();
+  // The estimate counts a comma for every member
+  ASSERT_GE(PlanReader::estimateSize(jsonPlan), size);
+  ASSERT_LE(PlanReader::estimateSize(jsonPlan), size + 1);
+}
+
+TEST(planReaderTests, readJsonRejectsLargeJsonBeforeParsing) {
+  PlanReader reader(10);
+  ASSERT_TRUE(reader.readJson("{\"modules\": [").isNull());
+  ASSERT_EQ(reader.getError(), PlanReader::TooLarge);
+}
+
+TEST(planReaderTests, checkSizeRejectsLargePlan) {
+  PlanReader reader(100);
+  ASSERT_FALSE(reader.checkSize(getValidJsonPlan()));
+  ASSERT_EQ(reader.getError(), PlanReader::TooLarge);
+}
+
+TEST(planReaderTests, checkSizeAcceptsEverythingWithoutLimit) {
+  PlanReader reader;
+  ASSERT_TRUE(reader.checkSize(getValidJsonPlan()));
+}
+
+TEST(planReaderTests, readFileReadsPlan) {
+  QTemporaryDir directory;
+  QFile file(directory.filePath("plan.json"));
+  ASSERT_TRUE(file.open(QFile::WriteOnly));
+  file.write(QJsonDocument(getValidJsonPlan()).toJson());
+  file.close();
+
+  PlanReader reader;
+  QSharedPointer<Plan> plan = reader.readFile(file.fileName());
+  ASSERT_FALSE(plan.isNull());
+  ASSERT_EQ(plan->getModules().size(), getValidPlan()->getModules().size());
+}
+
+TEST(planReaderTests, readFileRejectsLargeFileBeforeReading) {
+  QTemporaryDir directory;
+  QFile file(directory.filePath("plan.json"));
+  ASSERT_TRUE(file.open(QFile::WriteOnly));
+  file.write(QJsonDocument(getValidJsonPlan()).toJson());
+  file.close();
+
+  PlanReader reader(100);
+  ASSERT_TRUE(reader.readFile(file.fileName()).isNull());
+  ASSERT_EQ(reader.getError(), PlanReader::TooLarge);
+}
+
+TEST(planReaderTests, readFileFailsOnMissingFile) {
+  PlanReader reader;
+  ASSERT_TRUE(reader.readFile("/does/not/exist.json").isNull());
+  ASSERT_EQ(reader.getError(), PlanReader::ReadError);
+}
+
+TEST(planReaderTests, readJsonFailsOnInvalidJson) {
+  PlanReader reader;
+  ASSERT_TRUE(reader.readJson("{\"modules\": [").isNull());
+  ASSERT_EQ(reader.getError(), PlanReader::ParseError);
+}
+
+#endif
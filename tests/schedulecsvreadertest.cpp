@@ -0,0 +1,134 @@
+#ifndef SCHEDULECSVREADER_TEST_CPP
+#define SCHEDULECSVREADER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+#include <QTemporaryDir>
+
+#include "plan.h"
+#include "schedulecsvreader.h"
+
+using namespace testing;
+
+void writeScheduleFile(const QTemporaryDir& directory, const QByteArray& content) {
+  QFile scheduleFile(directory.path() + "/" + ScheduleCsvReader::scheduleFileName);
+  ASSERT_TRUE(scheduleFile.open(QFile::WriteOnly));
+  scheduleFile.write(content);
+  scheduleFile.close();
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsWithoutScheduleFile) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsWithNullptrPlan) {
+  QTemporaryDir directory;
+  writeScheduleFile(directory, "");
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(nullptr));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleAddsModulesToTimeslots) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  ASSERT_GE(plan->getModules().size(), 2);
+  ASSERT_GE(plan->getWeeks()[0]->getDays().size(), 2);
+  ASSERT_GE(plan->getWeeks()[0]->getDays()[1]->getTimeslots().size(), 2);
+  Module* firstModule = plan->getModules()[0];
+  Module* secondModule = plan->getModules()[1];
+  writeScheduleFile(directory,
+                    "1;1;" + firstModule->getNumber().toUtf8() + ";ignored\r\n2;2;" + secondModule->getNumber().toUtf8() + "\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_TRUE(reader.readSchedule(plan.get()));
+
+  EXPECT_TRUE(plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->getModules().contains(firstModule));
+  EXPECT_TRUE(plan->getWeeks()[0]->getDays()[1]->getTimeslots()[1]->getModules().contains(secondModule));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleRemovesOldSchedule) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[0]->getTimeslots()[1];
+  timeslot->addModule(module);
+  writeScheduleFile(directory, "1;1;" + module->getNumber().toUtf8() + "\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_TRUE(reader.readSchedule(plan.get()));
+
+  EXPECT_FALSE(timeslot->getModules().contains(module));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsOnUnknownModule) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  writeScheduleFile(directory, "1;1;this-module-does-not-exist\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsOnTimeslotOutOfRange) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  writeScheduleFile(directory, "1;100000;" + plan->getModules()[0]->getNumber().toUtf8() + "\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsOnTruncatedLine) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  writeScheduleFile(directory, "1;1\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleFailsOnEmptyFile) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  writeScheduleFile(directory, "");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleAcceptsEmptyFileWithoutActiveModules) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  for(Module* module : plan->getModules()) {
+    module->setActive(false);
+  }
+  writeScheduleFile(directory, "");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_TRUE(reader.readSchedule(plan.get()));
+}
+
+TEST(scheduleCsvReaderTests, readScheduleKeepsPlanOnError) {
+  QTemporaryDir directory;
+  QSharedPointer<Plan> plan = getValidPlan();
+  Module* module = plan->getModules()[0];
+  Timeslot* timeslot = plan->getWeeks()[0]->getDays()[0]->getTimeslots()[1];
+  timeslot->addModule(module);
+  writeScheduleFile(directory, "1;1;" + module->getNumber().toUtf8() + "\n1;1;this-module-does-not-exist\n");
+
+  ScheduleCsvReader reader(directory.path());
+  ASSERT_FALSE(reader.readSchedule(plan.get()));
+
+  EXPECT_TRUE(timeslot->getModules().contains(module));
+  EXPECT_FALSE(plan->getWeeks()[0]->getDays()[0]->getTimeslots()[0]->getModules().contains(module));
+}
+
+#endif
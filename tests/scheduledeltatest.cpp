@@ -0,0 +1,81 @@
+#ifndef SCHEDULEDELTA_TEST_CPP
+#define SCHEDULEDELTA_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <testdatahelper.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSharedPointer>
+
+#include "plan.h"
+#include "planindex.h"
+#include "scheduledelta.h"
+
+using namespace testing;
+
+// Schedule the modules round robin over the timeslots
+void scheduleRoundRobin(Plan* plan) {
+  PlanIndex index(plan);
+  QVector<int> assignment(index.getModuleCount(), -1);
+  for(int module = 0; module < index.getModuleCount() && index.getTimeslotCount() > 0; module++) {
+    assignment[module] = module % index.getTimeslotCount();
+  }
+  index.writeAssignment(assignment);
+}
+
+TEST(scheduleDeltaTests, createContainsScheduledModules) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  scheduleRoundRobin(plan.get());
+  QJsonObject assignments = ScheduleDelta::create(plan.get())["assignments"].toObject();
+
+  PlanIndex index(plan.get());
+  ASSERT_GT(index.getModuleCount(), 0);
+  for(int module = 0; module < index.getModuleCount(); module++) {
+    if(index.isMovable(module)) {
+      QJsonArray timeslot = assignments[index.getModule(module)->getNumber()].toArray();
+      ASSERT_EQ(timeslot.size(), 3);
+    }
+  }
+}
+
+TEST(scheduleDeltaTests, applyRestoresSchedule) {
+  QSharedPointer<Plan> scheduledPlan = getValidPlan();
+  scheduleRoundRobin(scheduledPlan.get());
+  QJsonObject delta = ScheduleDelta::create(scheduledPlan.get());
+
+  QSharedPointer<Plan> submittedPlan = getValidPlan();
+  ASSERT_TRUE(ScheduleDelta::apply(delta, submittedPlan.get()));
+  ASSERT_EQ(ScheduleDelta::create(submittedPlan.get()), delta);
+  ASSERT_EQ(PlanIndex(submittedPlan.get()).readAssignment(), PlanIndex(scheduledPlan.get()).readAssignment());
+}
+
+TEST(scheduleDeltaTests, deltaIsSmallerThanPlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  scheduleRoundRobin(plan.get());
+  QByteArray delta = QJsonDocument(ScheduleDelta::create(plan.get())).toJson(QJsonDocument::Compact);
+  QByteArray fullPlan = QJsonDocument(plan->toJsonObject()).toJson(QJsonDocument::Compact);
+  ASSERT_LT(delta.size() * 4, fullPlan.size());
+}
+
+TEST(scheduleDeltaTests, applyRejectsUnknownModule) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QJsonObject delta{{"assignments", QJsonObject{{"no such module", QJsonArray{0, 0, 0}}}}};
+  ASSERT_FALSE(ScheduleDelta::apply(delta, plan.get()));
+}
+
+TEST(scheduleDeltaTests, applyRejectsTimeslotOutsidePlan) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  QString number = plan->getModules().first()->getNumber();
+  ASSERT_FALSE(ScheduleDelta::apply(QJsonObject{{"assignments", QJsonObject{{number, QJsonArray{1000, 0, 0}}}}}, plan.get()));
+  ASSERT_FALSE(ScheduleDelta::apply(QJsonObject{{"assignments", QJsonObject{{number, QJsonArray{0, 0}}}}}, plan.get()));
+}
+
+TEST(scheduleDeltaTests, applyRejectsMissingAssignments) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  ASSERT_FALSE(ScheduleDelta::apply(QJsonObject(), plan.get()));
+}
+
+#endif
@@ -4,13 +4,16 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include <QDir>
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
 #include <QSharedPointer>
 #include <QSignalSpy>
 #include <QString>
+#include <QTemporaryDir>
 
 #include "configuration.h"
 #include "plan.h"
@@ -25,6 +28,18 @@ QSharedPointer<Configuration> getDefaultConfiguration() {
   return configuration;
 }
 
+// The plan is hashed in the pool, so the job starts after startScheduling returned
+void waitUntilJobStarted(SchedulerService& schedulerService) {
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getJobMetrics().isEmpty() && schedulerService.getResult().isUndefined()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+  }
+}
+
+QByteArray getDefaultJobKey(const QJsonObject& plan, const QString& algorithm) {
+  return JobCoalescer::createKey(plan, algorithm, SchedulerFactory::describeSettings(algorithm, *getDefaultConfiguration()));
+}
+
 TEST(schedulerServiceTests, getResultAfterSchedulingReturnsPlan) {
   QJsonObject jsonPlan = getValidJsonPlan();
   SchedulerService schedulerService(getDefaultConfiguration());
@@ -39,6 +54,21 @@ TEST(schedulerServiceTests, getResultAfterSchedulingReturnsPlan) {
   ASSERT_TRUE(schedulerService.getResult().isObject());
 }
 
+TEST(schedulerServiceTests, finishedSchedulingPassesTheResult) {
+  SchedulerService schedulerService(getDefaultConfiguration());
+  QSignalSpy finishedSpy(&schedulerService, &SchedulerService::finishedScheduling);
+  schedulerService.startScheduling(getValidJsonPlan());
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  // The plan was serialized in the pool, before the signal was emitted
+  ASSERT_EQ(finishedSpy.count(), 1);
+  ASSERT_EQ(finishedSpy[0][0].toJsonObject(), schedulerService.getResult().toObject());
+}
+
 TEST(schedulerServiceTests, getResultWithoutSchedulingReturnsUndefined) {
   SchedulerService schedulerService(getDefaultConfiguration());
   ASSERT_TRUE(schedulerService.getResult().isUndefined());
@@ -58,11 +88,64 @@ TEST(schedulerServiceTests, getResultWithUnschedulablePlanReturnsErrormessage) {
   ASSERT_TRUE(schedulerService.getResult().isString());
 }
 
+TEST(schedulerServiceTests, getResultAssignmentsAfterSchedulingReturnsAssignments) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService schedulerService(getDefaultConfiguration());
+  schedulerService.startScheduling(jsonPlan);
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_EQ(schedulerService.getProgress(), 1.0);
+  QJsonValue assignments = schedulerService.getResultAssignments();
+  ASSERT_TRUE(assignments.isObject());
+  ASSERT_TRUE(assignments.toObject()["assignments"].isObject());
+}
+
+TEST(schedulerServiceTests, getResultAssignmentsDoesNotSerializeThePlan) {
+  Tracer::global().setEnabled(true);
+  SchedulerService schedulerService(getDefaultConfiguration());
+  schedulerService.startScheduling(getValidJsonPlan());
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  auto countSerializations = [&schedulerService]() {
+    int serializations = 0;
+    for(const QJsonValue& event : schedulerService.getTrace()["traceEvents"].toArray()) {
+      if(event.toObject()["name"].toString() == "serialize") {
+        serializations++;
+      }
+    }
+    return serializations;
+  };
+
+  ASSERT_TRUE(schedulerService.getResultAssignments().isObject());
+  EXPECT_EQ(countSerializations(), 0);
+  ASSERT_TRUE(schedulerService.getResult().isObject());
+  ASSERT_TRUE(schedulerService.getResult().isObject());
+  EXPECT_EQ(countSerializations(), 1);
+  Tracer::global().setEnabled(false);
+}
+
+TEST(schedulerServiceTests, getResultAssignmentsWithoutSchedulingReturnsUndefined) {
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.getResultAssignments().isUndefined());
+}
+
 TEST(schedulerServiceTests, progessAfterConstructionIsZero) {
   SchedulerService schedulerService(getDefaultConfiguration());
   ASSERT_EQ(schedulerService.getProgress(), 0.0);
 }
 
+TEST(schedulerServiceTests, optimalityGapAfterConstructionIsEmpty) {
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.getOptimalityGap().isEmpty());
+}
+
 TEST(schedulerServiceTests, progessAfterSchedulingIsOne) {
   QJsonObject jsonPlan = getValidJsonPlan();
   SchedulerService schedulerService(getDefaultConfiguration());
@@ -89,6 +172,20 @@ TEST(schedulerServiceTests, progessAfterFailedSchedulingIsOne) {
   ASSERT_EQ(schedulerService.getProgress(), 1.0);
 }
 
+TEST(schedulerServiceTests, progressIsOnlyOneWithResult) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService schedulerService(getDefaultConfiguration());
+  schedulerService.startScheduling(jsonPlan);
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+
+  ASSERT_EQ(schedulerService.getProgress(), 1.0);
+  ASSERT_TRUE(schedulerService.getResult().isObject());
+}
+
 TEST(schedulerServiceTests, secondSchedulingAttemptFails) {
   QJsonObject jsonPlan = getInvalidJsonPlan();
   SchedulerService schedulerService(getDefaultConfiguration());
@@ -101,6 +198,7 @@ TEST(schedulerServiceTests, setSchedulingAlgorithmOnlyAcceptsValidValues) {
   SchedulerService schedulerService(getDefaultConfiguration());
   ASSERT_TRUE(schedulerService.setSchedulingAlgorithm("legacy-fast"));
   ASSERT_TRUE(schedulerService.setSchedulingAlgorithm("legacy-good"));
+  ASSERT_TRUE(schedulerService.setSchedulingAlgorithm("auto"));
   ASSERT_FALSE(schedulerService.setSchedulingAlgorithm("legacy-faste"));
   ASSERT_FALSE(schedulerService.setSchedulingAlgorithm(" legacy-good"));
 }
@@ -119,4 +217,202 @@ TEST(schedulerServiceTests, stopSchedulingReturnsTrueAfterFirstStart) {
   ASSERT_TRUE(schedulerService.stopScheduling());
 }
 
+TEST(schedulerServiceTests, getBatchResultAfterBatchReturnsArray) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.startBatch(jsonPlan, QJsonArray{QJsonObject(), QJsonObject()}));
+
+  QTime limit = QTime::currentTime().addMSecs(1000);
+  while(QTime::currentTime() < limit && schedulerService.getBatchProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_EQ(schedulerService.getBatchProgress(), 1.0);
+  ASSERT_TRUE(schedulerService.getBatchResult().isArray());
+  ASSERT_EQ(schedulerService.getBatchResult().toArray().size(), 2);
+}
+
+TEST(schedulerServiceTests, secondBatchAttemptFails) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.startBatch(jsonPlan, QJsonArray{QJsonObject()}));
+  ASSERT_FALSE(schedulerService.startBatch(jsonPlan, QJsonArray{QJsonObject()}));
+}
+
+TEST(schedulerServiceTests, secondSemesterAttemptFails) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.startSemester(QJsonArray{jsonPlan}));
+  ASSERT_FALSE(schedulerService.startSemester(QJsonArray{jsonPlan}));
+}
+
+TEST(schedulerServiceTests, startSchedulingRejectsPlanLargerThanMaxPlanSize) {
+  QList<QString> arguments{
+      "pruefungsplaner-scheduler-tests", "--storage", "/tmp", "--legacy-scheduler-binary", "./SPA-algorithmus", "--max-plan-size", "100"};
+  SchedulerService schedulerService(QSharedPointer<Configuration>(new Configuration(arguments)));
+  QSignalSpy warningSpy(&schedulerService, &SchedulerService::emitWarning);
+  ASSERT_FALSE(schedulerService.startScheduling(getValidJsonPlan()));
+  ASSERT_EQ(warningSpy.count(), 1);
+}
+
+TEST(schedulerServiceTests, getJobMetricsIsEmptyBeforeStart) {
+  SchedulerService schedulerService(getDefaultConfiguration());
+  ASSERT_TRUE(schedulerService.getJobMetrics().isEmpty());
+}
+
+TEST(schedulerServiceTests, getJobMetricsContainsAlgorithmAndPlacement) {
+  SchedulerService schedulerService(getDefaultConfiguration());
+  schedulerService.setSchedulingAlgorithm("legacy-fast");
+  ASSERT_TRUE(schedulerService.startScheduling(getValidJsonPlan()));
+  waitUntilJobStarted(schedulerService);
+  QJsonObject metrics = schedulerService.getJobMetrics();
+  ASSERT_EQ(metrics["algorithm"].toString(), "legacy-fast");
+  ASSERT_EQ(metrics["mode"].toString(), "fast");
+  ASSERT_TRUE(metrics.contains("placement"));
+}
+
+TEST(schedulerServiceTests, startSchedulingIsRejectedAboveMaxRunningJobs) {
+  AdmissionControl::global().configure(1, 0, 0.0, 0);
+  SchedulerService firstService(getDefaultConfiguration());
+  SchedulerService secondService(getDefaultConfiguration());
+  ASSERT_TRUE(firstService.startScheduling(getValidJsonPlan()));
+  ASSERT_EQ(firstService.getRetryAfter(), 0);
+
+  // A different plan, so the second request is not coalesced with the first one
+  QSignalSpy warningSpy(&secondService, &SchedulerService::emitWarning);
+  bool started = secondService.startScheduling(getInvalidJsonPlan());
+  int retryAfter = secondService.getRetryAfter();
+  AdmissionControl::global().configure(0, 0, 0.0, 0);
+
+  ASSERT_FALSE(started);
+  ASSERT_GT(retryAfter, 0);
+  ASSERT_EQ(warningSpy.count(), 1);
+}
+
+TEST(schedulerServiceTests, finishedJobFreesItsSlot) {
+  {
+    SchedulerService schedulerService(getDefaultConfiguration());
+    schedulerService.startScheduling(getValidJsonPlan());
+    QTime limit = QTime::currentTime().addMSecs(500);
+    while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+    ASSERT_EQ(AdmissionControl::global().getRunningJobs(), 0);
+  }
+  {
+    SchedulerService schedulerService(getDefaultConfiguration());
+    schedulerService.startScheduling(getValidJsonPlan());
+  }
+  ASSERT_EQ(AdmissionControl::global().getRunningJobs(), 0);
+}
+
+TEST(schedulerServiceTests, identicalRequestsShareOneJob) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  QByteArray key = getDefaultJobKey(jsonPlan, "legacy-fast");
+  SchedulerService firstService(getDefaultConfiguration());
+  SchedulerService secondService(getDefaultConfiguration());
+  ASSERT_TRUE(firstService.startScheduling(jsonPlan));
+  waitUntilJobStarted(firstService);
+  ASSERT_TRUE(secondService.startScheduling(jsonPlan));
+  waitUntilJobStarted(secondService);
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(key), 2);
+  ASSERT_EQ(AdmissionControl::global().getRunningJobs(), 1);
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && (firstService.getProgress() != 1.0 || secondService.getProgress() != 1.0)) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  ASSERT_TRUE(firstService.getResult().isObject());
+  ASSERT_TRUE(secondService.getResult().isObject());
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(key), 0);
+}
+
+TEST(schedulerServiceTests, sharedJobKeepsRunningAfterOneClientStops) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService firstService(getDefaultConfiguration());
+  SchedulerService secondService(getDefaultConfiguration());
+  ASSERT_TRUE(firstService.startScheduling(jsonPlan));
+  waitUntilJobStarted(firstService);
+  ASSERT_TRUE(secondService.startScheduling(jsonPlan));
+  waitUntilJobStarted(secondService);
+  ASSERT_TRUE(firstService.stopScheduling());
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(getDefaultJobKey(jsonPlan, "legacy-fast")), 1);
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && secondService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+  ASSERT_TRUE(secondService.getResult().isObject());
+}
+
+TEST(schedulerServiceTests, requestsWithDifferentAlgorithmsDoNotShareAJob) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  SchedulerService firstService(getDefaultConfiguration());
+  SchedulerService secondService(getDefaultConfiguration());
+  ASSERT_TRUE(secondService.setSchedulingAlgorithm("legacy-good"));
+  ASSERT_TRUE(firstService.startScheduling(jsonPlan));
+  waitUntilJobStarted(firstService);
+  ASSERT_TRUE(secondService.startScheduling(jsonPlan));
+  waitUntilJobStarted(secondService);
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(getDefaultJobKey(jsonPlan, "legacy-fast")), 1);
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(getDefaultJobKey(jsonPlan, "legacy-good")), 1);
+}
+
+TEST(schedulerServiceTests, requestsWithDifferentSettingsDoNotShareAJob) {
+  QJsonObject jsonPlan = getValidJsonPlan();
+  QList<QString> arguments{"pruefungsplaner-scheduler-tests",
+                           "--storage",
+                           "/tmp",
+                           "--legacy-scheduler-binary",
+                           "./SPA-algorithmus",
+                           "--legacy-scheduler-local-search-time",
+                           "10"};
+  SchedulerService firstService(getDefaultConfiguration());
+  SchedulerService secondService(QSharedPointer<Configuration>(new Configuration(arguments)));
+  ASSERT_TRUE(firstService.startScheduling(jsonPlan));
+  waitUntilJobStarted(firstService);
+  ASSERT_TRUE(secondService.startScheduling(jsonPlan));
+  waitUntilJobStarted(secondService);
+  ASSERT_EQ(JobCoalescer::global().getSubscriberCount(getDefaultJobKey(jsonPlan, "legacy-fast")), 1);
+  ASSERT_EQ(AdmissionControl::global().getRunningJobs(), 2);
+}
+
+TEST(schedulerServiceTests, disconnectedClientFailsItsJournaledJob) {
+  QTemporaryDir storage;
+  QSharedPointer<JobJournal> journal(new JobJournal(QDir(storage.path())));
+  ASSERT_TRUE(journal->open());
+  QSharedPointer<ConfigurationProvider> configurationProvider(new ConfigurationProvider(getDefaultConfiguration()));
+  QString jobId;
+  {
+    SchedulerService schedulerService(configurationProvider, journal);
+    ASSERT_TRUE(schedulerService.startScheduling(getValidJsonPlan()));
+    waitUntilJobStarted(schedulerService);
+    jobId = schedulerService.getJobId();
+    ASSERT_FALSE(jobId.isEmpty());
+  }
+  ASSERT_EQ(journal->getJob(jobId).state, JobJournal::Failed);
+  ASSERT_TRUE(journal->getUnfinishedJobs().isEmpty());
+}
+
+TEST(schedulerServiceTests, finishedJournaledJobCanBeAttached) {
+  QTemporaryDir storage;
+  QSharedPointer<JobJournal> journal(new JobJournal(QDir(storage.path())));
+  ASSERT_TRUE(journal->open());
+  QSharedPointer<ConfigurationProvider> configurationProvider(new ConfigurationProvider(getDefaultConfiguration()));
+  SchedulerService schedulerService(configurationProvider, journal);
+  ASSERT_TRUE(schedulerService.startScheduling(getValidJsonPlan()));
+
+  QTime limit = QTime::currentTime().addMSecs(500);
+  while(QTime::currentTime() < limit && schedulerService.getProgress() != 1.0) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  // The plan and the result are written in the pool, before the job is recorded
+  QString jobId = schedulerService.getJobId();
+  ASSERT_EQ(journal->getJob(jobId).state, JobJournal::Finished);
+  SchedulerService attachedService(configurationProvider, journal);
+  ASSERT_TRUE(attachedService.attachJob(jobId));
+  ASSERT_TRUE(attachedService.getResult().isObject());
+}
+
 #endif
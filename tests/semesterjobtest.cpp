@@ -0,0 +1,99 @@
+#ifndef SEMESTERJOB_TEST_CPP
+#define SEMESTERJOB_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QString>
+
+#include "configuration.h"
+#include "plan.h"
+#include "semesterjob.h"
+#include "testdatahelper.h"
+
+using namespace testing;
+
+QSharedPointer<const Configuration> getSemesterConfiguration() {
+  QList<QString> arguments{"pruefungsplaner-scheduler-tests",
+                           "--storage",
+                           "/tmp",
+                           "--legacy-scheduler-binary",
+                           "./SPA-algorithmus",
+                           "--max-parallel-jobs",
+                           "2"};
+  return QSharedPointer<const Configuration>(new Configuration(arguments));
+}
+
+// The valid plan with only every second active module, starting at the first or the second one
+QJsonObject getSemesterHalfPlan(bool secondHalf) {
+  QSharedPointer<Plan> plan = getValidPlan();
+  bool active = secondHalf;
+  for(Module* module : plan->getModules()) {
+    if(module->getActive()) {
+      module->setActive(active);
+      active = !active;
+    }
+  }
+  return plan->toJsonObject();
+}
+
+// The valid plan without active modules, so it shares nothing with other plans
+QJsonObject getSemesterEmptyPlan() {
+  QSharedPointer<Plan> plan = getValidPlan();
+  for(Module* module : plan->getModules()) {
+    module->setActive(false);
+  }
+  return plan->toJsonObject();
+}
+
+TEST(semesterJobTests, startFailsWithoutPlans) {
+  SemesterJob semester(QJsonArray(), "legacy-fast", getSemesterConfiguration());
+  ASSERT_FALSE(semester.start());
+}
+
+TEST(semesterJobTests, startFailsWithUnknownAlgorithm) {
+  SemesterJob semester(QJsonArray{getValidJsonPlan()}, "unknown", getSemesterConfiguration());
+  ASSERT_FALSE(semester.start());
+}
+
+TEST(semesterJobTests, startFailsWithPlanThatIsNotAnObject) {
+  SemesterJob semester(QJsonArray{getValidJsonPlan(), 42}, "legacy-fast", getSemesterConfiguration());
+  ASSERT_FALSE(semester.start());
+}
+
+TEST(semesterJobTests, plansWithSharedModulesAreCoupled) {
+  QJsonArray plans{getValidJsonPlan(), getSemesterEmptyPlan(), getValidJsonPlan()};
+  SemesterJob semester(plans, "legacy-fast", getSemesterConfiguration());
+  ASSERT_TRUE(semester.start());
+
+  QList<QList<int>> components = semester.getComponents();
+  ASSERT_EQ(components.size(), 2);
+  EXPECT_EQ(components[0], (QList<int>{0, 2}));
+  EXPECT_EQ(components[1], (QList<int>{1}));
+  semester.stop();
+}
+
+TEST(semesterJobTests, coupledPlansHaveNoConflicts) {
+  SemesterJob semester(QJsonArray{getSemesterHalfPlan(false), getSemesterHalfPlan(true)}, "legacy-fast", getSemesterConfiguration());
+  ASSERT_TRUE(semester.start());
+
+  QTime limit = QTime::currentTime().addMSecs(3000);
+  while(QTime::currentTime() < limit && !semester.isFinished()) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+  }
+
+  ASSERT_TRUE(semester.isFinished());
+  ASSERT_EQ(semester.getProgress(), 1.0);
+  QJsonObject result = semester.getResult();
+  ASSERT_EQ(result["plans"].toArray().size(), 2);
+  EXPECT_TRUE(result["plans"].toArray()[0].toObject().contains("plan"));
+  EXPECT_TRUE(result["plans"].toArray()[1].toObject().contains("plan"));
+  EXPECT_FALSE(result["sharedGroups"].toArray().isEmpty());
+  EXPECT_TRUE(result["sharedModules"].toArray().isEmpty());
+  EXPECT_EQ(result["conflicts"].toInt(), 0);
+}
+
+#endif
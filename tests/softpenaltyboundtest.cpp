@@ -0,0 +1,47 @@
+#ifndef SOFTPENALTYBOUND_TEST_CPP
+#define SOFTPENALTYBOUND_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QSharedPointer>
+
+#include "branchandbound.h"
+#include "plan.h"
+#include "planhelper.h"
+#include "planindex.h"
+#include "softpenaltybound.h"
+
+using namespace testing;
+
+TEST(softPenaltyBoundTests, boundIsNotAboveOptimalPenalty) {
+  for(int count : {4, 8, 12}) {
+    QSharedPointer<Plan> plan = getSmallValidPlan(count);
+    PlanIndex index(plan.get());
+    BranchAndBound::Result result = BranchAndBound(index, index.readAssignment()).run(10000, 2);
+    ASSERT_TRUE(result.optimal);
+    int bound = SoftPenaltyBound::compute(index);
+    ASSERT_GE(bound, 0);
+    ASSERT_LE(bound, result.penalty);
+  }
+}
+
+TEST(softPenaltyBoundTests, gapOfOptimalScheduleIsZero) {
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(30, 30), 0.0);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(20, 30), 0.0);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(0, 0), 0.0);
+}
+
+TEST(softPenaltyBoundTests, gapIsRelativeToPenalty) {
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(40, 30), 0.25);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(40, 0), 1.0);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::gap(40, -1), 1.0);
+}
+
+TEST(softPenaltyBoundTests, closedGapStartsAtZero) {
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::closedGap(50, 50, 10), 0.0);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::closedGap(50, 30, 10), 0.5);
+  ASSERT_DOUBLE_EQ(SoftPenaltyBound::closedGap(50, 10, 10), 1.0);
+}
+
+#endif
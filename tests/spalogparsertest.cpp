@@ -0,0 +1,49 @@
+#ifndef SPALOGPARSER_TEST_CPP
+#define SPALOGPARSER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QString>
+
+#include "spalogparser.h"
+
+using namespace testing;
+
+TEST(spaLogParserTests, parseDetectsWarnings) {
+  ASSERT_EQ(SpaLogParser::parse("FEHLER: something\n").type, SpaLogParser::Warning);
+  ASSERT_EQ(SpaLogParser::parse("WARNUNG: something\n").type, SpaLogParser::Warning);
+  ASSERT_EQ(SpaLogParser::parse("Modul 123 kann nicht zugeteilt werden\n").type, SpaLogParser::Warning);
+}
+
+TEST(spaLogParserTests, parseIgnoresWarningSummary) {
+  ASSERT_EQ(SpaLogParser::parse("0 WARNUNGEN\n").type, SpaLogParser::Other);
+}
+
+TEST(spaLogParserTests, parseDetectsStuckAlgorithm) {
+  ASSERT_EQ(SpaLogParser::parse("Algorithmus hängt (12)\n").type, SpaLogParser::Stuck);
+  ASSERT_EQ(SpaLogParser::parse("Algorithmus hängt (1)\n").type, SpaLogParser::Other);
+}
+
+TEST(spaLogParserTests, parseExtractsResultDirectory) {
+  SpaLogParser::Line line = SpaLogParser::parse("Details in: /tmp/result-2021/SPA-planung-pruef.csv\n");
+  ASSERT_EQ(line.type, SpaLogParser::ResultDirectory);
+  ASSERT_EQ(line.resultDirectory, "/tmp/result-2021");
+}
+
+TEST(spaLogParserTests, parseExtractsSoftBest) {
+  SpaLogParser::Line line = SpaLogParser::parse("Iteration 7 ESoftBest: 42\n");
+  ASSERT_EQ(line.type, SpaLogParser::SoftBest);
+  ASSERT_EQ(line.softBest, 42);
+}
+
+TEST(spaLogParserTests, parseIgnoresOverflowingSoftBest) {
+  ASSERT_EQ(SpaLogParser::parse("ESoftBest: 99999999999999999999\n").type, SpaLogParser::Other);
+}
+
+TEST(spaLogParserTests, parseAcceptsArbitraryLines) {
+  ASSERT_EQ(SpaLogParser::parse("").type, SpaLogParser::Other);
+  ASSERT_EQ(SpaLogParser::parse(QString(10000, QChar(0xfffd))).type, SpaLogParser::Other);
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef TOKENVERIFIER_TEST_CPP
+#define TOKENVERIFIER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include "tokenverifier.h"
+
+using namespace testing;
+
+struct KeyPair {
+  QString publicKey;
+  QString privateKey;
+};
+
+// Generating a key takes a while, so every test uses the same keys
+KeyPair generateKeyPair() {
+  QTemporaryDir directory;
+  QString privateKeyFile = directory.filePath("private_key.pem");
+  QString publicKeyFile = directory.filePath("public_key.pem");
+  QProcess::execute("openssl", {"genpkey", "-algorithm", "RSA", "-pkeyopt", "rsa_keygen_bits:2048", "-out", privateKeyFile});
+  QProcess::execute("openssl", {"pkey", "-in", privateKeyFile, "-pubout", "-out", publicKeyFile});
+  KeyPair keys;
+  QFile privateKey(privateKeyFile);
+  if(privateKey.open(QFile::ReadOnly)) {
+    keys.privateKey = privateKey.readAll();
+  }
+  QFile publicKey(publicKeyFile);
+  if(publicKey.open(QFile::ReadOnly)) {
+    keys.publicKey = publicKey.readAll();
+  }
+  return keys;
+}
+
+const KeyPair& getKeyPair() {
+  static KeyPair keys = generateKeyPair();
+  return keys;
+}
+
+const KeyPair& getOtherKeyPair() {
+  static KeyPair keys = generateKeyPair();
+  return keys;
+}
+
+QString createToken(const KeyPair& keys,
+                    const QString& issuer = "pruefungsplaner-auth",
+                    const QList<QString>& claims = {"pruefungsplanerStartSchedule"},
+                    int lifetime = 60) {
+  auto token = jwt::create().set_issuer(issuer.toStdString());
+  // A lifetime of 0 creates a token without exp
+  if(lifetime != 0) {
+    token.set_expires_at(std::chrono::system_clock::now() + std::chrono::seconds(lifetime));
+  }
+  for(const QString& claim : claims) {
+    token.set_payload_claim(claim.toStdString(), jwt::claim(picojson::value(true)));
+  }
+  return QString::fromStdString(token.sign(jwt::algorithm::rs256(keys.publicKey.toStdString(), keys.privateKey.toStdString(), "", "")));
+}
+
+void configureVerifier(TokenVerifier& verifier, const KeyPair& keys, int cacheSize = TokenVerifier::defaultCacheSize) {
+  verifier.configure(keys.publicKey, "pruefungsplaner-auth", {"pruefungsplanerStartSchedule"}, cacheSize);
+}
+
+TEST(tokenVerifierTests, unconfiguredVerifierRejectsTokens) {
+  TokenVerifier verifier;
+  ASSERT_FALSE(verifier.verify(createToken(getKeyPair())));
+}
+
+TEST(tokenVerifierTests, validTokenIsAccepted) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_TRUE(verifier.verify(createToken(getKeyPair())));
+}
+
+TEST(tokenVerifierTests, tokenWithWrongSignatureIsRejected) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_FALSE(verifier.verify(createToken(getOtherKeyPair())));
+  ASSERT_FALSE(verifier.verify("not a token"));
+}
+
+TEST(tokenVerifierTests, tokenWithWrongIssuerIsRejected) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_FALSE(verifier.verify(createToken(getKeyPair(), "somebody")));
+}
+
+TEST(tokenVerifierTests, tokenWithoutRequiredClaimIsRejected) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_FALSE(verifier.verify(createToken(getKeyPair(), "pruefungsplaner-auth", {"pruefungsplanerRetrieveSchedule"})));
+}
+
+TEST(tokenVerifierTests, expiredTokenIsRejected) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_FALSE(verifier.verify(createToken(getKeyPair(), "pruefungsplaner-auth", {"pruefungsplanerStartSchedule"}, -60)));
+}
+
+TEST(tokenVerifierTests, secondVerificationIsAnsweredFromCache) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  QString token = createToken(getKeyPair());
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCacheMisses(), 1);
+  ASSERT_EQ(verifier.getCacheHits(), 1);
+}
+
+TEST(tokenVerifierTests, invalidTokensAreNotCached) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  QString token = createToken(getOtherKeyPair());
+  ASSERT_FALSE(verifier.verify(token));
+  ASSERT_FALSE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCachedTokens(), 0);
+  ASSERT_EQ(verifier.getCacheHits(), 0);
+}
+
+TEST(tokenVerifierTests, cachedTokenExpires) {
+  qint64 now = QDateTime::currentSecsSinceEpoch();
+  TokenVerifier verifier([&now]() {
+    return now;
+  });
+  configureVerifier(verifier, getKeyPair());
+  QString token = createToken(getKeyPair());
+  ASSERT_TRUE(verifier.verify(token));
+  now += 120;
+  ASSERT_FALSE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCachedTokens(), 0);
+}
+
+TEST(tokenVerifierTests, tokenWithoutExpirationIsCheckedAgainAfterMaxCacheAge) {
+  qint64 now = QDateTime::currentSecsSinceEpoch();
+  TokenVerifier verifier([&now]() {
+    return now;
+  });
+  configureVerifier(verifier, getKeyPair());
+  QString token = createToken(getKeyPair(), "pruefungsplaner-auth", {"pruefungsplanerStartSchedule"}, 0);
+  ASSERT_TRUE(verifier.verify(token));
+  now += TokenVerifier::maxCacheAge - 1;
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCacheHits(), 1);
+  now += 1;
+  // The signature is still valid, so the token is checked and remembered again
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCacheMisses(), 2);
+  ASSERT_EQ(verifier.getCachedTokens(), 1);
+}
+
+TEST(tokenVerifierTests, changingTheKeyDropsTheCache) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  QString token = createToken(getKeyPair());
+  ASSERT_TRUE(verifier.verify(token));
+  configureVerifier(verifier, getOtherKeyPair());
+  ASSERT_EQ(verifier.getCachedTokens(), 0);
+  ASSERT_FALSE(verifier.verify(token));
+}
+
+TEST(tokenVerifierTests, reconfiguringWithTheSameKeyKeepsTheCache) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_TRUE(verifier.verify(createToken(getKeyPair())));
+  configureVerifier(verifier, getKeyPair());
+  ASSERT_EQ(verifier.getCachedTokens(), 1);
+}
+
+TEST(tokenVerifierTests, cacheIsBounded) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair(), 2);
+  for(int lifetime = 60; lifetime < 63; lifetime++) {
+    ASSERT_TRUE(verifier.verify(createToken(getKeyPair(), "pruefungsplaner-auth", {"pruefungsplanerStartSchedule"}, lifetime)));
+  }
+  ASSERT_EQ(verifier.getCachedTokens(), 2);
+}
+
+TEST(tokenVerifierTests, cacheSizeZeroDisablesTheCache) {
+  TokenVerifier verifier;
+  configureVerifier(verifier, getKeyPair(), 0);
+  QString token = createToken(getKeyPair());
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_TRUE(verifier.verify(token));
+  ASSERT_EQ(verifier.getCacheHits(), 0);
+  ASSERT_EQ(verifier.getCacheMisses(), 2);
+}
+
+#endif
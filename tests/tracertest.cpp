@@ -0,0 +1,117 @@
+#ifndef TRACER_TEST_CPP
+#define TRACER_TEST_CPP
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+#include "tracer.h"
+
+using namespace testing;
+
+// Returns the trace events without the thread name metadata
+QJsonArray getRecordedEvents(const Tracer& tracer) {
+  QJsonArray events;
+  for(const QJsonValue& event : tracer.toChromeTrace()["traceEvents"].toArray()) {
+    if(event.toObject()["ph"].toString() != "M") {
+      events.append(event);
+    }
+  }
+  return events;
+}
+
+TEST(tracerTests, disabledTracerRecordsNothing) {
+  Tracer tracer;
+  tracer.instant("event", "job");
+  tracer.complete("span", "job", tracer.now());
+  { Tracer::Span span("scoped", "job", tracer); }
+  ASSERT_EQ(getRecordedEvents(tracer).size(), 0);
+}
+
+TEST(tracerTests, spanRecordsCompleteEvent) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  { Tracer::Span span("parse", "job", tracer); }
+
+  QJsonArray events = getRecordedEvents(tracer);
+  ASSERT_EQ(events.size(), 1);
+  QJsonObject event = events[0].toObject();
+  ASSERT_EQ(event["name"].toString(), "parse");
+  ASSERT_EQ(event["ph"].toString(), "X");
+  ASSERT_GE(event["dur"].toDouble(), 0.0);
+}
+
+TEST(tracerTests, instantEventContainsDetail) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  tracer.instant("softBest", "job", "42");
+
+  QJsonObject event = getRecordedEvents(tracer)[0].toObject();
+  ASSERT_EQ(event["ph"].toString(), "i");
+  ASSERT_EQ(event["args"].toObject()["detail"].toString(), "42");
+}
+
+TEST(tracerTests, fullBufferOverwritesOldestEvents) {
+  Tracer tracer;
+  tracer.setEnabled(true, 3);
+  for(int i = 0; i < 5; i++) {
+    tracer.instant("event", "job", QString::number(i));
+  }
+
+  QJsonArray events = getRecordedEvents(tracer);
+  ASSERT_EQ(events.size(), 3);
+  ASSERT_EQ(events[0].toObject()["args"].toObject()["detail"].toString(), "2");
+  ASSERT_EQ(events[2].toObject()["args"].toObject()["detail"].toString(), "4");
+}
+
+TEST(tracerTests, everyJobGetsItsOwnThread) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  tracer.instant("event", "first");
+  tracer.instant("event", "second");
+  tracer.instant("event", "first");
+
+  QJsonArray events = getRecordedEvents(tracer);
+  ASSERT_EQ(events[0].toObject()["tid"], events[2].toObject()["tid"]);
+  ASSERT_NE(events[0].toObject()["tid"], events[1].toObject()["tid"]);
+  ASSERT_EQ(tracer.toChromeTrace()["traceEvents"].toArray().size(), 5);
+}
+
+TEST(tracerTests, disablingDropsEvents) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  tracer.instant("event", "job");
+  tracer.setEnabled(false);
+  tracer.setEnabled(true);
+  ASSERT_EQ(getRecordedEvents(tracer).size(), 0);
+}
+
+TEST(tracerTests, jobTraceContainsOnlyEventsOfTheJob) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  tracer.instant("event", "first", "1");
+  tracer.instant("event", "second", "2");
+  tracer.instant("event", "first", "3");
+
+  QJsonArray events;
+  for(const QJsonValue& event : tracer.toChromeTrace("first")["traceEvents"].toArray()) {
+    if(event.toObject()["ph"].toString() != "M") {
+      events.append(event);
+    }
+  }
+  ASSERT_EQ(events.size(), 2);
+  ASSERT_EQ(events[0].toObject()["args"].toObject()["detail"].toString(), "1");
+  ASSERT_EQ(events[1].toObject()["args"].toObject()["detail"].toString(), "3");
+}
+
+TEST(tracerTests, traceOfEmptyJobIsEmpty) {
+  Tracer tracer;
+  tracer.setEnabled(true);
+  tracer.instant("event", "");
+  ASSERT_TRUE(tracer.toChromeTrace("")["traceEvents"].toArray().isEmpty());
+}
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * A scripted stand-in for SPA-algorithmus.
+ *
+ * The stub accepts the arguments of SPA-algorithmus (-p <directory> -PP) and
+ * its answers on stdin ("jn" for the fast and "jjn" for the good mode). It
+ * prints the lines the LegacyScheduler reacts to and writes a result
+ * directory, but it does not schedule anything. Its timing is fixed by a
+ * script, so benchmarks and tests are reproducible.
+ *
+ * The script is read from the file in SPA_STUB_SCRIPT. Every line is one
+ * command:
+ *
+ *   sleep <milliseconds>    wait
+ *   softbest <penalty>      print "ESoftBest: <penalty>"
+ *   print <text>            print text
+ *   stuck <count>           print "hängt (<count>)" and wait until terminated
+ *   schedule [<file>]       write <file> or a generated schedule
+ *   exit <code>             exit with code
+ *
+ * The generated schedule puts every exam of pruefungen.csv in the -p
+ * directory in the first slot of the first day, so it is accepted for every
+ * plan. It is not a valid schedule, if exams conflict.
+ *
+ * Without a script, the stub prints three improvements 10 ms apart, writes a
+ * generated schedule and exits with 0.
+ *
+ * On SIGINT or SIGTERM the stub prints "- Unterbrechung entgegen genommen -"
+ * like SPA-algorithmus and stops waiting. Only the schedule and exit commands
+ * of the rest of the script are executed, so it finishes with its current
+ * result. The LegacyScheduler stops processes with SIGTERM.
+ *
+ * In good mode the schedule is written to a directory with a generated name,
+ * which is reported with "Details in:", like SPA-algorithmus does.
+ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr auto resultDirectoryName = "SPA-ERGEBNIS-PP";
+constexpr auto scheduleFileName = "SPA-planung-pruef.csv";
+constexpr auto examsFileName = "pruefungen.csv";
+// Column of the module number in pruefungen.csv
+constexpr int examNumberColumn = 2;
+
+volatile std::sig_atomic_t interrupted = 0;
+
+void interrupt(int) {
+  interrupted = 1;
+}
+
+// Sleep in small steps, so an interrupt ends the sleep
+void sleepUnlessInterrupted(int milliseconds) {
+  auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+  while(!interrupted && std::chrono::steady_clock::now() < end) {
+    std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(std::chrono::milliseconds(5),
+                                                                             end - std::chrono::steady_clock::now()));
+  }
+}
+
+const std::vector<std::string> defaultScript{"softbest 100", "sleep 10", "softbest 50", "sleep 10", "softbest 10", "sleep 10", "schedule", "exit 0"};
+
+std::vector<std::string> readScript() {
+  const char* scriptPath = std::getenv("SPA_STUB_SCRIPT");
+  if(scriptPath == nullptr) {
+    return defaultScript;
+  }
+  std::ifstream scriptFile(scriptPath);
+  if(!scriptFile) {
+    std::cerr << "FEHLER: Script " << scriptPath << " not found" << std::endl;
+    std::exit(2);
+  }
+  std::vector<std::string> script;
+  std::string line;
+  while(std::getline(scriptFile, line)) {
+    if(!line.empty() && line[0] != '#') {
+      script.push_back(line);
+    }
+  }
+  return script;
+}
+
+// Puts every exam in the first slot of the first day
+bool generateSchedule(const std::filesystem::path& workingDirectory, const std::filesystem::path& scheduleFile) {
+  std::ifstream examsFile(workingDirectory / examsFileName);
+  std::ofstream schedule(scheduleFile);
+  if(!examsFile || !schedule) {
+    return false;
+  }
+  std::string line;
+  while(std::getline(examsFile, line)) {
+    std::istringstream fields(line);
+    std::string number;
+    int column = 0;
+    while(column <= examNumberColumn && std::getline(fields, number, ';')) {
+      column++;
+    }
+    if(column <= examNumberColumn) {
+      continue;
+    }
+    if(!number.empty() && number.back() == '\r') {
+      number.pop_back();
+    }
+    if(!number.empty()) {
+      schedule << "1;1;" << number << "\n";
+    }
+  }
+  schedule.flush();
+  return bool(schedule);
+}
+
+bool writeSchedule(const std::filesystem::path& workingDirectory, bool goodMode, const std::string& sourceFile) {
+  std::filesystem::path resultDirectory = workingDirectory / resultDirectoryName;
+  if(goodMode) {
+    resultDirectory = workingDirectory / (std::string(resultDirectoryName) + "-" + std::to_string(getpid()));
+  }
+  std::error_code error;
+  std::filesystem::create_directories(resultDirectory, error);
+  if(error) {
+    return false;
+  }
+
+  std::filesystem::path scheduleFile = resultDirectory / scheduleFileName;
+  if(sourceFile.empty()) {
+    if(!generateSchedule(workingDirectory, scheduleFile)) {
+      return false;
+    }
+  } else {
+    std::filesystem::copy_file(sourceFile, scheduleFile, std::filesystem::copy_options::overwrite_existing, error);
+    if(error) {
+      return false;
+    }
+  }
+
+  if(goodMode) {
+    std::cout << "Details in: " << scheduleFile.string() << std::endl;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::filesystem::path workingDirectory = ".";
+  for(int i = 1; i < argc; i++) {
+    if(std::string(argv[i]) == "-p" && i + 1 < argc) {
+      workingDirectory = argv[++i];
+    }
+  }
+
+  std::signal(SIGINT, interrupt);
+  std::signal(SIGTERM, interrupt);
+
+  std::string answers((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+  bool goodMode = answers.rfind("jj", 0) == 0;
+
+  bool interruptReported = false;
+  for(const std::string& line : readScript()) {
+    std::istringstream command(line);
+    std::string name;
+    command >> name;
+    std::string argument;
+    std::getline(command >> std::ws, argument);
+
+    if(interrupted) {
+      if(!interruptReported) {
+        interruptReported = true;
+        std::cout << "- Unterbrechung entgegen genommen -" << std::endl;
+      }
+      if(name != "schedule" && name != "exit") {
+        continue;
+      }
+    }
+
+    if(name == "sleep") {
+      sleepUnlessInterrupted(std::atoi(argument.c_str()));
+    } else if(name == "softbest") {
+      std::cout << "ESoftBest: " << argument << std::endl;
+    } else if(name == "print") {
+      std::cout << argument << std::endl;
+    } else if(name == "stuck") {
+      std::cout << "Algorithmus hängt (" << argument << ")" << std::endl;
+      // Wait for the scheduler to terminate or interrupt the stub
+      while(!interrupted) {
+        pause();
+      }
+    } else if(name == "schedule") {
+      if(!writeSchedule(workingDirectory, goodMode, argument)) {
+        std::cerr << "FEHLER: Failed to write the schedule" << std::endl;
+        return 1;
+      }
+    } else if(name == "exit") {
+      return std::atoi(argument.c_str());
+    } else {
+      std::cerr << "FEHLER: Unknown command " << name << std::endl;
+      return 2;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,8 @@
+# Builds the SPA-algorithmus stub next to the target of the including project.
+# The stub only uses the standard library, so it is compiled directly instead of as a Qt project.
+spaAlgorithmusStub.target = SPA-algorithmus-stub
+spaAlgorithmusStub.depends = $$PWD/main.cpp
+spaAlgorithmusStub.commands = $$QMAKE_CXX -std=c++2a -O2 -o SPA-algorithmus-stub $$PWD/main.cpp
+QMAKE_EXTRA_TARGETS += spaAlgorithmusStub
+PRE_TARGETDEPS += SPA-algorithmus-stub
+QMAKE_CLEAN += SPA-algorithmus-stub